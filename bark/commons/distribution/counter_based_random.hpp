@@ -0,0 +1,55 @@
+// Copyright (c) 2019 fortiss GmbH, Julian Bernhard, Klemens Esterle, Patrick
+// Hart, Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_COMMONS_DISTRIBUTION_COUNTER_BASED_RANDOM_HPP_
+#define BARK_COMMONS_DISTRIBUTION_COUNTER_BASED_RANDOM_HPP_
+
+#include <cstdint>
+
+namespace bark {
+namespace commons {
+
+typedef std::uint64_t RandomStream;
+typedef std::uint64_t RandomCounter;
+
+//! Stateless random number generator: the n-th number of a stream is a
+//! hash of (key, n). Streams can thus be evaluated in any order and on
+//! any thread with identical results.
+class CounterBasedRandom {
+ public:
+  explicit CounterBasedRandom(std::uint64_t key) : key_(Mix(key)) {}
+
+  //! key of an independent stream derived from a seed and a stream id
+  static std::uint64_t StreamKey(std::uint64_t seed, RandomStream stream) {
+    return Mix(seed) ^ Mix(stream + 0x632be59bd9b4e019ULL);
+  }
+
+  std::uint64_t Bits(RandomCounter counter) const {
+    // two rounds of the splitmix64 finalizer
+    return Mix(Mix(key_ + counter * 0x9e3779b97f4a7c15ULL) ^ key_);
+  }
+
+  //! uniform number in the open interval (0, 1); 23 bits keep the
+  //! largest value below one in single precision
+  float Uniform(RandomCounter counter) const {
+    return (static_cast<float>(Bits(counter) >> 41) + 0.5f) *
+           (1.0f / 8388608.0f);
+  }
+
+ private:
+  static std::uint64_t Mix(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  std::uint64_t key_;
+};
+
+}  // namespace commons
+}  // namespace bark
+
+#endif  // BARK_COMMONS_DISTRIBUTION_COUNTER_BASED_RANDOM_HPP_
@@ -8,9 +8,11 @@
 #define BARK_COMMONS_DISTRIBUTION_DISTRIBUTION_HPP_
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <vector>
 
 #include "bark/commons/base_type.hpp"
+#include "bark/commons/distribution/counter_based_random.hpp"
 
 namespace bark {
 namespace commons {
@@ -27,6 +29,27 @@ class Distribution : public BaseType {
 
   virtual RandomVariate Sample() = 0;
 
+  //! writes num_samples consecutive variates into the buffer, which holds
+  //! num_samples times the dimension of the distribution values
+  virtual void SampleBatch(RandomVariableValueType* samples,
+                           std::size_t num_samples) {
+    for (std::size_t i = 0; i < num_samples; ++i) {
+      const RandomVariate variate = Sample();
+      samples = std::copy(variate.begin(), variate.end(), samples);
+    }
+  }
+
+  //! as SampleBatch, but the variates only depend on the seed, the stream
+  //! and the counter of the first variate; falling back to the stateful
+  //! SampleBatch would break reproducibility, so distributions without a
+  //! counter based implementation abort
+  virtual void SampleStream(RandomStream /*stream*/,
+                            RandomCounter /*counter*/,
+                            RandomVariableValueType* /*samples*/,
+                            std::size_t /*num_samples*/) {
+    LOG(FATAL) << "Distribution does not support random streams";
+  }
+
   virtual Probability Density(const RandomVariate& variate) const = 0;
 
   virtual Probability CDF(const RandomVariate& variate) const = 0;
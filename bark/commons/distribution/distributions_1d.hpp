@@ -27,6 +27,20 @@ class FixedValue : public Distribution {
 
   virtual RandomVariate Sample() { return fixed_value_; }
 
+  virtual void SampleBatch(RandomVariableValueType* samples,
+                           std::size_t num_samples) {
+    for (std::size_t i = 0; i < num_samples; ++i) {
+      samples = std::copy(fixed_value_.begin(), fixed_value_.end(), samples);
+    }
+  }
+
+  virtual void SampleStream(RandomStream /*stream*/,
+                            RandomCounter /*counter*/,
+                            RandomVariableValueType* samples,
+                            std::size_t num_samples) {
+    SampleBatch(samples, num_samples);
+  }
+
   virtual Probability Density(const RandomVariate& variate) const {
     return 0.0f;
   };
@@ -53,6 +67,13 @@ class BoostDistribution1D : public Distribution {
 
   virtual RandomVariate Sample();
 
+  virtual void SampleBatch(RandomVariableValueType* samples,
+                           std::size_t num_samples);
+
+  virtual void SampleStream(RandomStream stream, RandomCounter counter,
+                            RandomVariableValueType* samples,
+                            std::size_t num_samples);
+
   virtual Probability Density(const RandomVariate& variate) const {
     return boost::math::pdf(dist_, variate[0]);
   };
@@ -81,6 +102,25 @@ inline RandomVariate BoostDistribution1D<BoostDistType>::Sample() {
   return RandomVariate(1, sample);
 }
 
+template <class BoostDistType>
+inline void BoostDistribution1D<BoostDistType>::SampleBatch(
+    RandomVariableValueType* samples, std::size_t num_samples) {
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    samples[i] =
+        boost::math::quantile(dist_, uniform_generator_(generator_));
+  }
+}
+
+template <class BoostDistType>
+inline void BoostDistribution1D<BoostDistType>::SampleStream(
+    RandomStream stream, RandomCounter counter,
+    RandomVariableValueType* samples, std::size_t num_samples) {
+  const CounterBasedRandom random(CounterBasedRandom::StreamKey(seed_, stream));
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    samples[i] = boost::math::quantile(dist_, random.Uniform(counter + i));
+  }
+}
+
 using boost_normal = boost::math::normal_distribution<RandomVariableValueType>;
 using boost_uniform = boost::math::uniform_distribution<RandomVariableValueType>;
 
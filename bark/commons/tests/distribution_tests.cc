@@ -4,6 +4,7 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <cmath>
 #include <fstream>
 #include <iostream>
 
@@ -136,6 +137,69 @@ TEST(distribution_test, multivariate_distribution) {
   }
 }
 
+TEST(distribution_test, batch_sampling) {
+  auto params_ptr = std::make_shared<bark::commons::SetterParams>(true);
+  params_ptr->SetReal("Mean", 2.0f);
+  params_ptr->SetReal("StdDev", 0.5f);
+  params_ptr->SetInt("RandomSeed", 1000.0f);
+
+  // the batch continues the sequence of the generator
+  auto dist_normal = bark::commons::NormalDistribution1D(params_ptr);
+  auto dist_normal_batch = bark::commons::NormalDistribution1D(params_ptr);
+  std::vector<bark::commons::RandomVariableValueType> samples(100);
+  dist_normal_batch.SampleBatch(samples.data(), samples.size());
+  for (const auto& sample : samples) {
+    EXPECT_EQ(sample, dist_normal.Sample()[0]);
+  }
+
+  // fixed values and the default implementation fill all dimensions
+  params_ptr->SetListFloat("FixedValue", {1.0f, 2.0f});
+  auto dist_fixed = bark::commons::FixedValue(params_ptr);
+  dist_fixed.SampleBatch(samples.data(), 3);
+  EXPECT_EQ(samples[4], 1.0f);
+  EXPECT_EQ(samples[5], 2.0f);
+}
+
+TEST(distribution_test, stream_sampling) {
+  auto params_ptr = std::make_shared<bark::commons::SetterParams>(true);
+  params_ptr->SetReal("LowerBound", -3.0f);
+  params_ptr->SetReal("UpperBound", 10.0f);
+  params_ptr->SetInt("RandomSeed", 1000.0f);
+  auto dist_uniform = bark::commons::UniformDistribution1D(params_ptr);
+
+  const std::size_t num_samples = 20000;
+  std::vector<bark::commons::RandomVariableValueType> samples(num_samples);
+  dist_uniform.SampleStream(7, 0, samples.data(), num_samples);
+  double mean = 0.0;
+  for (const auto& sample : samples) {
+    EXPECT_GT(sample, -3.0f);
+    EXPECT_LT(sample, 10.0f);
+    mean += sample;
+  }
+  EXPECT_NEAR(mean / num_samples, 3.5, 0.1);
+
+  // each variate only depends on its stream and counter
+  std::vector<bark::commons::RandomVariableValueType> chunk(10);
+  dist_uniform.SampleStream(7, 1000, chunk.data(), chunk.size());
+  for (std::size_t i = 0; i < chunk.size(); ++i) {
+    EXPECT_EQ(chunk[i], samples[1000 + i]);
+  }
+  auto other_dist_uniform = bark::commons::UniformDistribution1D(params_ptr);
+  other_dist_uniform.SampleStream(7, 1000, chunk.data(), chunk.size());
+  EXPECT_EQ(chunk[0], samples[1000]);
+  other_dist_uniform.SampleStream(8, 1000, chunk.data(), chunk.size());
+  EXPECT_NE(chunk[0], samples[1000]);
+
+  // the normal quantile stays finite for all counters
+  params_ptr->SetReal("Mean", 0.0f);
+  params_ptr->SetReal("StdDev", 1.0f);
+  auto dist_normal = bark::commons::NormalDistribution1D(params_ptr);
+  dist_normal.SampleStream(3, 0, samples.data(), num_samples);
+  for (const auto& sample : samples) {
+    EXPECT_TRUE(std::isfinite(sample));
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -6,13 +6,24 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #include "gtest/gtest.h"
 
+#include "bark/commons/util/lru_cache.hpp"
+#include "bark/commons/util/pool_allocator.hpp"
+#include "bark/commons/util/thread_pool.hpp"
 #include "bark/commons/util/util.hpp"
 
 // TODO(@all): fill our this test
@@ -21,7 +32,148 @@ TEST(load_test, param_tests) {
   BARK_EXPECT_TRUE(temp);
 }
 
+TEST(lru_cache, util_tests) {
+  bark::commons::LruCache<int, double> cache(2);
+  double value;
+  EXPECT_FALSE(cache.Get(1, &value));
+  cache.Put(1, 1.0);
+  cache.Put(2, 2.0);
+  EXPECT_TRUE(cache.Get(1, &value));
+  EXPECT_EQ(value, 1.0);
+  // 2 is the least recently used entry now
+  cache.Put(3, 3.0);
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_TRUE(cache.Contains(1));
+  EXPECT_TRUE(cache.Contains(3));
+  EXPECT_EQ(cache.GetSize(), 2);
+  EXPECT_EQ(cache.GetHits(), 1);
+  EXPECT_EQ(cache.GetMisses(), 1);
+
+  cache.SetCapacity(1);
+  EXPECT_EQ(cache.GetSize(), 1);
+  EXPECT_TRUE(cache.Contains(3));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
+
+TEST(pool_allocator, util_tests) {
+  using bark::commons::MakePooled;
+  using bark::commons::PoolStatistics;
+  using bark::commons::ThreadLocalPool;
+  ThreadLocalPool::Release();
+  ThreadLocalPool::ResetStatistics();
+
+  std::vector<std::shared_ptr<std::array<double, 8>>> objects;
+  for (int i = 0; i < 10; ++i) {
+    objects.push_back(MakePooled<std::array<double, 8>>());
+  }
+  PoolStatistics statistics = ThreadLocalPool::GetStatistics();
+  EXPECT_EQ(statistics.num_allocations, 10u);
+  EXPECT_EQ(statistics.num_reused, 0u);
+
+  // released objects are recycled by the next allocations
+  objects.clear();
+  EXPECT_EQ(ThreadLocalPool::GetStatistics().num_recycled, 10u);
+  for (int i = 0; i < 10; ++i) {
+    objects.push_back(MakePooled<std::array<double, 8>>());
+    (*objects.back())[7] = i;
+  }
+  statistics = ThreadLocalPool::GetStatistics();
+  EXPECT_EQ(statistics.num_allocations, 20u);
+  EXPECT_EQ(statistics.num_reused, 10u);
+  EXPECT_EQ((*objects.back())[7], 9.);
+
+  // a pool can be returned to the heap
+  objects.clear();
+  ThreadLocalPool::Release();
+  objects.push_back(MakePooled<std::array<double, 8>>());
+  EXPECT_EQ(ThreadLocalPool::GetStatistics().num_reused, 10u);
+}
+
+TEST(pool_allocator_cap, util_tests) {
+  using bark::commons::MakePooled;
+  using bark::commons::ThreadLocalPool;
+  typedef std::array<char, 900> LargeBlock;
+  ThreadLocalPool::Release();
+  ThreadLocalPool::ResetStatistics();
+
+  // blocks allocated on another thread and released here are trimmed
+  // once the free list of their size class is full
+  std::vector<std::shared_ptr<LargeBlock>> objects(1000);
+  std::thread worker([&objects]() {
+    for (auto& object : objects) object = MakePooled<LargeBlock>();
+  });
+  worker.join();
+  objects.clear();
+  const auto statistics = ThreadLocalPool::GetStatistics();
+  EXPECT_EQ(statistics.num_recycled + statistics.num_trimmed, 1000u);
+  EXPECT_GT(statistics.num_trimmed, 0u);
+  EXPECT_LE(statistics.num_recycled * sizeof(LargeBlock),
+            ThreadLocalPool::kMaxFreeBytesPerSizeClass);
+}
+
+TEST(pool_allocator_release_all, util_tests) {
+  using bark::commons::MakePooled;
+  using bark::commons::ThreadLocalPool;
+  std::atomic<int> step(0);
+  std::size_t num_reused = 0;
+  std::thread worker([&step, &num_reused]() {
+    ThreadLocalPool::ResetStatistics();
+    MakePooled<std::array<double, 8>>();
+    step = 1;
+    while (step != 2) std::this_thread::yield();
+    // the free list was released by the other thread
+    MakePooled<std::array<double, 8>>();
+    num_reused = ThreadLocalPool::GetStatistics().num_reused;
+  });
+  while (step != 1) std::this_thread::yield();
+  ThreadLocalPool::ReleaseAll();
+  step = 2;
+  worker.join();
+  EXPECT_EQ(num_reused, 0u);
+}
+
+TEST(pool_allocator_over_aligned, util_tests) {
+  using bark::commons::MakePooled;
+  using bark::commons::ThreadLocalPool;
+  struct alignas(64) OverAligned {
+    double value;
+  };
+  ThreadLocalPool::ResetStatistics();
+
+  // over-aligned types bypass the pools and keep their alignment
+  std::vector<std::shared_ptr<OverAligned>> objects;
+  for (int i = 0; i < 10; ++i) {
+    objects.push_back(MakePooled<OverAligned>());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(objects.back().get()) % 64,
+              0u);
+  }
+  EXPECT_EQ(ThreadLocalPool::GetStatistics().num_allocations, 0u);
+}
+
+TEST(thread_pool, util_tests) {
+  using bark::commons::ThreadPool;
+  for (std::size_t num_threads : {0, 1, 4}) {
+    ThreadPool pool(num_threads);
+    EXPECT_EQ(pool.GetNumThreads(), num_threads);
+    std::vector<int> calls(100, 0);
+    pool.ParallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), 1), 100);
+
+    // the calling thread takes part in nested loops
+    std::atomic<int> num_inner_calls(0);
+    pool.ParallelFor(8, [&](std::size_t) {
+      pool.ParallelFor(8, [&](std::size_t) { ++num_inner_calls; });
+    });
+    EXPECT_EQ(num_inner_calls, 64);
+
+    EXPECT_THROW(pool.ParallelFor(10,
+                                  [](std::size_t i) {
+                                    if (i == 3) throw std::runtime_error("");
+                                  }),
+                 std::runtime_error);
+  }
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_COMMONS_UTIL_LRU_CACHE_HPP_
+#define BARK_COMMONS_UTIL_LRU_CACHE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace bark {
+namespace commons {
+
+//! thread-safe, size-bounded key-value cache that evicts the least
+//! recently used entry once the capacity is exceeded
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+ public:
+  explicit LruCache(std::size_t capacity)
+      : capacity_(capacity), hits_(0), misses_(0) {}
+
+  LruCache(const LruCache&) = delete;
+  LruCache& operator=(const LruCache&) = delete;
+
+  //! returns true and copies the value if the key is cached
+  bool Get(const Key& key, Value* value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++misses_;
+      return false;
+    }
+    // move the entry to the front (most recently used)
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *value = it->second->second;
+    ++hits_;
+    return true;
+  }
+
+  void Put(const Key& key, const Value& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0) return;
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      it->second->second = value;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.emplace_front(key, value);
+    index_[key] = entries_.begin();
+    EvictOverflow();
+  }
+
+  bool Contains(const Key& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.count(key) > 0;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    hits_ = 0;
+    misses_ = 0;
+  }
+
+  void SetCapacity(std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    EvictOverflow();
+  }
+
+  std::size_t GetCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+  }
+  std::size_t GetSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+  std::size_t GetHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+  std::size_t GetMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+ private:
+  using Entry = std::pair<Key, Value>;
+
+  // requires mutex_ to be held
+  void EvictOverflow() {
+    while (entries_.size() > capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+  std::list<Entry> entries_;
+  std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+  std::size_t capacity_;
+  std::size_t hits_;
+  std::size_t misses_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace commons
+}  // namespace bark
+
+#endif  // BARK_COMMONS_UTIL_LRU_CACHE_HPP_
@@ -0,0 +1,222 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_COMMONS_UTIL_POOL_ALLOCATOR_HPP_
+#define BARK_COMMONS_UTIL_POOL_ALLOCATOR_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace bark {
+namespace commons {
+
+//! allocation counters of one thread
+struct PoolStatistics {
+  //! blocks handed out, including the ones that were reused
+  std::size_t num_allocations = 0;
+  //! blocks handed out from a free list instead of the heap
+  std::size_t num_reused = 0;
+  //! blocks returned to a free list
+  std::size_t num_recycled = 0;
+  //! blocks returned to the heap because their free list was full
+  std::size_t num_trimmed = 0;
+};
+
+//! Free lists of the calling thread, one per size class. Released blocks
+//! are kept for the next allocation of their size class, so discarding a
+//! cloned world and cloning the next one does not reach the heap. A block
+//! released by another thread joins the free list of that thread; as each
+//! free list is capped, blocks that are allocated on worker threads and
+//! released on another one do not accumulate there.
+class ThreadLocalPool {
+ public:
+  //! block sizes are multiples of the alignment of operator new
+  static constexpr std::size_t kGranularity = alignof(std::max_align_t);
+  static constexpr std::size_t kNumSizeClasses = 64;
+  //! bytes that the free list of one size class keeps at most
+  static constexpr std::size_t kMaxFreeBytesPerSizeClass = 256 * 1024;
+
+  static void* Allocate(std::size_t size) {
+    const std::size_t size_class = SizeClass(size);
+    Pools* pools = Get();
+    if (pools) ++pools->statistics.num_allocations;
+    if (!pools || size_class >= kNumSizeClasses) {
+      return ::operator new(size);
+    }
+    FreeBlock*& free_list = pools->free_lists[size_class];
+    if (free_list) {
+      FreeBlock* block = free_list;
+      free_list = block->next;
+      --pools->num_free_blocks[size_class];
+      ++pools->statistics.num_reused;
+      return block;
+    }
+    return ::operator new(BlockSize(size_class));
+  }
+
+  static void Deallocate(void* pointer, std::size_t size) {
+    const std::size_t size_class = SizeClass(size);
+    Pools* pools = Get();
+    if (!pools || size_class >= kNumSizeClasses) {
+      ::operator delete(pointer);
+      return;
+    }
+    if (pools->num_free_blocks[size_class] >=
+        kMaxFreeBytesPerSizeClass / BlockSize(size_class)) {
+      ::operator delete(pointer);
+      ++pools->statistics.num_trimmed;
+      return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    block->next = pools->free_lists[size_class];
+    pools->free_lists[size_class] = block;
+    ++pools->num_free_blocks[size_class];
+    ++pools->statistics.num_recycled;
+  }
+
+  //! returns the free blocks of the calling thread to the heap
+  static void Release() {
+    if (Pools* pools = Get()) pools->Release();
+  }
+
+  //! returns the free blocks of all threads to the heap, e.g. after the
+  //! predicted worlds of a search have been discarded; the calling thread
+  //! releases its blocks at once, the other threads on their next
+  //! allocation or deallocation
+  static void ReleaseAll() {
+    ReleaseEpoch().fetch_add(1, std::memory_order_relaxed);
+    Release();
+  }
+
+  static PoolStatistics GetStatistics() {
+    Pools* pools = Get();
+    return pools ? pools->statistics : PoolStatistics();
+  }
+
+  static void ResetStatistics() {
+    if (Pools* pools = Get()) pools->statistics = PoolStatistics();
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct Pools {
+    std::array<FreeBlock*, kNumSizeClasses> free_lists{};
+    std::array<std::size_t, kNumSizeClasses> num_free_blocks{};
+    //! value of the release epoch at the last release of this thread
+    std::size_t release_epoch = ReleaseEpoch().load(std::memory_order_relaxed);
+    PoolStatistics statistics;
+
+    void Release() {
+      for (FreeBlock*& free_list : free_lists) {
+        while (free_list) {
+          FreeBlock* block = free_list;
+          free_list = block->next;
+          ::operator delete(block);
+        }
+      }
+      num_free_blocks.fill(0);
+      release_epoch = ReleaseEpoch().load(std::memory_order_relaxed);
+    }
+    ~Pools() {
+      Release();
+      Alive() = false;
+    }
+  };
+
+  static std::size_t SizeClass(std::size_t size) {
+    return size == 0 ? 0 : (size - 1) / kGranularity;
+  }
+
+  static std::size_t BlockSize(std::size_t size_class) {
+    return (size_class + 1) * kGranularity;
+  }
+
+  //! incremented by ReleaseAll
+  static std::atomic<std::size_t>& ReleaseEpoch() {
+    static std::atomic<std::size_t> release_epoch(0);
+    return release_epoch;
+  }
+
+  //! nullptr once the pools of the thread are destroyed, blocks released
+  //! afterwards go to the heap; releases the free blocks if another thread
+  //! called ReleaseAll since the last release
+  static Pools* Get() {
+    thread_local Pools pools;
+    if (!Alive()) {
+      return nullptr;
+    }
+    if (pools.release_epoch !=
+        ReleaseEpoch().load(std::memory_order_relaxed)) {
+      pools.Release();
+    }
+    return &pools;
+  }
+
+  static bool& Alive() {
+    thread_local bool alive = true;
+    return alive;
+  }
+};
+
+//! standard allocator that draws from the pools of the calling thread;
+//! over-aligned types, e.g. with fixed-size Eigen members under AVX, are
+//! allocated with aligned operator new instead
+template <typename T>
+class PoolAllocator {
+ public:
+  typedef T value_type;
+
+  PoolAllocator() noexcept {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    if constexpr (alignof(T) > ThreadLocalPool::kGranularity) {
+      return static_cast<T*>(
+          ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+      return static_cast<T*>(ThreadLocalPool::Allocate(n * sizeof(T)));
+    }
+  }
+  void deallocate(T* pointer, std::size_t n) {
+    if constexpr (alignof(T) > ThreadLocalPool::kGranularity) {
+      ::operator delete(pointer, std::align_val_t(alignof(T)));
+    } else {
+      ThreadLocalPool::Deallocate(pointer, n * sizeof(T));
+    }
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+  return false;
+}
+
+//! make_shared with the object and its control block in one pooled block
+template <typename T, typename... Args>
+std::shared_ptr<T> MakePooled(Args&&... args) {
+  return std::allocate_shared<T>(PoolAllocator<T>(),
+                                 std::forward<Args>(args)...);
+}
+
+}  // namespace commons
+}  // namespace bark
+
+#endif  // BARK_COMMONS_UTIL_POOL_ALLOCATOR_HPP_
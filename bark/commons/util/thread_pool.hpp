@@ -0,0 +1,141 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_COMMONS_UTIL_THREAD_POOL_HPP_
+#define BARK_COMMONS_UTIL_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bark {
+namespace commons {
+
+//! Fixed set of worker threads that run the iterations of parallel loops.
+//! The calling thread takes part in its loop, so loops can be nested and
+//! a pool without workers runs them serially.
+class ThreadPool {
+ public:
+  explicit ThreadPool(std::size_t num_threads) : stop_(false) {
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      workers_.emplace_back([this] { WorkerLoop(); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  std::size_t GetNumThreads() const { return workers_.size(); }
+
+  //! calls task(i) for all i in [0, num_tasks) and returns once all calls
+  //! are done; the first exception thrown by a call is rethrown
+  void ParallelFor(std::size_t num_tasks,
+                   const std::function<void(std::size_t)>& task) {
+    if (num_tasks == 0) return;
+    auto loop = std::make_shared<Loop>(num_tasks, task);
+    const std::size_t num_helpers = std::min(workers_.size(), num_tasks - 1);
+    if (num_helpers > 0) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t i = 0; i < num_helpers; ++i) {
+          loops_.push_back(loop);
+        }
+      }
+      condition_.notify_all();
+    }
+    loop->Run();
+    loop->Wait();
+    if (loop->exception) std::rethrow_exception(loop->exception);
+  }
+
+  //! shared pool with one thread per hardware thread, including the
+  //! calling one
+  static ThreadPool& Default() {
+    static ThreadPool pool(
+        std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    return pool;
+  }
+
+ private:
+  struct Loop {
+    Loop(std::size_t num_tasks, const std::function<void(std::size_t)>& task)
+        : num_tasks(num_tasks), task(task), next_task(0), num_done(0) {}
+
+    void Run() {
+      for (std::size_t i = next_task++; i < num_tasks; i = next_task++) {
+        try {
+          task(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!exception) exception = std::current_exception();
+        }
+        if (++num_done == num_tasks) {
+          std::lock_guard<std::mutex> lock(mutex);
+          done.notify_all();
+        }
+      }
+    }
+
+    void Wait() {
+      std::unique_lock<std::mutex> lock(mutex);
+      done.wait(lock, [this] { return num_done == num_tasks; });
+    }
+
+    const std::size_t num_tasks;
+    const std::function<void(std::size_t)> task;
+    std::atomic<std::size_t> next_task;
+    std::atomic<std::size_t> num_done;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr exception;
+  };
+
+  void WorkerLoop() {
+    while (true) {
+      std::shared_ptr<Loop> loop;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return stop_ || !loops_.empty(); });
+        if (stop_ && loops_.empty()) return;
+        loop = std::move(loops_.front());
+        loops_.pop_front();
+      }
+      loop->Run();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::deque<std::shared_ptr<Loop>> loops_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_;
+};
+
+}  // namespace commons
+}  // namespace bark
+
+#endif  // BARK_COMMONS_UTIL_THREAD_POOL_HPP_
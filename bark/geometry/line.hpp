@@ -236,8 +236,8 @@ inline Line Simplify(const Line& line, float max_distance) {
   return temp_line;
 }
 
-inline int GetSegmentEndIdx(Line l, float s) {
-  std::vector<float>::iterator up =
+inline int GetSegmentEndIdx(const Line& l, float s) {
+  std::vector<float>::const_iterator up =
       std::upper_bound(l.s_.begin(), l.s_.end(), s);
   if (up != l.s_.end()) {
     int retval = up - l.s_.begin();
@@ -247,9 +247,9 @@ inline int GetSegmentEndIdx(Line l, float s) {
   }
 }
 
-inline bool CheckSForSegmentIntersection(Line l, float s) {
+inline bool CheckSForSegmentIntersection(const Line& l, float s) {
   int start_it = GetSegmentEndIdx(l, s);
-  std::vector<float>::iterator low =
+  std::vector<float>::const_iterator low =
       std::lower_bound(l.s_.begin(), l.s_.end(), s);
   int start_it_low = low - l.s_.begin();
   return start_it != start_it_low;
@@ -264,7 +264,49 @@ inline Point2d GetPointAtIdx(const Line& l, const uint idx) {
   }
 }
 
-inline Point2d GetPointAtS(Line l, float s) {
+//! interpolates the point at s on the segment ending at segment_end_idx
+inline Point2d GetPointOnSegment(const Line& l, float s, int segment_end_idx) {
+  int segment_begin_idx = segment_end_idx - 1;
+
+  float s_on_segment = (s - l.s_.at(segment_begin_idx)) /
+                       (l.s_.at(segment_end_idx) - l.s_.at(segment_begin_idx));
+  float interp_pt_x =
+      bg::get<0>(l.obj_.at(segment_begin_idx)) +
+      s_on_segment * (bg::get<0>(l.obj_.at(segment_end_idx)) -
+                      bg::get<0>(l.obj_.at(segment_begin_idx)));
+  float interp_pt_y =
+      bg::get<1>(l.obj_.at(segment_begin_idx)) +
+      s_on_segment * (bg::get<1>(l.obj_.at(segment_end_idx)) -
+                      bg::get<1>(l.obj_.at(segment_begin_idx)));
+  return Point2d(interp_pt_x, interp_pt_y);
+}
+
+//! tangent angle at s on the segment ending at end_segment_it; at the
+//! joint of two segments the mean angle of both segments is used
+inline float GetTangentAngleOnSegment(const Line& l, int end_segment_it,
+                                      bool at_segment_intersection) {
+  if (at_segment_intersection) {
+    Point2d p1 = l.obj_.at(end_segment_it - 2);
+    Point2d p2 = l.obj_.at(end_segment_it - 1);
+    Point2d p3 = l.obj_.at(end_segment_it);
+    float sin_mean = 0.5 * (sin(atan2(bg::get<1>(p2) - bg::get<1>(p1),
+                                      bg::get<0>(p2) - bg::get<0>(p1))) +
+                            sin(atan2(bg::get<1>(p3) - bg::get<1>(p2),
+                                      bg::get<0>(p3) - bg::get<0>(p2))));
+    float cos_mean = 0.5 * (cos(atan2(bg::get<1>(p2) - bg::get<1>(p1),
+                                      bg::get<0>(p2) - bg::get<0>(p1))) +
+                            cos(atan2(bg::get<1>(p3) - bg::get<1>(p2),
+                                      bg::get<0>(p3) - bg::get<0>(p2))));
+    return atan2(sin_mean, cos_mean);
+  } else {  // every s not start, end or intersection
+    Point2d p1 = l.obj_.at(end_segment_it - 1);
+    Point2d p2 = l.obj_.at(end_segment_it);
+    return atan2(bg::get<1>(p2) - bg::get<1>(p1),
+                 bg::get<0>(p2) - bg::get<0>(p1));
+  }
+}
+
+inline Point2d GetPointAtS(const Line& l, float s) {
   const size_t& length = l.obj_.size();
   if (length <= 1) {  // this is an error Line consist of 0 or 1 element
     return Point2d(0, 0);
@@ -273,25 +315,11 @@ inline Point2d GetPointAtS(Line l, float s) {
   } else if (s >= l.s_.back()) {  // edge case end
     return l.obj_.at(length - 1);
   } else {  // nominal case
-    int segment_end_idx = GetSegmentEndIdx(l, s);
-    int segment_begin_idx = segment_end_idx - 1;
-
-    float s_on_segment =
-        (s - l.s_.at(segment_begin_idx)) /
-        (l.s_.at(segment_end_idx) - l.s_.at(segment_begin_idx));
-    float interp_pt_x =
-        bg::get<0>(l.obj_.at(segment_begin_idx)) +
-        s_on_segment * (bg::get<0>(l.obj_.at(segment_end_idx)) -
-                        bg::get<0>(l.obj_.at(segment_begin_idx)));
-    float interp_pt_y =
-        bg::get<1>(l.obj_.at(segment_begin_idx)) +
-        s_on_segment * (bg::get<1>(l.obj_.at(segment_end_idx)) -
-                        bg::get<1>(l.obj_.at(segment_begin_idx)));
-    return Point2d(interp_pt_x, interp_pt_y);
+    return GetPointOnSegment(l, s, GetSegmentEndIdx(l, s));
   }
 }
 
-inline float GetTangentAngleAtS(Line l, float s) {
+inline float GetTangentAngleAtS(const Line& l, float s) {
   if (s >= l.s_.back()) {
     Point2d p1 = l.obj_.at(l.obj_.size() - 2);
     Point2d p2 = l.obj_.at(l.obj_.size() - 1);
@@ -304,38 +332,71 @@ inline float GetTangentAngleAtS(Line l, float s) {
     return atan2(bg::get<1>(p2) - bg::get<1>(p1),
                  bg::get<0>(p2) - bg::get<0>(p1));
   } else {  // not start or end
-    int end_segment_it = GetSegmentEndIdx(l, s);
     // check if s is at intersection, if true then calculate the angle
-    if (CheckSForSegmentIntersection(l, s)) {
-      Point2d p1 = l.obj_.at(end_segment_it - 2);
-      Point2d p2 = l.obj_.at(end_segment_it - 1);
-      Point2d p3 = l.obj_.at(end_segment_it);
-      float sin_mean = 0.5 * (sin(atan2(bg::get<1>(p2) - bg::get<1>(p1),
-                                        bg::get<0>(p2) - bg::get<0>(p1))) +
-                              sin(atan2(bg::get<1>(p3) - bg::get<1>(p2),
-                                        bg::get<0>(p3) - bg::get<0>(p2))));
-      float cos_mean = 0.5 * (cos(atan2(bg::get<1>(p2) - bg::get<1>(p1),
-                                        bg::get<0>(p2) - bg::get<0>(p1))) +
-                              cos(atan2(bg::get<1>(p3) - bg::get<1>(p2),
-                                        bg::get<0>(p3) - bg::get<0>(p2))));
-      return atan2(sin_mean, cos_mean);
-    } else {  // every s not start, end or intersection
-      Point2d p1 = l.obj_.at(end_segment_it - 1);
-      Point2d p2 = l.obj_.at(end_segment_it);
-      return atan2(bg::get<1>(p2) - bg::get<1>(p1),
-                   bg::get<0>(p2) - bg::get<0>(p1));
-    }
+    return GetTangentAngleOnSegment(l, GetSegmentEndIdx(l, s),
+                                    CheckSForSegmentIntersection(l, s));
   }
 }
 
-inline Point2d GetNormalAtS(Line l, float s) {
+inline Point2d GetNormalAtS(const Line& l, float s) {
   float tangent = GetTangentAngleAtS(l, s);
   // rotate unit vector anti-clockwise with angle = tangent by 1/2 pi
   Point2d t(cos(tangent + asin(1)), sin(tangent + asin(1)));
   return t;
 }
 
-inline Line GetLineFromSInterval(Line line, float begin, float end) {
+//! Evaluates a line at non-decreasing values of s, e.g. along a
+//! trajectory. The segment search continues from the previous segment
+//! instead of a binary search over the whole line; decreasing values of s
+//! are supported, but restart the search. The results equal the ones of
+//! GetPointAtS and GetTangentAngleAtS. The line has to outlive the cursor.
+class LineSCursor {
+ public:
+  explicit LineSCursor(const Line& line) : line_(line), upper_idx_(0) {}
+
+  Point2d GetPointAtS(float s) {
+    const size_t& length = line_.obj_.size();
+    if (length <= 1) {
+      return Point2d(0, 0);
+    } else if (s <= 0.0) {
+      return line_.obj_.at(0);
+    } else if (s >= line_.s_.back()) {
+      return line_.obj_.at(length - 1);
+    }
+    return GetPointOnSegment(line_, s, GetSegmentEndIdx(s));
+  }
+
+  float GetTangentAngleAtS(float s) {
+    if (s >= line_.s_.back() || s <= 0.0) {
+      return geometry::GetTangentAngleAtS(line_, s);
+    }
+    const int end_segment_it = GetSegmentEndIdx(s);
+    return GetTangentAngleOnSegment(line_, end_segment_it,
+                                    line_.s_[end_segment_it - 1] == s);
+  }
+
+ private:
+  //! same as GetSegmentEndIdx(line, s)
+  int GetSegmentEndIdx(float s) {
+    const std::vector<float>& s_values = line_.s_;
+    if (upper_idx_ > s_values.size() ||
+        (upper_idx_ > 0 && s_values[upper_idx_ - 1] > s)) {
+      upper_idx_ = std::upper_bound(s_values.begin(), s_values.end(), s) -
+                   s_values.begin();
+    }
+    while (upper_idx_ < s_values.size() && s_values[upper_idx_] <= s) {
+      ++upper_idx_;
+    }
+    if (upper_idx_ < s_values.size()) return upper_idx_;
+    return s_values.size() - 1;
+  }
+
+  const Line& line_;
+  //! index of the first s value larger than the last queried s
+  size_t upper_idx_;
+};
+
+inline Line GetLineFromSInterval(const Line& line, float begin, float end) {
   Line new_line;
   new_line.AddPoint(GetPointAtS(line, begin));
   std::vector<Point2d> points = line.GetPointsInSInterval(begin, end);
@@ -358,7 +419,7 @@ inline Line GetLineShiftedLaterally(const Line& line, float lateral_shift) {
 }
 
 inline std::tuple<Point2d, double, uint> GetNearestPointAndS(
-    Line l, const Point2d& p) {  // GetNearestPoint
+    const Line& l, const Point2d& p) {  // GetNearestPoint
   // edge cases: empty or one-point line
   if (l.obj_.empty()) {
     return std::make_tuple(Point2d(0, 0), 0.0, 0);
@@ -371,9 +432,8 @@ inline std::tuple<Point2d, double, uint> GetNearestPointAndS(
   double min_dist = boost::numeric::bounds<float>::highest();
   int min_segment_idx = 0;
   for (uint line_idx = 0; line_idx < l.obj_.size() - 1; ++line_idx) {
-    bg::model::linestring<Point2d> current_segment;
-    bg::append(current_segment, l.obj_.at(line_idx));
-    bg::append(current_segment, l.obj_.at(line_idx + 1));
+    bg::model::segment<Point2d> current_segment(l.obj_[line_idx],
+                                                l.obj_[line_idx + 1]);
     double d = bg::comparable_distance(current_segment, p);
     if (d < min_dist) {
       min_dist = d;
@@ -436,13 +496,13 @@ inline std::tuple<Point2d, double, uint> GetNearestPointAndS(
   // return
   return std::make_tuple(retval, s, min_segment_idx);
 }
-inline Point2d GetNearestPoint(Line l, const Point2d& p) {
+inline Point2d GetNearestPoint(const Line& l, const Point2d& p) {
   return std::get<0>(GetNearestPointAndS(l, p));
 }
-inline float GetNearestS(Line l, const Point2d& p) {
+inline float GetNearestS(const Line& l, const Point2d& p) {
   return std::get<1>(GetNearestPointAndS(l, p));
 }
-inline uint FindNearestIdx(Line l, const Point2d& p) {
+inline uint FindNearestIdx(const Line& l, const Point2d& p) {
   return std::get<2>(GetNearestPointAndS(l, p));
 }
 //! Point - Line collision checker using boost::intersection
@@ -0,0 +1,166 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/geometry/signed_distance_grid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <boost/geometry/index/rtree.hpp>
+
+namespace bark {
+namespace geometry {
+
+namespace bgi = boost::geometry::index;
+using Segment = bg::model::segment<Point2d>;
+
+namespace {
+
+template <typename Ring>
+void AddRingSegments(const Ring& ring, std::vector<Segment>* segments) {
+  for (std::size_t i = 0; i + 1 < ring.size(); ++i) {
+    segments->push_back(Segment(ring[i], ring[i + 1]));
+  }
+}
+
+}  // namespace
+
+SignedDistanceGrid::SignedDistanceGrid(const Polygon& polygon,
+                                       double resolution,
+                                       std::size_t max_num_cells)
+    : SignedDistanceGrid() {
+  const auto& outer = polygon.obj_.outer();
+  if (outer.size() < 3 || resolution <= 0.0) return;
+
+  std::vector<Segment> segments;
+  AddRingSegments(outer, &segments);
+  for (const auto& inner : polygon.obj_.inners()) {
+    AddRingSegments(inner, &segments);
+  }
+  has_interiors_ = !polygon.obj_.inners().empty();
+
+  // the grid covers the bounding box with one additional cell on each side
+  std::pair<Point2d, Point2d> bbox = polygon.BoundingBox();
+  const double num_x = std::ceil(
+      (bg::get<0>(bbox.second) - bg::get<0>(bbox.first)) / resolution) + 2;
+  const double num_y = std::ceil(
+      (bg::get<1>(bbox.second) - bg::get<1>(bbox.first)) / resolution) + 2;
+  if (num_x * num_y > static_cast<double>(max_num_cells)) {
+    LOG(WARNING) << "Signed distance grid would need " << num_x * num_y
+                 << " cells (limit " << max_num_cells
+                 << "), falling back to exact distances.";
+    return;
+  }
+  resolution_ = resolution;
+  origin_x_ = bg::get<0>(bbox.first) - resolution;
+  origin_y_ = bg::get<1>(bbox.first) - resolution;
+  num_x_ = static_cast<std::size_t>(num_x);
+  num_y_ = static_cast<std::size_t>(num_y);
+  distances_.resize(num_x_ * num_y_);
+
+  // exact distances are only computed in a narrow band around the boundary;
+  // all other cells store the band width, which underestimates the distance
+  const double band = kBandCells * resolution_;
+  std::vector<bool> in_band(num_x_ * num_y_, false);
+  const int band_radius = kBandCells + 2;
+  for (const auto& s : segments) {
+    const double x0 = bg::get<0, 0>(s), y0 = bg::get<0, 1>(s);
+    const double dx = bg::get<1, 0>(s) - x0, dy = bg::get<1, 1>(s) - y0;
+    const int num_samples = static_cast<int>(
+        std::ceil(std::hypot(dx, dy) / resolution_));
+    for (int n = 0; n <= num_samples; ++n) {
+      const double t = num_samples > 0 ? static_cast<double>(n) / num_samples
+                                       : 0.0;
+      const int ci = static_cast<int>((x0 + t * dx - origin_x_) / resolution_);
+      const int cj = static_cast<int>((y0 + t * dy - origin_y_) / resolution_);
+      for (int j = std::max(0, cj - band_radius);
+           j <= std::min(static_cast<int>(num_y_) - 1, cj + band_radius); ++j) {
+        for (int i = std::max(0, ci - band_radius);
+             i <= std::min(static_cast<int>(num_x_) - 1, ci + band_radius);
+             ++i) {
+          in_band[j * num_x_ + i] = true;
+        }
+      }
+    }
+  }
+
+  bgi::rtree<Segment, bgi::rstar<16>> rtree(segments.begin(), segments.end());
+  std::vector<double> crossings;
+  std::vector<Segment> nearest;
+  for (std::size_t j = 0; j < num_y_; ++j) {
+    const double y = origin_y_ + (j + 0.5) * resolution_;
+
+    // inside test using the crossings of the row with all rings (even-odd)
+    crossings.clear();
+    for (const auto& s : segments) {
+      const double y0 = bg::get<0, 1>(s), y1 = bg::get<1, 1>(s);
+      if ((y0 <= y) == (y1 <= y)) continue;
+      const double x0 = bg::get<0, 0>(s), x1 = bg::get<1, 0>(s);
+      crossings.push_back(x0 + (y - y0) / (y1 - y0) * (x1 - x0));
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    std::size_t num_crossings_left = 0;
+    for (std::size_t i = 0; i < num_x_; ++i) {
+      const double x = origin_x_ + (i + 0.5) * resolution_;
+      while (num_crossings_left < crossings.size() &&
+             crossings[num_crossings_left] < x) {
+        ++num_crossings_left;
+      }
+      float dist = band;
+      if (in_band[j * num_x_ + i]) {
+        const Point2d center(x, y);
+        nearest.clear();
+        rtree.query(bgi::nearest(center, 1), std::back_inserter(nearest));
+        dist = bg::distance(center, nearest.front());
+      }
+      distances_[j * num_x_ + i] = num_crossings_left % 2 ? -dist : dist;
+    }
+  }
+}
+
+float SignedDistanceGrid::GetSignedDistance(const Point2d& pt) const {
+  const double fx = (bg::get<0>(pt) - origin_x_) / resolution_;
+  const double fy = (bg::get<1>(pt) - origin_y_) / resolution_;
+  if (Empty() || fx < 0.0 || fy < 0.0 || fx >= num_x_ || fy >= num_y_) {
+    return std::numeric_limits<float>::max();
+  }
+  return distances_[static_cast<std::size_t>(fy) * num_x_ +
+                    static_cast<std::size_t>(fx)];
+}
+
+GridWithinResult SignedDistanceGrid::Within(const Polygon& shape) const {
+  const auto& outer = shape.obj_.outer();
+  if (Empty() || outer.size() < 2) return GRID_UNDETERMINED;
+
+  // the signed distance is 1-Lipschitz: a cell value deviates by at most
+  // half a cell diagonal from the true value inside the cell and every
+  // boundary point of the shape is at most half a resolution away from a
+  // sample
+  const double lookup_tolerance = resolution_ * std::sqrt(0.5);
+  const double within_threshold = -(lookup_tolerance + 0.5 * resolution_);
+  bool all_within = true;
+  for (std::size_t k = 0; k + 1 < outer.size(); ++k) {
+    const double x0 = bg::get<0>(outer[k]), y0 = bg::get<1>(outer[k]);
+    const double dx = bg::get<0>(outer[k + 1]) - x0;
+    const double dy = bg::get<1>(outer[k + 1]) - y0;
+    const int num_samples = std::max(
+        1, static_cast<int>(std::ceil(std::hypot(dx, dy) / resolution_)));
+    for (int n = 0; n < num_samples; ++n) {
+      const double t = static_cast<double>(n) / num_samples;
+      const float d = GetSignedDistance(Point2d(x0 + t * dx, y0 + t * dy));
+      if (d > lookup_tolerance) return GRID_NOT_WITHIN;
+      if (d >= within_threshold) all_within = false;
+    }
+  }
+  // with holes, a hole could lie completely inside of the shape
+  if (all_within && !has_interiors_) return GRID_WITHIN;
+  return GRID_UNDETERMINED;
+}
+
+}  // namespace geometry
+}  // namespace bark
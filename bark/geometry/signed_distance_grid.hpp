@@ -0,0 +1,89 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_GEOMETRY_SIGNED_DISTANCE_GRID_HPP_
+#define BARK_GEOMETRY_SIGNED_DISTANCE_GRID_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "bark/geometry/polygon.hpp"
+
+namespace bark {
+namespace geometry {
+
+enum GridWithinResult {
+  GRID_WITHIN = 0,
+  GRID_NOT_WITHIN = 1,
+  GRID_UNDETERMINED = 2
+};
+
+//! regular grid storing the signed distance to the boundary of a polygon
+//! at the cell centers (negative inside, positive outside)
+class SignedDistanceGrid {
+ public:
+  SignedDistanceGrid()
+      : resolution_(0.0),
+        origin_x_(0.0),
+        origin_y_(0.0),
+        num_x_(0),
+        num_y_(0),
+        has_interiors_(false) {}
+  //! the grid stays empty if it would need more than max_num_cells cells;
+  //! Within(shape, polygon, grid) then uses the exact check
+  SignedDistanceGrid(const Polygon& polygon, double resolution,
+                     std::size_t max_num_cells = kDefaultMaxNumCells);
+
+  //! 4M cells, i.e. 16 MB of distances (a 500 m x 500 m map at 0.25 m)
+  static constexpr std::size_t kDefaultMaxNumCells = std::size_t(1) << 22;
+
+  //! signed distance of the nearest cell center; points outside of the
+  //! grid are always outside of the polygon
+  float GetSignedDistance(const Point2d& pt) const;
+
+  //! conservative within-check using the boundary of the shape; shapes
+  //! close to the polygon boundary are GRID_UNDETERMINED and require an
+  //! exact check
+  GridWithinResult Within(const Polygon& shape) const;
+
+  bool Empty() const { return distances_.empty(); }
+  double GetResolution() const { return resolution_; }
+  std::size_t GetNumCellsX() const { return num_x_; }
+  std::size_t GetNumCellsY() const { return num_y_; }
+
+ private:
+  //! half width of the band around the boundary with exact distances
+  static constexpr int kBandCells = 3;
+
+  double resolution_;
+  double origin_x_;
+  double origin_y_;
+  std::size_t num_x_;
+  std::size_t num_y_;
+  //! the boundary check is only sufficient for polygons without holes
+  bool has_interiors_;
+  std::vector<float> distances_;
+};
+
+typedef std::shared_ptr<SignedDistanceGrid> SignedDistanceGridPtr;
+
+//! uses the grid if available and falls back to the exact check
+inline bool Within(const Polygon& shape, const Polygon& polygon,
+                   const SignedDistanceGridPtr& grid) {
+  if (grid && !grid->Empty()) {
+    GridWithinResult result = grid->Within(shape);
+    if (result == GRID_WITHIN) return true;
+    if (result == GRID_NOT_WITHIN) return false;
+  }
+  return Within(shape, polygon);
+}
+
+}  // namespace geometry
+}  // namespace bark
+
+#endif  // BARK_GEOMETRY_SIGNED_DISTANCE_GRID_HPP_
@@ -9,6 +9,7 @@
 #include "bark/geometry/commons.hpp"
 #include "bark/geometry/line.hpp"
 #include "bark/geometry/polygon.hpp"
+#include "bark/geometry/signed_distance_grid.hpp"
 #include "bark/geometry/standard_shapes.hpp"
 #include "gtest/gtest.h"
 
@@ -651,6 +652,39 @@ TEST(line, GetPtAtIdx) {
   EXPECT_TRUE(point_3 == p3);
 }
 
+TEST(line, s_cursor) {
+  using bark::geometry::Line;
+  using bark::geometry::LineSCursor;
+  using bark::geometry::Point2d;
+  namespace bg = boost::geometry;
+
+  Line line;
+  line.AddPoint(Point2d(0.0, 0.0));
+  line.AddPoint(Point2d(2.0, 0.0));
+  line.AddPoint(Point2d(4.0, 1.0));
+  line.AddPoint(Point2d(4.0, 4.0));
+  line.AddPoint(Point2d(1.0, 6.0));
+
+  // increasing s including segment joints, then jumps backward
+  std::vector<float> s_values;
+  for (float s = -0.5f; s < line.Length() + 1.0f; s += 0.1f) {
+    s_values.push_back(s);
+  }
+  s_values.insert(s_values.end(), line.s_.begin(), line.s_.end());
+  s_values.push_back(1.5f);
+  s_values.push_back(0.5f);
+  s_values.push_back(7.0f);
+
+  LineSCursor cursor(line);
+  for (float s : s_values) {
+    Point2d expected_point = GetPointAtS(line, s);
+    Point2d point = cursor.GetPointAtS(s);
+    EXPECT_EQ(bg::get<0>(point), bg::get<0>(expected_point));
+    EXPECT_EQ(bg::get<1>(point), bg::get<1>(expected_point));
+    EXPECT_EQ(cursor.GetTangentAngleAtS(s), GetTangentAngleAtS(line, s));
+  }
+}
+
 TEST(line, GetLineFromSInterval) {
   using bark::geometry::Line_t;
   using bark::geometry::Point2d;
@@ -869,6 +903,63 @@ TEST(optimizer, shrink_polygon) {
   ASSERT_TRUE(Equals(expected_shrunk_polygon, shrunk_polygon));
 }
 
+TEST(signed_distance_grid, within) {
+  using bark::geometry::GRID_NOT_WITHIN;
+  using bark::geometry::GRID_UNDETERMINED;
+  using bark::geometry::GRID_WITHIN;
+  using bark::geometry::Point2d;
+  using bark::geometry::Polygon;
+  using bark::geometry::Pose;
+  using bark::geometry::SignedDistanceGrid;
+  using bark::geometry::SignedDistanceGridPtr;
+  using bark::geometry::standard_shapes::CarRectangle;
+
+  // u-shaped polygon
+  Polygon polygon(Pose(0, 0, 0),
+                  std::vector<Point2d>{Point2d(0, 0), Point2d(0, 40),
+                                       Point2d(60, 40), Point2d(60, 0),
+                                       Point2d(40, 0), Point2d(40, 20),
+                                       Point2d(20, 20), Point2d(20, 0),
+                                       Point2d(0, 0)});
+  SignedDistanceGrid grid(polygon, 0.25);
+  ASSERT_FALSE(grid.Empty());
+  EXPECT_NEAR(grid.GetSignedDistance(Point2d(10, 10)), -0.75, 1e-3);
+  EXPECT_NEAR(grid.GetSignedDistance(Point2d(30.05, 10.05)), 0.75, 1e-3);
+  EXPECT_NEAR(grid.GetSignedDistance(Point2d(10.01, 0.3)), -0.375, 1e-3);
+  EXPECT_GT(grid.GetSignedDistance(Point2d(100, 100)), 1000.0);
+
+  Polygon car = CarRectangle();
+  int num_undetermined = 0, num_samples = 0;
+  for (double x = -5.0; x < 65.0; x += 1.3) {
+    for (double y = -5.0; y < 45.0; y += 1.1) {
+      for (double theta = 0.0; theta < 3.0; theta += 0.7) {
+        auto shape = std::dynamic_pointer_cast<Polygon>(
+            car.Transform(Pose(x, y, theta)));
+        bool within = Within(*shape, polygon);
+        auto result = grid.Within(*shape);
+        if (result == GRID_WITHIN) {
+          EXPECT_TRUE(within);
+        }
+        if (result == GRID_NOT_WITHIN) {
+          EXPECT_FALSE(within);
+        }
+        if (result == GRID_UNDETERMINED) ++num_undetermined;
+        ++num_samples;
+      }
+    }
+  }
+  // only shapes close to the boundary require the exact check
+  EXPECT_LT(num_undetermined, num_samples / 5);
+
+  // grids exceeding the cell limit stay empty and use the exact check
+  SignedDistanceGridPtr capped_grid =
+      std::make_shared<SignedDistanceGrid>(polygon, 0.25, 1000);
+  EXPECT_TRUE(capped_grid->Empty());
+  auto shape = std::dynamic_pointer_cast<Polygon>(
+      car.Transform(Pose(10, 30, 0)));
+  EXPECT_EQ(Within(*shape, polygon, capped_grid), Within(*shape, polygon));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
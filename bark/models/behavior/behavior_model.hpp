@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "bark/commons/commons.hpp"
+#include "bark/commons/util/pool_allocator.hpp"
 #include "bark/models/dynamic/dynamic_model.hpp"
 
 namespace bark {
@@ -99,16 +100,25 @@ class BehaviorModel : public bark::commons::BaseType {
 
   BehaviorModel(const BehaviorModel& behavior_model)
       : commons::BaseType(behavior_model.GetParams()),
-        last_trajectory_(behavior_model.GetLastTrajectory()),
+        last_trajectory_(behavior_model.last_trajectory_),
         last_action_(behavior_model.GetLastAction()),
         behavior_status_(behavior_model.GetBehaviorStatus()) {}
 
   virtual ~BehaviorModel() {}
 
-  dynamic::Trajectory GetLastTrajectory() const { return last_trajectory_; }
+  //! the reference is invalidated by the next SetLastTrajectory or
+  //! MutableLastTrajectory, i.e. by the next Plan
+  const dynamic::Trajectory& GetLastTrajectory() const {
+    return last_trajectory_.Get();
+  }
 
   void SetLastTrajectory(const dynamic::Trajectory& trajectory) {
-    last_trajectory_ = trajectory;
+    last_trajectory_.Set(trajectory);
+  }
+
+  //! lets models generate the last trajectory in place
+  dynamic::Trajectory* MutableLastTrajectory() {
+    return last_trajectory_.Mutable();
   }
 
   BehaviorStatus GetBehaviorStatus() const { return behavior_status_; }
@@ -132,7 +142,7 @@ class BehaviorModel : public bark::commons::BaseType {
   };
 
  private:
-  dynamic::Trajectory last_trajectory_;
+  dynamic::SharedTrajectory last_trajectory_;
   // can either be the last action or action to be executed
   Action last_action_;
   Action action_to_behavior_;
@@ -45,6 +45,8 @@ class BehaviorConstantAcceleration : public BehaviorIDMClassic {
       const IDMRelativeValues& rel_values, double rel_distance,
       double dt) const;
 
+  double GetConstAcceleration() const { return const_acc_; }
+
   virtual std::shared_ptr<BehaviorModel> Clone() const;
 
  private:
@@ -53,7 +55,7 @@ class BehaviorConstantAcceleration : public BehaviorIDMClassic {
 
 inline std::shared_ptr<BehaviorModel> BehaviorConstantAcceleration::Clone() const {
   std::shared_ptr<BehaviorConstantAcceleration> model_ptr =
-      std::make_shared<BehaviorConstantAcceleration>(*this);
+      commons::MakePooled<BehaviorConstantAcceleration>(*this);
   return model_ptr;
 }
 
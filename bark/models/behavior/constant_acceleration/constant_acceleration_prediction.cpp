@@ -0,0 +1,148 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/behavior/constant_acceleration/constant_acceleration_prediction.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+using bark::geometry::Line;
+using bark::geometry::Point2d;
+using dynamic::StateDefinition;
+using world::map::RoadCorridorPtr;
+
+ConstantAccelerationPrediction::ConstantAccelerationPrediction(
+    const world::ObservedWorld& observed_world,
+    const BehaviorConstantAcceleration& prediction_model)
+    : world_time_(observed_world.GetWorldTime()),
+      acceleration_(prediction_model.GetConstAcceleration()),
+      min_velocity_(prediction_model.GetMinVelocity()),
+      max_velocity_(prediction_model.GetMaxVelocity()),
+      num_trajectory_time_points_(
+          prediction_model.GetNumTrajectoryTimePoints()) {
+  for (const auto& agent : observed_world.GetAgents()) {
+    agents_[agent.first] = agent.second;
+    // same lane corridor as used by ObservedWorld::GetLaneCorridor()
+    const RoadCorridorPtr& road_corridor = agent.second->GetRoadCorridor();
+    if (!road_corridor) continue;
+    const Point2d position = agent.second->GetCurrentPosition();
+    LaneCorridorPtr lane_corridor =
+        road_corridor->GetNearestLaneCorridor(position);
+    if (!lane_corridor || lane_corridor->GetCenterLine().obj_.empty()) {
+      continue;
+    }
+    // the shape is rotated around its center
+    const auto& shape = agent.second->GetShape();
+    float shape_radius = std::hypot(shape.center_[0], shape.center_[1]);
+    float max_center_distance = 0.;
+    for (const auto& point : shape.obj_.outer()) {
+      max_center_distance = std::max(
+          max_center_distance,
+          static_cast<float>(
+              std::hypot(boost::geometry::get<0>(point) - shape.center_[0],
+                         boost::geometry::get<1>(point) - shape.center_[1])));
+    }
+    shape_radius += max_center_distance;
+    predicted_agents_[agent.first] = PredictedAgent{
+        lane_corridor,
+        geometry::GetNearestS(lane_corridor->GetCenterLine(), position),
+        static_cast<float>(
+            agent.second->GetCurrentState()(StateDefinition::VEL_POSITION)),
+        shape_radius};
+  }
+}
+
+bool ConstantAccelerationPrediction::PredictState(const AgentId& agent_id,
+                                                  float time_span,
+                                                  State* state) const {
+  auto predicted_agent = predicted_agents_.find(agent_id);
+  if (predicted_agent == predicted_agents_.end()) return false;
+  const State& current_state = agents_.at(agent_id)->GetCurrentState();
+  // the interpolating execution model returns the first trajectory point
+  if (time_span <= 0.) {
+    *state = current_state.head(StateDefinition::MIN_STATE_SIZE);
+    return true;
+  }
+
+  // integration as in BehaviorIDMClassic::GenerateTrajectoryInPlace
+  const PredictedAgent& agent = predicted_agent->second;
+  double dt = time_span / (num_trajectory_time_points_ - 1);
+  float s_i = agent.s_start;
+  float vel_i = agent.vel_start;
+  for (int i = 1; i < num_trajectory_time_points_; ++i) {
+    s_i += 0.5f * acceleration_ * dt * dt + vel_i * dt;
+    const float temp_velocity = vel_i + acceleration_ * dt;
+    vel_i = std::max(std::min(temp_velocity, max_velocity_), min_velocity_);
+  }
+  const Line& line = agent.lane_corridor->GetCenterLine();
+  const Point2d point = geometry::GetPointAtS(line, s_i);
+  state->resize(StateDefinition::MIN_STATE_SIZE);
+  (*state)(StateDefinition::TIME_POSITION) =
+      static_cast<float>(num_trajectory_time_points_ - 1) * dt + world_time_;
+  (*state)(StateDefinition::X_POSITION) = boost::geometry::get<0>(point);
+  (*state)(StateDefinition::Y_POSITION) = boost::geometry::get<1>(point);
+  (*state)(StateDefinition::THETA_POSITION) =
+      geometry::GetTangentAngleAtS(line, s_i);
+  (*state)(StateDefinition::VEL_POSITION) = vel_i;
+  return true;
+}
+
+bool ConstantAccelerationPrediction::GetSweptBoundingBox(
+    const AgentId& agent_id, float time_horizon,
+    BoundingBox* bounding_box) const {
+  auto predicted_agent = predicted_agents_.find(agent_id);
+  if (predicted_agent == predicted_agents_.end()) return false;
+  const PredictedAgent& agent = predicted_agent->second;
+
+  // bound of the traveled distance: the velocity is clamped after the
+  // first integration step and each step adds at most 0.5*|a|*dt^2
+  const float max_abs_velocity =
+      std::max({std::fabs(agent.vel_start), std::fabs(min_velocity_),
+                std::fabs(max_velocity_)});
+  const float max_distance =
+      max_abs_velocity * time_horizon +
+      0.5 * std::fabs(acceleration_) * time_horizon * time_horizon;
+  const float s_begin = agent.s_start - max_distance;
+  const float s_end = agent.s_start + max_distance;
+
+  const Line& line = agent.lane_corridor->GetCenterLine();
+  std::vector<Point2d> points;
+  for (std::size_t i = 0; i < line.s_.size(); ++i) {
+    if (line.s_[i] > s_begin && line.s_[i] < s_end) {
+      points.push_back(line.obj_.at(i));
+    }
+  }
+  points.push_back(geometry::GetPointAtS(line, s_begin));
+  points.push_back(geometry::GetPointAtS(line, s_end));
+  // the unpredicted state at t = 0
+  points.push_back(agents_.at(agent_id)->GetCurrentPosition());
+
+  float min_x = boost::geometry::get<0>(points.front());
+  float max_x = min_x;
+  float min_y = boost::geometry::get<1>(points.front());
+  float max_y = min_y;
+  for (const auto& point : points) {
+    min_x = std::min(min_x, boost::geometry::get<0>(point));
+    max_x = std::max(max_x, boost::geometry::get<0>(point));
+    min_y = std::min(min_y, boost::geometry::get<1>(point));
+    max_y = std::max(max_y, boost::geometry::get<1>(point));
+  }
+  const float r = agent.shape_radius;
+  *bounding_box =
+      BoundingBox(Point2d(min_x - r, min_y - r), Point2d(max_x + r, max_y + r));
+  return true;
+}
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
@@ -0,0 +1,75 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_BEHAVIOR_CONSTANT_ACCELERATION_CONSTANT_ACCELERATION_PREDICTION_HPP_
+#define BARK_MODELS_BEHAVIOR_CONSTANT_ACCELERATION_CONSTANT_ACCELERATION_PREDICTION_HPP_
+
+#include <map>
+#include <memory>
+
+#include "bark/geometry/polygon.hpp"
+#include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
+#include "bark/world/observed_world.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+using dynamic::State;
+using world::map::LaneCorridorPtr;
+using world::objects::AgentPtr;
+
+typedef boost::geometry::model::box<geometry::Point2d> BoundingBox;
+
+//! Kinematic prediction of all agents of an observed world that yields
+//! the states of ObservedWorld::Predict(time_span) with every agent
+//! using the given BehaviorConstantAcceleration and an
+//! ExecutionModelInterpolate. Only the poses along the lane corridors of
+//! the agents are propagated; the world is neither cloned nor stepped.
+class ConstantAccelerationPrediction {
+ public:
+  ConstantAccelerationPrediction(
+      const world::ObservedWorld& observed_world,
+      const BehaviorConstantAcceleration& prediction_model);
+
+  //! state of the agent after the time span; false if the agent would not
+  //! be valid in the predicted world, e.g., as it has no lane corridor
+  bool PredictState(const AgentId& agent_id, float time_span,
+                    State* state) const;
+
+  //! conservative bounding box of all footprints of the agent within
+  //! [0, time_horizon]; false if the agent is not predicted
+  bool GetSweptBoundingBox(const AgentId& agent_id, float time_horizon,
+                           BoundingBox* bounding_box) const;
+
+  //! ids of all predicted agents in ascending order
+  const std::map<AgentId, AgentPtr>& GetAgents() const { return agents_; }
+
+ private:
+  struct PredictedAgent {
+    LaneCorridorPtr lane_corridor;
+    float s_start;
+    float vel_start;
+    //! largest distance of the shape to the agent's reference point
+    float shape_radius;
+  };
+
+  std::map<AgentId, AgentPtr> agents_;
+  std::map<AgentId, PredictedAgent> predicted_agents_;
+  double world_time_;
+  double acceleration_;
+  float min_velocity_;
+  float max_velocity_;
+  int num_trajectory_time_points_;
+};
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
+
+#endif  // BARK_MODELS_BEHAVIOR_CONSTANT_ACCELERATION_CONSTANT_ACCELERATION_PREDICTION_HPP_
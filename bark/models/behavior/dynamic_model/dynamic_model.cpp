@@ -8,7 +8,6 @@
 
 #include "bark/models/behavior/dynamic_model/dynamic_model.hpp"
 #include <cmath>
-#include "bark/models/dynamic/integration.hpp"
 #include "bark/models/dynamic/single_track.hpp"
 #include "bark/world/observed_world.hpp"
 
@@ -48,19 +47,14 @@ dynamic::Trajectory BehaviorDynamicModel::Plan(
   int num_trajectory_points =
       static_cast<int>(std::ceil(min_planning_time / dt)) + 1;
 
-  dynamic::Trajectory traj(num_trajectory_points,
-                           static_cast<int>(StateDefinition::MIN_STATE_SIZE));
-
   // this action is set externally. e.g. by RL
   Input action = boost::get<Input>(action_);
 
   // generate a trajectory with const. action
-  traj.row(0) = ego_vehicle_state;
+  dynamic::Trajectory traj = dynamic_model->IntegrateTrajectory(
+      ego_vehicle_state, action.transpose(), dt, num_trajectory_points - 1);
   for (int i = 1; i < num_trajectory_points; i++) {
-    auto next_state =
-        dynamic::euler_int(*dynamic_model, traj.row(i - 1), action, dt);
-    traj.row(i) = next_state;
-    traj(i, 0) = start_time + i * dt;
+    traj(i, TIME_POSITION) = start_time + i * dt;
   }
 
   this->SetLastTrajectory(traj);
@@ -46,7 +46,7 @@ class BehaviorDynamicModel : public BehaviorModel {
 
 inline std::shared_ptr<BehaviorModel> BehaviorDynamicModel::Clone() const {
   std::shared_ptr<BehaviorDynamicModel> model_ptr =
-      std::make_shared<BehaviorDynamicModel>(*this);
+      commons::MakePooled<BehaviorDynamicModel>(*this);
   return model_ptr;
 }
 
@@ -82,21 +82,26 @@ double BaseIDM::CalcFreeRoadTerm(const double vel_ego) const {
   return free_road_term;
 }
 
-double BaseIDM::CalcInteractionTerm(double net_distance, double vel_ego,
-                                    double vel_other) const {
+double BaseIDM::CalcDesiredGap(double vel_ego, double vel_other) const {
   // Parameters
   const float minimum_spacing = GetMinimumSpacing();
   const float desired_time_headway = GetDesiredTimeHeadway();
   const float max_acceleration = GetMaxAcceleration();
   const float comfortable_braking_acceleration =
       GetComfortableBrakingAcceleration();
-  net_distance = std::max(net_distance, 0.0);
   const double net_velocity = vel_ego - vel_other;
   const double helper_state =
       minimum_spacing + vel_ego * desired_time_headway +
       (vel_ego * net_velocity) /
           (2 * sqrt(max_acceleration * comfortable_braking_acceleration));
   BARK_EXPECT_TRUE(!std::isnan(helper_state));
+  return helper_state;
+}
+
+double BaseIDM::CalcInteractionTerm(double net_distance, double vel_ego,
+                                    double vel_other) const {
+  net_distance = std::max(net_distance, 0.0);
+  const double helper_state = CalcDesiredGap(vel_ego, vel_other);
   double interaction_term =
       (helper_state / net_distance) * (helper_state / net_distance);
   if (std::isnan(interaction_term)) {
@@ -110,12 +115,12 @@ double BaseIDM::CalcNetDistance(
     const std::shared_ptr<const Agent>& leading_agent) const {
   const auto& ego_agent = observed_world.GetEgoAgent();
   // relative velocity and longitudinal distance
-  const State ego_state = ego_agent->GetCurrentState();
+  const State& ego_state = ego_agent->GetCurrentState();
   FrenetPosition frenet_ego = ego_agent->CurrentFrenetPosition();
   const float ego_velocity = ego_state(StateDefinition::VEL_POSITION);
 
   // Leading vehicle exists in driving corridor, we calculate interaction term
-  const State leading_state = leading_agent->GetCurrentState();
+  const State& leading_state = leading_agent->GetCurrentState();
   const float other_velocity = leading_state(StateDefinition::VEL_POSITION);
 
   // we need to use the lane corridor of the ego agent to be able to compare the
@@ -182,7 +187,7 @@ IDMRelativeValues BaseIDM::CalcRelativeValues(
   // vehicles
   if (leading_vehicle.first) {
     leading_distance = CalcNetDistance(observed_world, leading_vehicle.first);
-    dynamic::State other_vehicle_state =
+    const dynamic::State& other_vehicle_state =
         leading_vehicle.first->GetCurrentState();
     leading_velocity = other_vehicle_state(StateDefinition::VEL_POSITION);
     interaction_term_active = true;
@@ -331,32 +336,29 @@ std::pair<double, double> BaseIDM::GetTotalAcc(
   return std::pair<double, double>(acc, rel_distance);
 }
 
+Action BaseIDM::GenerateTrajectoryInPlace(
+    const world::ObservedWorld& observed_world,
+    const LaneCorridorPtr& lane_corr, const IDMRelativeValues& rel_values,
+    double dt, Trajectory* traj) const {
+  std::tuple<Trajectory, Action> traj_action =
+      GenerateTrajectory(observed_world, lane_corr, rel_values, dt);
+  *traj = std::get<0>(traj_action);
+  return std::get<1>(traj_action);
+}
+
 //! IDM Model will assume const. vel. for the leading vehicle
 Trajectory BaseIDM::Plan(float min_planning_time,
                          const world::ObservedWorld& observed_world) {
-  using dynamic::StateDefinition;
-  SetBehaviorStatus(BehaviorStatus::VALID);
-
-  lane_corr_ = observed_world.GetLaneCorridor();
-  if (!lane_corr_) {
-    LOG(INFO) << "Agent " << observed_world.GetEgoAgentId()
-              << ": Behavior status has expired!" << std::endl;
-    SetBehaviorStatus(BehaviorStatus::EXPIRED);
-    return GetLastTrajectory();
-  }
-
-  IDMRelativeValues rel_values = CalcRelativeValues(observed_world, lane_corr_);
+  return PlanInLaneCorridor(min_planning_time, observed_world,
+                            observed_world.GetLaneCorridor());
+}
 
-  double dt = min_planning_time / (GetNumTrajectoryTimePoints() - 1);
-  std::tuple<Trajectory, Action> traj_action =
-      GenerateTrajectory(observed_world, lane_corr_, rel_values, dt);
-
-  // set values
-  Trajectory traj = std::get<0>(traj_action);
-  Action action = std::get<1>(traj_action);
-  SetLastTrajectory(traj);
-  SetLastAction(action);
-  return traj;
+Trajectory BaseIDM::PlanInLaneCorridor(
+    float min_planning_time, const world::ObservedWorld& observed_world,
+    const LaneCorridorPtr& lane_corr) {
+  PlanInLaneCorridorInPlace(*this, min_planning_time, observed_world,
+                            lane_corr);
+  return GetLastTrajectory();
 }
 
 }  // namespace behavior
@@ -46,8 +46,24 @@ class BaseIDM : virtual public BehaviorModel {
   virtual Trajectory Plan(float delta_time,
                           const ObservedWorld& observed_world);
 
+  //! plans along the given lane corridor of the ego agent
+  Trajectory PlanInLaneCorridor(float delta_time,
+                                const ObservedWorld& observed_world,
+                                const LaneCorridorPtr& lane_corr);
+
+  //! as PlanInLaneCorridor, but leaves the trajectory in the last
+  //! trajectory; model generates it like GenerateTrajectoryInPlace, which
+  //! lets callers that know the exact type of the IDM avoid virtual calls
+  template <class Model>
+  void PlanInLaneCorridorInPlace(const Model& model, float delta_time,
+                                 const ObservedWorld& observed_world,
+                                 const LaneCorridorPtr& lane_corr);
+
   double CalcFreeRoadTerm(const double vel_ego) const;
 
+  //! desired gap s* of the interaction term
+  double CalcDesiredGap(const double vel_ego, const double vel_other) const;
+
   double CalcInteractionTerm(const double net_distance, const double vel_ego,
                              const double vel_other) const;
   double CalcNetDistance(
@@ -62,6 +78,13 @@ class BaseIDM : virtual public BehaviorModel {
       const LaneCorridorPtr& lane_corr, const IDMRelativeValues& rel_values,
       double delta_time) const = 0;
 
+  //! writes the trajectory into traj, which is only resized if required;
+  //! the default implementation uses GenerateTrajectory
+  virtual Action GenerateTrajectoryInPlace(
+      const world::ObservedWorld& observed_world,
+      const LaneCorridorPtr& lane_corr, const IDMRelativeValues& rel_values,
+      double delta_time, Trajectory* traj) const;
+
   double CalcRawIDMAcc(const double& net_distance, const double& vel_ego,
                        const double& vel_other) const;
 
@@ -145,6 +168,29 @@ class BaseIDM : virtual public BehaviorModel {
   float param_coolness_factor_;
 };
 
+template <class Model>
+inline void BaseIDM::PlanInLaneCorridorInPlace(
+    const Model& model, float delta_time, const ObservedWorld& observed_world,
+    const LaneCorridorPtr& lane_corr) {
+  SetBehaviorStatus(BehaviorStatus::VALID);
+
+  lane_corr_ = lane_corr;
+  if (!lane_corr_) {
+    LOG(INFO) << "Agent " << observed_world.GetEgoAgentId()
+              << ": Behavior status has expired!" << std::endl;
+    SetBehaviorStatus(BehaviorStatus::EXPIRED);
+    return;
+  }
+
+  IDMRelativeValues rel_values = CalcRelativeValues(observed_world, lane_corr_);
+
+  double dt = delta_time / (GetNumTrajectoryTimePoints() - 1);
+  // the last trajectory is overwritten in place
+  Action action = model.GenerateTrajectoryInPlace(
+      observed_world, lane_corr_, rel_values, dt, MutableLastTrajectory());
+  SetLastAction(action);
+}
+
 }  // namespace behavior
 }  // namespace models
 }  // namespace bark
@@ -0,0 +1,27 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/behavior/idm/idm_agent_kernels.hpp"
+
+#include <memory>
+
+#include "bark/world/observed_world.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+using world::objects::AgentKernelRegistry;
+
+void RegisterIDMAgentKernels() {
+  AgentKernelRegistry::Register(std::make_shared<IDMClassicAgentKernel>());
+}
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
@@ -0,0 +1,85 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_BEHAVIOR_IDM_IDM_AGENT_KERNELS_HPP_
+#define BARK_MODELS_BEHAVIOR_IDM_IDM_AGENT_KERNELS_HPP_
+
+#include <utility>
+
+#include "bark/models/behavior/idm/idm_classic.hpp"
+#include "bark/models/dynamic/single_track.hpp"
+#include "bark/models/execution/interpolation/interpolate.hpp"
+#include "bark/world/objects/agent_kernel.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+//! Model of BehaviorIDMClassic::IntegrateTrajectory that calls an IDM of
+//! exactly this type; the calls are qualified, so none is virtual.
+class IDMClassicStaticModel {
+ public:
+  explicit IDMClassicStaticModel(const BehaviorIDMClassic& idm) : idm_(idm) {}
+
+  Action GenerateTrajectoryInPlace(const world::ObservedWorld& observed_world,
+                                   const LaneCorridorPtr& lane_corr,
+                                   const IDMRelativeValues& rel_values,
+                                   double delta_time, Trajectory* traj) const {
+    return BehaviorIDMClassic::IntegrateTrajectory(
+        *this, observed_world, lane_corr, rel_values, delta_time, traj);
+  }
+
+  std::pair<double, double> GetTotalAcc(
+      const world::ObservedWorld& observed_world,
+      const IDMRelativeValues& rel_values, double rel_distance,
+      double dt) const {
+    return idm_.BaseIDM::GetTotalAcc(observed_world, rel_values, rel_distance,
+                                     dt);
+  }
+
+  float GetMinVelocity() const { return idm_.BaseIDM::GetMinVelocity(); }
+  float GetMaxVelocity() const { return idm_.BaseIDM::GetMaxVelocity(); }
+  int GetNumTrajectoryTimePoints() const {
+    return idm_.GetNumTrajectoryTimePoints();
+  }
+
+ private:
+  const BehaviorIDMClassic& idm_;
+};
+
+typedef world::objects::FusedAgentKernel<
+    BehaviorIDMClassic, execution::ExecutionModelInterpolate,
+    dynamic::SingleTrackModel>
+    IDMClassicAgentKernel;
+
+//! registers the kernel of IDM agents with interpolated execution and a
+//! single track model
+void RegisterIDMAgentKernels();
+
+}  // namespace behavior
+}  // namespace models
+
+namespace world {
+namespace objects {
+
+//! plans into the last trajectory of the IDM, which the execution then reads
+template <>
+struct FusedBehaviorPlanner<models::behavior::BehaviorIDMClassic> {
+  static void Plan(models::behavior::BehaviorIDMClassic* behavior_model,
+                   float delta_time, const ObservedWorld& observed_world) {
+    behavior_model->PlanInLaneCorridorInPlace(
+        models::behavior::IDMClassicStaticModel(*behavior_model), delta_time,
+        observed_world, observed_world.GetLaneCorridor());
+  }
+};
+
+}  // namespace objects
+}  // namespace world
+}  // namespace bark
+
+#endif  // BARK_MODELS_BEHAVIOR_IDM_IDM_AGENT_KERNELS_HPP_
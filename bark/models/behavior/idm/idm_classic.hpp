@@ -9,6 +9,8 @@
 #ifndef BARK_MODELS_BEHAVIOR_IDM_IDM_CLASSIC_HPP_
 #define BARK_MODELS_BEHAVIOR_IDM_IDM_CLASSIC_HPP_
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <tuple>
 
@@ -37,12 +39,91 @@ class BehaviorIDMClassic : public BaseIDM {
       const LaneCorridorPtr& lane_corr, const IDMRelativeValues& rel_values,
       double delta_time) const;
 
+  //! evaluates the center line with a LineSCursor and does not allocate
+  //! once traj has the required size
+  Action GenerateTrajectoryInPlace(const world::ObservedWorld& observed_world,
+                                   const LaneCorridorPtr& lane_corr,
+                                   const IDMRelativeValues& rel_values,
+                                   double delta_time, Trajectory* traj) const;
+
+  //! the integration of GenerateTrajectoryInPlace with the accelerations
+  //! and velocity bounds of model; agent kernels pass a model that calls
+  //! them on the exact type, so the loop has no virtual calls
+  template <class Model>
+  static Action IntegrateTrajectory(const Model& model,
+                                    const world::ObservedWorld& observed_world,
+                                    const LaneCorridorPtr& lane_corr,
+                                    const IDMRelativeValues& rel_values,
+                                    double delta_time, Trajectory* traj);
+
   virtual std::shared_ptr<BehaviorModel> Clone() const;
 };
 
+template <class Model>
+inline Action BehaviorIDMClassic::IntegrateTrajectory(
+    const Model& model, const world::ObservedWorld& observed_world,
+    const LaneCorridorPtr& lane_corr, const IDMRelativeValues& rel_values,
+    double dt, Trajectory* traj) {
+  using dynamic::StateDefinition;
+  double t_i = 0., acc = 0.;
+  const geometry::Line& line = lane_corr->GetCenterLine();
+  traj->resize(model.GetNumTrajectoryTimePoints(),
+               static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  const dynamic::State& ego_vehicle_state = observed_world.CurrentEgoState();
+  geometry::Point2d pose = observed_world.CurrentEgoPosition();
+
+  double initial_acceleration = 0.0f;
+  if (!line.obj_.empty()) {
+    // adding state at t=0
+    traj->block<1, StateDefinition::MIN_STATE_SIZE>(0, 0) =
+        ego_vehicle_state.transpose().block<1, StateDefinition::MIN_STATE_SIZE>(
+            0, 0);
+
+    float s_start = geometry::GetNearestS(line, pose);  // checked
+    double start_time = observed_world.GetWorldTime();
+    float vel_i = ego_vehicle_state(StateDefinition::VEL_POSITION);
+    float s_i = s_start;
+    // s is non-decreasing except for strong braking at low velocities
+    geometry::LineSCursor line_cursor(line);
+
+    double rel_distance = rel_values.leading_distance;
+    // calc. traj.
+    for (int i = 1; i < model.GetNumTrajectoryTimePoints(); ++i) {
+      std::tie(acc, rel_distance) =
+          model.GetTotalAcc(observed_world, rel_values, rel_distance, dt);
+      BARK_EXPECT_TRUE(!std::isnan(acc));
+      // Set initial acceleration to maintain action value
+      if (i == 1) {
+        initial_acceleration = acc;
+      }
+      s_i += 0.5f * acc * dt * dt + vel_i * dt;
+      const float temp_velocity = vel_i + acc * dt;
+      vel_i = std::max(std::min(temp_velocity, model.GetMaxVelocity()),
+                       model.GetMinVelocity());
+      t_i = static_cast<float>(i) * dt + start_time;
+      geometry::Point2d traj_point = line_cursor.GetPointAtS(s_i);
+      float traj_angle = line_cursor.GetTangentAngleAtS(s_i);
+
+      BARK_EXPECT_TRUE(!std::isnan(boost::geometry::get<0>(traj_point)));
+      BARK_EXPECT_TRUE(!std::isnan(boost::geometry::get<1>(traj_point)));
+      BARK_EXPECT_TRUE(!std::isnan(traj_angle));
+
+      (*traj)(i, StateDefinition::TIME_POSITION) = t_i;
+      (*traj)(i, StateDefinition::X_POSITION) =
+          boost::geometry::get<0>(traj_point);
+      (*traj)(i, StateDefinition::Y_POSITION) =
+          boost::geometry::get<1>(traj_point);
+      (*traj)(i, StateDefinition::THETA_POSITION) = traj_angle;
+      (*traj)(i, StateDefinition::VEL_POSITION) = vel_i;
+    }
+  }
+
+  return Action(initial_acceleration);
+}
+
 inline std::shared_ptr<BehaviorModel> BehaviorIDMClassic::Clone() const {
   std::shared_ptr<BehaviorIDMClassic> model_ptr =
-      std::make_shared<BehaviorIDMClassic>(*this);
+      commons::MakePooled<BehaviorIDMClassic>(*this);
   return model_ptr;
 }
 
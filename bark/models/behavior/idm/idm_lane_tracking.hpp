@@ -48,7 +48,7 @@ class BehaviorIDMLaneTracking : public BaseIDM {
 
 inline std::shared_ptr<BehaviorModel> BehaviorIDMLaneTracking::Clone() const {
   std::shared_ptr<BehaviorIDMLaneTracking> model_ptr =
-      std::make_shared<BehaviorIDMLaneTracking>(*this);
+      commons::MakePooled<BehaviorIDMLaneTracking>(*this);
   return model_ptr;
 }
 
@@ -0,0 +1,253 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/behavior/idm/idm_traffic_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "bark/models/behavior/idm/idm_classic.hpp"
+#include "bark/models/behavior/idm/idm_lane_tracking.hpp"
+#include "bark/world/observed_world.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+using bark::models::dynamic::State;
+using bark::models::dynamic::StateDefinition;
+using bark::world::LaneOccupancyPtr;
+using bark::world::ObservedWorld;
+using bark::world::map::LaneCorridor;
+using bark::world::objects::AgentPtr;
+
+void IDMBatch::Clear() {
+  max_num_points_ = 0;
+  dt_.clear();
+  ego_vel_.clear();
+  leading_vel_.clear();
+  leading_distance_.clear();
+  interaction_.clear();
+  desired_gap_.clear();
+  free_road_term_.clear();
+  max_acc_.clear();
+  acc_lower_bound_.clear();
+  acc_upper_bound_.clear();
+  min_vel_.clear();
+  max_vel_.clear();
+  s_start_.clear();
+}
+
+std::size_t IDMBatch::Add(const BaseIDM& idm,
+                          const IDMRelativeValues& rel_values,
+                          float ego_velocity, float s_start, double dt,
+                          int num_points) {
+  max_num_points_ = std::max(max_num_points_, num_points);
+  dt_.push_back(dt);
+  ego_vel_.push_back(ego_velocity);
+  leading_vel_.push_back(rel_values.leading_velocity);
+  leading_distance_.push_back(rel_values.leading_distance);
+  interaction_.push_back(rel_values.has_leading_object);
+  // the ego and leading velocities are constant over the horizon
+  desired_gap_.push_back(
+      idm.CalcDesiredGap(ego_velocity, rel_values.leading_velocity));
+  free_road_term_.push_back(idm.CalcFreeRoadTerm(ego_velocity));
+  max_acc_.push_back(idm.GetMaxAcceleration());
+  acc_lower_bound_.push_back(idm.GetAccelerationLowerBound());
+  acc_upper_bound_.push_back(idm.GetAccelerationUpperBound());
+  min_vel_.push_back(idm.GetMinVelocity());
+  max_vel_.push_back(idm.GetMaxVelocity());
+  s_start_.push_back(s_start);
+  return dt_.size() - 1;
+}
+
+void IDMBatch::Integrate() {
+  const std::size_t n = GetSize();
+  s_.resize(n, std::max(max_num_points_, 1));
+  vel_.resize(n, std::max(max_num_points_, 1));
+  initial_acc_.assign(n, 0.0);
+  std::vector<double> rel_distance(leading_distance_);
+  for (std::size_t k = 0; k < n; ++k) {
+    s_(k, 0) = s_start_[k];
+    vel_(k, 0) = static_cast<float>(ego_vel_[k]);
+  }
+  // agents with fewer time points are integrated further but not used
+  for (int i = 1; i < max_num_points_; ++i) {
+    const float* s_prev = s_.col(i - 1).data();
+    const float* vel_prev = vel_.col(i - 1).data();
+    float* s = s_.col(i).data();
+    float* vel = vel_.col(i).data();
+    for (std::size_t k = 0; k < n; ++k) {
+      const double dt = dt_[k];
+      // BaseIDM::CalcIDMAcc
+      const double net_distance = std::max(rel_distance[k], 0.0);
+      double interaction_term = (desired_gap_[k] / net_distance) *
+                                (desired_gap_[k] / net_distance);
+      if (std::isnan(interaction_term)) {
+        interaction_term = std::numeric_limits<double>::infinity();
+      }
+      float idm_acc = static_cast<float>(
+          max_acc_[k] * (free_road_term_[k] - interaction_term));
+      idm_acc = std::max(std::min(idm_acc, acc_upper_bound_[k]),
+                         acc_lower_bound_[k]);
+      // BaseIDM::GetTotalAcc
+      const double acc = interaction_[k]
+                             ? static_cast<double>(idm_acc)
+                             : max_acc_[k] * free_road_term_[k];
+      const double traveled_ego = 0.5 * acc * dt * dt + ego_vel_[k] * dt;
+      const double traveled_other = leading_vel_[k] * dt;
+      if (interaction_[k]) rel_distance[k] += traveled_other - traveled_ego;
+      if (i == 1) initial_acc_[k] = acc;
+      // BehaviorIDMClassic::GenerateTrajectoryInPlace
+      s[k] = s_prev[k] + (0.5 * acc * dt * dt + vel_prev[k] * dt);
+      const float temp_velocity = vel_prev[k] + acc * dt;
+      vel[k] = std::max(std::min(temp_velocity, max_vel_[k]), min_vel_[k]);
+    }
+  }
+}
+
+bool IDMTrafficBatchPlanner::IsBatchable(
+    const BehaviorModelPtr& behavior_model) {
+  if (!behavior_model) return false;
+  const BehaviorModel& model = *behavior_model;
+  return typeid(model) == typeid(BehaviorIDMClassic) ||
+         typeid(model) == typeid(BehaviorIDMLaneTracking);
+}
+
+world::AgentBatchPlannerPtr IDMTrafficBatchPlanner::Clone() const {
+  return std::make_shared<IDMTrafficBatchPlanner>();
+}
+
+std::vector<AgentId> IDMTrafficBatchPlanner::PlanBehaviors(
+    float delta_time, const AgentMap& agents, const WorldPtr& current_world) {
+  std::vector<AgentId> planned_agents;
+  // the ego agent is switched for every planned agent
+  ObservedWorld observed_world(current_world, AgentId());
+
+  // group the agents by their lane corridor
+  std::unordered_map<const LaneCorridor*,
+                     std::pair<LaneCorridorPtr, std::unordered_set<AgentId>>>
+      lane_groups;
+  for (const auto& agent : agents) {
+    if (!IsBatchable(agent.second->GetBehaviorModel())) continue;
+    observed_world.SetEgoAgentId(agent.first);
+    LaneCorridorPtr lane_corr = observed_world.GetLaneCorridor();
+    if (!lane_corr) {
+      // expires the behavior as in the individual planning
+      agent.second->PlanBehavior(delta_time, observed_world);
+      planned_agents.push_back(agent.first);
+      continue;
+    }
+    auto& lane_group = lane_groups[lane_corr.get()];
+    lane_group.first = lane_corr;
+    lane_group.second.insert(agent.first);
+  }
+
+  // agents integrated by the batch and what is needed to write their
+  // trajectories
+  struct BatchedAgent {
+    std::shared_ptr<BaseIDM> idm;
+    LaneCorridorPtr lane_corr;
+    State ego_state;
+    double start_time;
+  };
+  std::vector<BatchedAgent> batched_agents;
+  IDMBatch batch;
+
+  // gather: the relative values need the observed world of each agent
+  auto plan_agent = [&](const AgentId& agent_id,
+                        const LaneCorridorPtr& lane_corr) {
+    const AgentPtr& agent = agents.at(agent_id);
+    auto idm = std::dynamic_pointer_cast<BaseIDM>(agent->GetBehaviorModel());
+    observed_world.SetEgoAgentId(agent_id);
+    planned_agents.push_back(agent_id);
+    const geometry::Line& line = lane_corr->GetCenterLine();
+    const BaseIDM& model = *idm;
+    if (typeid(model) != typeid(BehaviorIDMClassic) ||
+        idm->GetCoolnessFactor() > 0.0f || line.obj_.empty()) {
+      idm->PlanInLaneCorridor(delta_time, observed_world, lane_corr);
+      return;
+    }
+    // as in BaseIDM::PlanInLaneCorridor
+    idm->SetBehaviorStatus(BehaviorStatus::VALID);
+    idm->SetLaneCorridor(lane_corr);
+    const IDMRelativeValues rel_values =
+        idm->CalcRelativeValues(observed_world, lane_corr);
+    const int num_points = idm->GetNumTrajectoryTimePoints();
+    const double dt = delta_time / (num_points - 1);
+    const State& ego_state = observed_world.CurrentEgoState();
+    const float s_start = geometry::GetNearestS(
+        line, observed_world.CurrentEgoPosition());
+    batch.Add(*idm, rel_values, ego_state(StateDefinition::VEL_POSITION),
+              s_start, dt, num_points);
+    batched_agents.push_back(BatchedAgent{idm, lane_corr, ego_state,
+                                          observed_world.GetWorldTime()});
+  };
+
+  // visit each lane in the order of the longitudinal positions
+  for (auto& lane_group : lane_groups) {
+    const LaneCorridorPtr& lane_corr = lane_group.second.first;
+    std::unordered_set<AgentId>& lane_agents = lane_group.second.second;
+    LaneOccupancyPtr occupancy = current_world->GetLaneOccupancy(lane_corr);
+    for (const auto& occupant : occupancy->GetOccupants()) {
+      if (lane_agents.erase(occupant.agent_id) > 0) {
+        plan_agent(occupant.agent_id, lane_corr);
+      }
+    }
+    // agents that are not considered to be on the lane
+    for (const AgentId& agent_id : lane_agents) {
+      plan_agent(agent_id, lane_corr);
+    }
+  }
+
+  // compute
+  batch.Integrate();
+
+  // scatter: map the longitudinal positions onto the center lines
+  const Eigen::MatrixXf& s = batch.GetS();
+  const Eigen::MatrixXf& vel = batch.GetVelocity();
+  for (std::size_t k = 0; k < batched_agents.size(); ++k) {
+    const BatchedAgent& batched_agent = batched_agents[k];
+    const int num_points = batched_agent.idm->GetNumTrajectoryTimePoints();
+    const double dt = batch.GetDeltaTime(k);
+    Trajectory* traj = batched_agent.idm->MutableLastTrajectory();
+    traj->resize(num_points,
+                 static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+    traj->block<1, StateDefinition::MIN_STATE_SIZE>(0, 0) =
+        batched_agent.ego_state.transpose()
+            .block<1, StateDefinition::MIN_STATE_SIZE>(0, 0);
+    geometry::LineSCursor line_cursor(
+        batched_agent.lane_corr->GetCenterLine());
+    for (int i = 1; i < num_points; ++i) {
+      const geometry::Point2d traj_point = line_cursor.GetPointAtS(s(k, i));
+      (*traj)(i, StateDefinition::TIME_POSITION) =
+          static_cast<float>(i) * dt + batched_agent.start_time;
+      (*traj)(i, StateDefinition::X_POSITION) =
+          boost::geometry::get<0>(traj_point);
+      (*traj)(i, StateDefinition::Y_POSITION) =
+          boost::geometry::get<1>(traj_point);
+      (*traj)(i, StateDefinition::THETA_POSITION) =
+          line_cursor.GetTangentAngleAtS(s(k, i));
+      (*traj)(i, StateDefinition::VEL_POSITION) = vel(k, i);
+    }
+    batched_agent.idm->SetLastAction(
+        Action(batch.GetInitialAcceleration(k)));
+  }
+
+  num_planned_agents_ = planned_agents.size();
+  return planned_agents;
+}
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
@@ -0,0 +1,114 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_BEHAVIOR_IDM_IDM_TRAFFIC_BATCH_HPP_
+#define BARK_MODELS_BEHAVIOR_IDM_IDM_TRAFFIC_BATCH_HPP_
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "bark/models/behavior/idm/base_idm.hpp"
+#include "bark/world/world.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+using world::AgentMap;
+using world::WorldPtr;
+using world::objects::AgentId;
+
+//! Longitudinal IDM integration of many agents in structure-of-arrays
+//! layout. The relative values and parameters of all agents are gathered
+//! into contiguous arrays and all agents are advanced one time point after
+//! the other. The arithmetic is the one of BaseIDM::GetTotalAcc and
+//! BehaviorIDMClassic::GenerateTrajectoryInPlace without the constant
+//! acceleration heuristic, so the results are identical.
+class IDMBatch {
+ public:
+  IDMBatch() : max_num_points_(0) {}
+
+  void Clear();
+
+  //! adds an agent with its current velocity and its longitudinal
+  //! position on the lane center line; returns the index of the agent
+  std::size_t Add(const BaseIDM& idm, const IDMRelativeValues& rel_values,
+                  float ego_velocity, float s_start, double dt,
+                  int num_points);
+
+  void Integrate();
+
+  std::size_t GetSize() const { return dt_.size(); }
+  double GetDeltaTime(std::size_t agent) const { return dt_[agent]; }
+  double GetInitialAcceleration(std::size_t agent) const {
+    return initial_acc_[agent];
+  }
+  //! one agent per row and one time point per column; as the storage is
+  //! column-major, each time point is contiguous over the agents
+  const Eigen::MatrixXf& GetS() const { return s_; }
+  const Eigen::MatrixXf& GetVelocity() const { return vel_; }
+
+ private:
+  int max_num_points_;
+  // per agent inputs
+  std::vector<double> dt_;
+  std::vector<double> ego_vel_;
+  std::vector<double> leading_vel_;
+  std::vector<double> leading_distance_;
+  std::vector<std::uint8_t> interaction_;
+  std::vector<double> desired_gap_;
+  std::vector<double> free_road_term_;
+  std::vector<double> max_acc_;
+  std::vector<float> acc_lower_bound_;
+  std::vector<float> acc_upper_bound_;
+  std::vector<float> min_vel_;
+  std::vector<float> max_vel_;
+  std::vector<float> s_start_;
+  // results
+  std::vector<double> initial_acc_;
+  Eigen::MatrixXf s_;
+  Eigen::MatrixXf vel_;
+};
+
+//! Plans all agents using BehaviorIDMClassic or BehaviorIDMLaneTracking
+//! lane by lane. All agents are planned in one ObservedWorld whose ego
+//! agent is switched, and the agents of a lane corridor are visited in
+//! the order of their longitudinal position so that they share the lane
+//! occupancy of the corridor. BehaviorIDMClassic agents without the
+//! constant acceleration heuristic are integrated jointly by an IDMBatch;
+//! all other supported agents run their own IDM code. The results are
+//! identical to planning each agent individually. Derived IDM models are
+//! planned individually, as they may override the planning.
+class IDMTrafficBatchPlanner : public world::AgentBatchPlanner {
+ public:
+  IDMTrafficBatchPlanner() : num_planned_agents_(0) {}
+  virtual ~IDMTrafficBatchPlanner() {}
+
+  virtual std::vector<AgentId> PlanBehaviors(float delta_time,
+                                             const AgentMap& agents,
+                                             const WorldPtr& current_world);
+
+  virtual world::AgentBatchPlannerPtr Clone() const;
+
+  static bool IsBatchable(const BehaviorModelPtr& behavior_model);
+
+  //! number of agents planned in the last call
+  std::size_t GetNumPlannedAgents() const { return num_planned_agents_; }
+
+ private:
+  std::size_t num_planned_agents_;
+};
+
+typedef std::shared_ptr<IDMTrafficBatchPlanner> IDMTrafficBatchPlannerPtr;
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
+
+#endif  // BARK_MODELS_BEHAVIOR_IDM_IDM_TRAFFIC_BATCH_HPP_
@@ -6,6 +6,8 @@
 
 #include "bark/models/behavior/idm/stochastic/idm_stochastic.hpp"
 
+#include <array>
+
 namespace bark {
 namespace models {
 namespace behavior {
@@ -40,16 +42,51 @@ BehaviorIDMStochastic::BehaviorIDMStochastic(const commons::ParamsPtr& params)
           "BehaviorIDMStochastic::CoolnessFactorDistribution",
           "From what distribution is the comfortable braking sampled in each "
           "planning steo",
-          "UniformDistribution1D")) {}
+          "UniformDistribution1D")),
+      resampling_period_(params->GetInt(
+          "BehaviorIDMStochastic::ResamplingPeriod",
+          "Number of planning steps after which the parameters are resampled, "
+          "0 samples them once per episode",
+          1)),
+      use_random_streams_(params->GetBool(
+          "BehaviorIDMStochastic::UseRandomStreams",
+          "If true, samples are drawn from counter based streams per agent "
+          "and are independent of the planning order of the agents",
+          false)),
+      stream_(0),
+      num_sampling_events_(0),
+      num_planning_steps_(0) {
+  for (const auto& dist :
+       {param_dist_headway_, param_dist_spacing_, param_dist_max_acc_,
+        param_dist_desired_vel_, param_dist_comft_braking_,
+        param_dist_coolness_factor_}) {
+    BARK_EXPECT_TRUE(dist->GetSupport().size() == 1);
+  }
+}
 
 void BehaviorIDMStochastic::SampleParameters() {
-  param_desired_time_head_way_ = param_dist_headway_->Sample()[0];
-  param_minimum_spacing_ = param_dist_spacing_->Sample()[0];
-  param_max_acceleration_ = param_dist_max_acc_->Sample()[0];
-  param_desired_velocity_ = param_dist_desired_vel_->Sample()[0];
-  param_comfortable_braking_acceleration_ =
-      param_dist_comft_braking_->Sample()[0];
-  param_coolness_factor_ = param_dist_coolness_factor_->Sample()[0];
+  const std::array<commons::Distribution*, kNumSampledParameters>
+      distributions{param_dist_headway_.get(),      param_dist_spacing_.get(),
+                    param_dist_max_acc_.get(),      param_dist_desired_vel_.get(),
+                    param_dist_comft_braking_.get(),
+                    param_dist_coolness_factor_.get()};
+  std::array<commons::RandomVariableValueType, kNumSampledParameters> samples;
+  for (std::size_t i = 0; i < kNumSampledParameters; ++i) {
+    if (use_random_streams_) {
+      distributions[i]->SampleStream(stream_ * kNumSampledParameters + i,
+                                     num_sampling_events_, &samples[i], 1);
+    } else {
+      distributions[i]->SampleBatch(&samples[i], 1);
+    }
+  }
+  ++num_sampling_events_;
+
+  param_desired_time_head_way_ = samples[0];
+  param_minimum_spacing_ = samples[1];
+  param_max_acceleration_ = samples[2];
+  param_desired_velocity_ = samples[3];
+  param_comfortable_braking_acceleration_ = samples[4];
+  param_coolness_factor_ = samples[5];
 }
 
 ParameterRegions BehaviorIDMStochastic::GetParameterRegions() const {
@@ -65,7 +102,14 @@ ParameterRegions BehaviorIDMStochastic::GetParameterRegions() const {
 
 Trajectory BehaviorIDMStochastic::Plan(float delta_time,
                                        const ObservedWorld& observed_world) {
-  SampleParameters();
+  const bool resample = resampling_period_ > 0
+                            ? num_planning_steps_ % resampling_period_ == 0
+                            : num_planning_steps_ == 0;
+  if (resample) {
+    stream_ = observed_world.GetEgoAgentId();
+    SampleParameters();
+  }
+  ++num_planning_steps_;
   return BehaviorIDMClassic::Plan(delta_time, observed_world);
 }
 
@@ -27,22 +27,36 @@ class BehaviorIDMStochastic : public BehaviorIDMClassic {
 
   virtual std::shared_ptr<BehaviorModel> Clone() const;
 
+  //! draws all IDM parameters from their distributions
   void SampleParameters();
 
   ParameterRegions GetParameterRegions() const;
 
  protected:
+  //! sampled parameters in the order of SampleParameters
+  static constexpr std::size_t kNumSampledParameters = 6;
+
   bark::commons::DistributionPtr param_dist_headway_;
   bark::commons::DistributionPtr param_dist_spacing_;
   bark::commons::DistributionPtr param_dist_max_acc_;
   bark::commons::DistributionPtr param_dist_desired_vel_;
   bark::commons::DistributionPtr param_dist_comft_braking_;
   bark::commons::DistributionPtr param_dist_coolness_factor_;
+
+  //! number of planning steps after which the parameters are resampled,
+  //! zero samples them only once per episode
+  int resampling_period_;
+  //! draw from counter based streams per agent and parameter, so that the
+  //! samples do not depend on the planning order of the agents
+  bool use_random_streams_;
+  commons::RandomStream stream_;
+  commons::RandomCounter num_sampling_events_;
+  unsigned int num_planning_steps_;
 };
 
 inline std::shared_ptr<BehaviorModel> BehaviorIDMStochastic::Clone() const {
   std::shared_ptr<BehaviorIDMStochastic> model_ptr =
-      std::make_shared<BehaviorIDMStochastic>(*this);
+      commons::MakePooled<BehaviorIDMStochastic>(*this);
   return model_ptr;
 }
 
@@ -7,38 +7,35 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "bark/models/behavior/motion_primitives/continuous_actions.hpp"
-#include "bark/models/dynamic/integration.hpp"
 #include "bark/world/observed_world.hpp"
 
 namespace bark {
 namespace models {
 namespace behavior {
 
-using bark::models::dynamic::StateDefinition;
+using bark::models::dynamic::DynamicModelPtr;
+using bark::models::dynamic::SingleTrackModel;
 
 Trajectory BehaviorMPContinuousActions::Plan(
     float delta_time, const world::ObservedWorld& observed_world) {
   SetBehaviorStatus(BehaviorStatus::VALID);
-  const float dt = integration_time_delta_;
-  const int num_trajectory_points =
-      static_cast<int>(std::ceil(delta_time / dt)) + 1;
-
-  Trajectory traj(num_trajectory_points,
-                  static_cast<int>(StateDefinition::MIN_STATE_SIZE));
-  traj.row(0) = observed_world.CurrentEgoState();
-
-  float integration_time;
-  for (int i = 1; i < num_trajectory_points; ++i) {
-    if (i == num_trajectory_points - 1) {
-      // calculate the last time pt, which might not fit to dt
-      integration_time = delta_time - (i - 1) * dt;
-    } else {
-      integration_time = dt;
-    }
-    Input input = GetAction();
-    traj.row(i) =
-        dynamic::euler_int(*observed_world.GetEgoAgent()->GetDynamicModel(),
-                           traj.row(i - 1), input, integration_time);
+  const DynamicModelPtr& dynamic_model =
+      observed_world.GetEgoAgent()->GetDynamicModel();
+  const State& ego_state = observed_world.CurrentEgoState();
+  const MotionIdx motion_idx = boost::get<DiscreteAction>(active_motion_);
+
+  Trajectory traj;
+  // the library requires a model that is invariant to rigid motions;
+  // states outside of its velocity range are integrated directly
+  const SingleTrackModel* single_track =
+      use_primitive_library_
+          ? dynamic_cast<const SingleTrackModel*>(dynamic_model.get())
+          : nullptr;
+  if (!single_track ||
+      !GetPrimitiveLibrary(*single_track, delta_time)
+           ->GetTrajectory(motion_idx, ego_state, &traj)) {
+    traj = IntegratePrimitive(*dynamic_model, ego_state, GetAction(),
+                              delta_time, integration_time_delta_);
   }
 
   SetLastAction(Action(active_motion_));
@@ -46,9 +43,29 @@ Trajectory BehaviorMPContinuousActions::Plan(
   return traj;
 }
 
+MotionPrimitiveLibraryPtr BehaviorMPContinuousActions::GetPrimitiveLibrary(
+    const SingleTrackModel& dynamic_model, float delta_time) {
+  const std::array<double, 5> model = {
+      dynamic_model.GetWheelBase(), dynamic_model.GetSteeringAngleMax(),
+      dynamic_model.GetLatAccelerationMax(),
+      dynamic_model.GetLonAccelerationMax(),
+      dynamic_model.GetLonAccelerationMin()};
+  if (!primitive_library_ ||
+      primitive_library_->GetDeltaTime() != delta_time ||
+      primitive_library_model_ != model) {
+    primitive_library_ = std::make_shared<const MotionPrimitiveLibrary>(
+        dynamic_model, motion_primitives_, delta_time, integration_time_delta_,
+        library_min_velocity_, library_max_velocity_,
+        library_velocity_resolution_);
+    primitive_library_model_ = model;
+  }
+  return primitive_library_;
+}
+
 BehaviorMotionPrimitives::MotionIdx
 BehaviorMPContinuousActions::AddMotionPrimitive(const Input& dynamic_input) {
   motion_primitives_.push_back(dynamic_input);
+  primitive_library_.reset();
   return motion_primitives_.size() - 1;
 }
 
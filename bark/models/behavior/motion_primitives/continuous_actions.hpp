@@ -9,9 +9,13 @@
 #ifndef BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_CONTINUOUS_ACTIONS_HPP_
 #define BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_CONTINUOUS_ACTIONS_HPP_
 
+#include <array>
+
 #include "bark/models/behavior/behavior_model.hpp"
 #include "bark/models/behavior/motion_primitives/motion_primitives.hpp"
+#include "bark/models/behavior/motion_primitives/primitive_library.hpp"
 #include "bark/models/dynamic/dynamic_model.hpp"
+#include "bark/models/dynamic/single_track.hpp"
 
 namespace bark {
 namespace models {
@@ -21,7 +25,24 @@ namespace behavior {
 class BehaviorMPContinuousActions : public BehaviorMotionPrimitives {
  public:
   BehaviorMPContinuousActions(const commons::ParamsPtr& params)
-      : BehaviorMotionPrimitives(params), motion_primitives_() {}
+      : BehaviorMotionPrimitives(params),
+        motion_primitives_(),
+        use_primitive_library_(params->GetBool(
+            "BehaviorMPContinuousActions::UsePrimitiveLibrary",
+            "if true, the trajectories are taken from a precomputed library",
+            false)),
+        library_min_velocity_(params->GetReal(
+            "BehaviorMPContinuousActions::LibraryMinVelocity",
+            "lowest initial velocity covered by the primitive library", 0.0)),
+        library_max_velocity_(params->GetReal(
+            "BehaviorMPContinuousActions::LibraryMaxVelocity",
+            "highest initial velocity covered by the primitive library",
+            30.0)),
+        library_velocity_resolution_(params->GetReal(
+            "BehaviorMPContinuousActions::LibraryVelocityResolution",
+            "distance of the initial velocities of the primitive library; "
+            "determines the accuracy of the interpolated trajectories",
+            0.25)) {}
 
   virtual ~BehaviorMPContinuousActions() {}
 
@@ -37,16 +58,29 @@ class BehaviorMPContinuousActions : public BehaviorMotionPrimitives {
   }
   MotionIdx AddMotionPrimitive(const Input& dynamic_input);
 
+  //! library of the motion primitives for the dynamic model; it is built
+  //! on first use, rebuilt if the time step or the parameters of the model
+  //! change and shared between clones of the behavior
+  MotionPrimitiveLibraryPtr GetPrimitiveLibrary(
+      const dynamic::SingleTrackModel& dynamic_model, float delta_time);
+
   virtual std::shared_ptr<BehaviorModel> Clone() const;
 
  private:
   std::vector<Input> motion_primitives_;
+  bool use_primitive_library_;
+  float library_min_velocity_;
+  float library_max_velocity_;
+  float library_velocity_resolution_;
+  MotionPrimitiveLibraryPtr primitive_library_;
+  //! wheel base and input limits of the model the library was built for
+  std::array<double, 5> primitive_library_model_;
 };
 
 inline std::shared_ptr<BehaviorModel> BehaviorMPContinuousActions::Clone()
     const {
   std::shared_ptr<BehaviorMPContinuousActions> model_ptr =
-      std::make_shared<BehaviorMPContinuousActions>(*this);
+      commons::MakePooled<BehaviorMPContinuousActions>(*this);
   return model_ptr;
 }
 
@@ -42,13 +42,13 @@ Trajectory BehaviorMPMacroActions::Plan(
                   static_cast<int>(StateDefinition::MIN_STATE_SIZE));
 
   primitives::PrimitivePtr selected_mp;
-  AdjacentLaneCorridors adjacent_corridors = GetCorridors(observed_world);
+  const PrimitiveContext context(observed_world, GetCorridors(observed_world));
   if (check_validity_in_plan_) {
     // SetLastAction(Action(DiscreteAction(active_motion_)));
 
     // There must be at least one primitive that is always available!
     if (valid_primitives_.empty()) {
-      GetNumMotionPrimitivesByCorridors(observed_world, adjacent_corridors);
+      GetNumMotionPrimitivesByContext(observed_world, context);
       LOG_IF(ERROR, valid_primitives_.empty())
           << "No motion primitive available! At least one primitive must be "
              "available at all times!";
@@ -60,7 +60,7 @@ Trajectory BehaviorMPMacroActions::Plan(
         motion_primitives_.at(boost::get<DiscreteAction>(active_motion_));
   }
   target_corridor_ =
-      selected_mp->SelectTargetCorridor(observed_world, adjacent_corridors);
+      selected_mp->SelectTargetCorridor(observed_world, context);
 
   traj = selected_mp->Plan(delta_time, observed_world, target_corridor_);
 
@@ -77,8 +77,10 @@ BehaviorMPMacroActions::GetMotionPrimitives() const {
 BehaviorMotionPrimitives::MotionIdx
 BehaviorMPMacroActions::GetNumMotionPrimitives(
     const ObservedWorldPtr& observed_world) {
-  return GetNumMotionPrimitivesByCorridors(*observed_world,
-                                           GetCorridors(*observed_world));
+  // all preconditions are evaluated against one context of the world
+  const PrimitiveContext context(*observed_world,
+                                 GetCorridors(*observed_world));
+  return GetNumMotionPrimitivesByContext(*observed_world, context);
 }
 AdjacentLaneCorridors BehaviorMPMacroActions::GetCorridors(
     const ObservedWorld& observed_world) {
@@ -96,13 +98,12 @@ AdjacentLaneCorridors BehaviorMPMacroActions::GetCorridors(
   return adjacent_corridors;
 }
 BehaviorMotionPrimitives::MotionIdx
-BehaviorMPMacroActions::GetNumMotionPrimitivesByCorridors(
-    const ObservedWorld& observed_world,
-    const AdjacentLaneCorridors& adjacent_corridors) {
+BehaviorMPMacroActions::GetNumMotionPrimitivesByContext(
+    const ObservedWorld& observed_world, const PrimitiveContext& context) {
   MotionIdx i = 0;
   valid_primitives_.clear();
   for (auto const& p : motion_primitives_) {
-    if (p->IsPreConditionSatisfied(observed_world, adjacent_corridors)) {
+    if (p->IsPreConditionSatisfied(observed_world, context)) {
       valid_primitives_.push_back(i);
     }
     ++i;
@@ -117,7 +118,7 @@ BehaviorMPMacroActions::GetValidPrimitives(
 }
 inline std::shared_ptr<BehaviorModel> BehaviorMPMacroActions::Clone() const {
   std::shared_ptr<BehaviorMPMacroActions> model_ptr =
-      std::make_shared<BehaviorMPMacroActions>(*this);
+      commons::MakePooled<BehaviorMPMacroActions>(*this);
   return model_ptr;
 }
 
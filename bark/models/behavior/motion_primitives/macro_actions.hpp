@@ -21,6 +21,7 @@ namespace behavior {
 
 using commons::ParamsPtr;
 using primitives::AdjacentLaneCorridors;
+using primitives::PrimitiveContext;
 using world::map::LaneCorridorPtr;
 
 class BehaviorMPMacroActions : public BehaviorMotionPrimitives {
@@ -49,9 +50,8 @@ class BehaviorMPMacroActions : public BehaviorMotionPrimitives {
       const ObservedWorldPtr& observed_world);
 
  private:
-  MotionIdx GetNumMotionPrimitivesByCorridors(
-      const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors);
+  MotionIdx GetNumMotionPrimitivesByContext(const ObservedWorld& observed_world,
+                                            const PrimitiveContext& context);
   std::vector<primitives::PrimitivePtr> motion_primitives_;
   std::vector<MotionIdx> valid_primitives_;
   bool check_validity_in_plan_;
@@ -0,0 +1,144 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/behavior/motion_primitives/primitive_library.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+using dynamic::StateDefinition;
+
+Trajectory IntegratePrimitive(const DynamicModel& dynamic_model,
+                              const State& start_state, const Input& input,
+                              float delta_time, float integration_time_delta) {
+  const float dt = integration_time_delta;
+  const int num_trajectory_points =
+      static_cast<int>(std::ceil(delta_time / dt)) + 1;
+
+  if (num_trajectory_points < 2) {
+    Trajectory traj(1, start_state.rows());
+    traj.row(0) = start_state;
+    return traj;
+  }
+
+  // full steps of dt, the last time pt might not fit to dt
+  const int num_full_steps = num_trajectory_points - 2;
+  Trajectory traj = dynamic_model.IntegrateTrajectory(
+      start_state, input.transpose(), dt, num_full_steps);
+  const Trajectory last_step = dynamic_model.IntegrateTrajectory(
+      traj.row(num_full_steps).transpose(), input.transpose(),
+      delta_time - num_full_steps * dt, 1);
+  traj.conservativeResize(num_trajectory_points, Eigen::NoChange);
+  traj.row(num_trajectory_points - 1) = last_step.row(1);
+  return traj;
+}
+
+MotionPrimitiveLibrary::MotionPrimitiveLibrary(
+    const DynamicModel& dynamic_model, const std::vector<Input>& inputs,
+    float delta_time, float integration_time_delta, float min_velocity,
+    float max_velocity, float velocity_resolution)
+    : inputs_(inputs),
+      delta_time_(delta_time),
+      integration_time_delta_(integration_time_delta),
+      min_velocity_(min_velocity),
+      velocity_resolution_(velocity_resolution),
+      num_velocities_(std::max<std::size_t>(
+          2, static_cast<std::size_t>(std::ceil(
+                 (max_velocity - min_velocity) / velocity_resolution)) +
+                 1)) {
+  body_trajectories_.reserve(inputs_.size() * num_velocities_);
+  State start_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  for (const Input& input : inputs_) {
+    for (std::size_t i = 0; i < num_velocities_; ++i) {
+      start_state << 0.0, 0.0, 0.0, 0.0,
+          min_velocity_ + i * velocity_resolution_;
+      body_trajectories_.push_back(IntegratePrimitive(
+          dynamic_model, start_state, input, delta_time_,
+          integration_time_delta_));
+    }
+  }
+}
+
+bool MotionPrimitiveLibrary::GetTrajectory(std::size_t primitive_idx,
+                                           const State& start_state,
+                                           Trajectory* trajectory) const {
+  const double velocity_pos =
+      (start_state(StateDefinition::VEL_POSITION) - min_velocity_) /
+      velocity_resolution_;
+  if (primitive_idx >= inputs_.size() || velocity_pos < 0. ||
+      velocity_pos > num_velocities_ - 1) {
+    return false;
+  }
+  const std::size_t lower_idx =
+      std::min(static_cast<std::size_t>(velocity_pos), num_velocities_ - 2);
+  const float lambda = velocity_pos - lower_idx;
+  const Trajectory& lower = GetBodyTrajectory(primitive_idx, lower_idx);
+  const Trajectory& upper = GetBodyTrajectory(primitive_idx, lower_idx + 1);
+
+  const double x0 = start_state(StateDefinition::X_POSITION);
+  const double y0 = start_state(StateDefinition::Y_POSITION);
+  const double theta0 = start_state(StateDefinition::THETA_POSITION);
+  const double cos_theta0 = cos(theta0), sin_theta0 = sin(theta0);
+  trajectory->resize(lower.rows(), lower.cols());
+  trajectory->row(0) = start_state;
+  for (int i = 1; i < lower.rows(); ++i) {
+    const Eigen::Matrix<float, 1, StateDefinition::MIN_STATE_SIZE>
+        body_state = (1.f - lambda) *
+                         lower.row(i).head<StateDefinition::MIN_STATE_SIZE>() +
+                     lambda *
+                         upper.row(i).head<StateDefinition::MIN_STATE_SIZE>();
+    const double x = body_state(StateDefinition::X_POSITION);
+    const double y = body_state(StateDefinition::Y_POSITION);
+    (*trajectory)(i, StateDefinition::TIME_POSITION) =
+        start_state(StateDefinition::TIME_POSITION) +
+        lower(i, StateDefinition::TIME_POSITION);
+    (*trajectory)(i, StateDefinition::X_POSITION) =
+        x0 + cos_theta0 * x - sin_theta0 * y;
+    (*trajectory)(i, StateDefinition::Y_POSITION) =
+        y0 + sin_theta0 * x + cos_theta0 * y;
+    (*trajectory)(i, StateDefinition::THETA_POSITION) =
+        theta0 + body_state(StateDefinition::THETA_POSITION);
+    (*trajectory)(i, StateDefinition::VEL_POSITION) =
+        body_state(StateDefinition::VEL_POSITION);
+  }
+  return true;
+}
+
+double MotionPrimitiveLibrary::CalculateMaxPositionError(
+    const DynamicModel& dynamic_model) const {
+  double max_error = 0.;
+  State start_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  Trajectory trajectory;
+  for (std::size_t p = 0; p < inputs_.size(); ++p) {
+    for (std::size_t i = 0; i + 1 < num_velocities_; ++i) {
+      start_state << 0.0, 0.0, 0.0, 0.0,
+          min_velocity_ + (i + 0.5) * velocity_resolution_;
+      Trajectory expected =
+          IntegratePrimitive(dynamic_model, start_state, inputs_[p],
+                             delta_time_, integration_time_delta_);
+      GetTrajectory(p, start_state, &trajectory);
+      for (int r = 0; r < expected.rows(); ++r) {
+        max_error = std::max<double>(
+            max_error,
+            std::hypot(trajectory(r, StateDefinition::X_POSITION) -
+                           expected(r, StateDefinition::X_POSITION),
+                       trajectory(r, StateDefinition::Y_POSITION) -
+                           expected(r, StateDefinition::Y_POSITION)));
+      }
+    }
+  }
+  return max_error;
+}
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
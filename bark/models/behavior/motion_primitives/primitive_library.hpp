@@ -0,0 +1,80 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVE_LIBRARY_HPP_
+#define BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVE_LIBRARY_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "bark/models/dynamic/dynamic_model.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+using dynamic::DynamicModel;
+using dynamic::Input;
+using dynamic::State;
+using dynamic::Trajectory;
+
+//! Euler integration of a constant input over delta_time, the last step
+//! being shortened so that the trajectory ends at delta_time
+Trajectory IntegratePrimitive(const DynamicModel& dynamic_model,
+                              const State& start_state, const Input& input,
+                              float delta_time, float integration_time_delta);
+
+//! Precomputed trajectories of motion primitives for a grid of initial
+//! velocities. The trajectories are integrated once in the body frame and
+//! are transformed to the start pose when queried; the velocity is
+//! linearly interpolated between the grid points. Requires a dynamic
+//! model that is invariant to translations and rotations of the
+//! x-y-plane, such as the SingleTrackModel.
+class MotionPrimitiveLibrary {
+ public:
+  MotionPrimitiveLibrary(const DynamicModel& dynamic_model,
+                         const std::vector<Input>& inputs, float delta_time,
+                         float integration_time_delta, float min_velocity,
+                         float max_velocity, float velocity_resolution);
+
+  //! trajectory of the primitive starting at the state; false if the
+  //! velocity of the state is not covered by the library
+  bool GetTrajectory(std::size_t primitive_idx, const State& start_state,
+                     Trajectory* trajectory) const;
+
+  //! largest position error compared to the direct integration, evaluated
+  //! in the middle between the velocity grid points
+  double CalculateMaxPositionError(const DynamicModel& dynamic_model) const;
+
+  float GetDeltaTime() const { return delta_time_; }
+  std::size_t GetNumPrimitives() const { return inputs_.size(); }
+  std::size_t GetNumVelocities() const { return num_velocities_; }
+
+ private:
+  const Trajectory& GetBodyTrajectory(std::size_t primitive_idx,
+                                      std::size_t velocity_idx) const {
+    return body_trajectories_[primitive_idx * num_velocities_ + velocity_idx];
+  }
+
+  std::vector<Input> inputs_;
+  float delta_time_;
+  float integration_time_delta_;
+  float min_velocity_;
+  float velocity_resolution_;
+  std::size_t num_velocities_;
+  //! trajectories starting in the origin with a heading of zero
+  std::vector<Trajectory> body_trajectories_;
+};
+
+typedef std::shared_ptr<const MotionPrimitiveLibrary> MotionPrimitiveLibraryPtr;
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
+
+#endif  // BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVE_LIBRARY_HPP_
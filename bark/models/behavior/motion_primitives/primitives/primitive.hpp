@@ -10,8 +10,10 @@
 #define BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_HPP_
 
 #include <memory>
+
 #include "bark/commons/base_type.hpp"
 #include "bark/models/behavior/idm/idm_lane_tracking.hpp"
+#include "bark/models/behavior/motion_primitives/primitives/primitive_context.hpp"
 #include "bark/models/dynamic/integration.hpp"
 #include "bark/models/dynamic/single_track.hpp"
 #include "bark/world/map/road_corridor.hpp"
@@ -31,12 +33,6 @@ using world::ObservedWorld;
 using world::ObservedWorldPtr;
 using world::map::LaneCorridorPtr;
 
-struct AdjacentLaneCorridors {
-  LaneCorridorPtr current;
-  LaneCorridorPtr left;
-  LaneCorridorPtr right;
-};
-
 /**
  * @brief Macro action motion primitive base class
  */
@@ -54,23 +50,23 @@ class Primitive : public bark::commons::BaseType {
 
   /**
    * @brief Precondition for the motion primitve to be available
-   * @param adjacent_corridors Current target corridor and left/right corridors
+   * @param context Current target corridor, left/right corridors and cached
+   * ego related quantities
    * @return True if primitive is available
    */
-  virtual bool IsPreConditionSatisfied(
-      const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors) = 0;
+  virtual bool IsPreConditionSatisfied(const ObservedWorld& observed_world,
+                                       const PrimitiveContext& context) = 0;
   virtual Trajectory Plan(float min_planning_time,
                           const ObservedWorld& observed_world,
                           const LaneCorridorPtr& target_corridor) = 0;
   /**
    * @brief Select the new target corridor
-   * @param adjacent_corridors Current target corridor and left/right corridors
+   * @param context Current target corridor, left/right corridors and cached
+   * ego related quantities
    * @return The new target corridor
    */
   virtual LaneCorridorPtr SelectTargetCorridor(
-      const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors) = 0;
+      const ObservedWorld& observed_world, const PrimitiveContext& context) = 0;
 
   Action GetLastAction() const { return last_action_; };
   void SetLastAction(const Action action) { last_action_ = action; };
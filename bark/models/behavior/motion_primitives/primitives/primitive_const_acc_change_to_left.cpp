@@ -16,15 +16,15 @@ bark::models::behavior::primitives::PrimitiveConstAccChangeToLeft::
 bark::world::LaneCorridorPtr bark::models::behavior::primitives::
     PrimitiveConstAccChangeToLeft::SelectTargetCorridor(
         const bark::world::ObservedWorld& observed_world,
-        const bark::models::behavior::primitives::AdjacentLaneCorridors&
-            adjacent_corridors) {
+        const bark::models::behavior::primitives::PrimitiveContext& context) {
+  const AdjacentLaneCorridors& adjacent_corridors =
+      context.GetAdjacentCorridors();
   if (adjacent_corridors.left) {
     return adjacent_corridors.left;
   }
   // LOG(WARNING) << "Called change to left, but left corridor not found!";
   if (!adjacent_corridors.current) {
-    return observed_world.GetRoadCorridor()->GetCurrentLaneCorridor(
-        observed_world.CurrentEgoPosition());
+    return context.GetCurrentLaneCorridor();
   } else {
     return adjacent_corridors.current;
   }
@@ -32,17 +32,11 @@ bark::world::LaneCorridorPtr bark::models::behavior::primitives::
 bool bark::models::behavior::primitives::PrimitiveConstAccChangeToLeft::
     IsPreConditionSatisfied(
         const bark::world::ObservedWorld& observed_world,
-        const bark::models::behavior::primitives::AdjacentLaneCorridors&
-            adjacent_corridors) {
+        const bark::models::behavior::primitives::PrimitiveContext& context) {
   bool satisfied = false;
-  if (adjacent_corridors.left) {
-    const Point2d ego_pos = observed_world.CurrentEgoPosition();
-    //! agent may not have reached target lane yet, so we match point on target
-    //! lane
-    const Point2d point_on_target_line =
-        GetNearestPoint(adjacent_corridors.left->GetCenterLine(), ego_pos);
-    float remaining_length =
-        adjacent_corridors.left->LengthUntilEnd(point_on_target_line);
+  const LaneCorridorPtr& target_corridor = context.GetAdjacentCorridors().left;
+  if (target_corridor) {
+    float remaining_length = context.GetLengthUntilEnd(target_corridor);
     satisfied = remaining_length >= min_length_;
   }
   return satisfied;
@@ -16,15 +16,15 @@ bark::models::behavior::primitives::PrimitiveConstAccChangeToRight::
 bark::world::LaneCorridorPtr bark::models::behavior::primitives::
     PrimitiveConstAccChangeToRight::SelectTargetCorridor(
         const bark::world::ObservedWorld& observed_world,
-        const bark::models::behavior::primitives::AdjacentLaneCorridors&
-            adjacent_corridors) {
+        const bark::models::behavior::primitives::PrimitiveContext& context) {
+  const AdjacentLaneCorridors& adjacent_corridors =
+      context.GetAdjacentCorridors();
   if (adjacent_corridors.right) {
     return adjacent_corridors.right;
   }
   // LOG(WARNING) << "Called change to right, but right corridor not found!";
   if (!adjacent_corridors.current) {
-    return observed_world.GetRoadCorridor()->GetCurrentLaneCorridor(
-        observed_world.CurrentEgoPosition());
+    return context.GetCurrentLaneCorridor();
   } else {
     return adjacent_corridors.current;
   }
@@ -32,17 +32,11 @@ bark::world::LaneCorridorPtr bark::models::behavior::primitives::
 bool bark::models::behavior::primitives::PrimitiveConstAccChangeToRight::
     IsPreConditionSatisfied(
         const bark::world::ObservedWorld& observed_world,
-        const bark::models::behavior::primitives::AdjacentLaneCorridors&
-            adjacent_corridors) {
+        const bark::models::behavior::primitives::PrimitiveContext& context) {
   bool satisfied = false;
-  if (adjacent_corridors.right) {
-    const Point2d ego_pos = observed_world.CurrentEgoPosition();
-    //! agent may not have reached target lane yet, so we match point on target
-    //! lane
-    const Point2d point_on_target_line =
-        GetNearestPoint(adjacent_corridors.right->GetCenterLine(), ego_pos);
-    float remaining_length =
-        adjacent_corridors.right->LengthUntilEnd(point_on_target_line);
+  const LaneCorridorPtr& target_corridor = context.GetAdjacentCorridors().right;
+  if (target_corridor) {
+    float remaining_length = context.GetLengthUntilEnd(target_corridor);
     satisfied = remaining_length >= min_length_;
   }
   return satisfied;
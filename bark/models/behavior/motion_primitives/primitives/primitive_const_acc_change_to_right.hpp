@@ -25,11 +25,10 @@ class PrimitiveConstAccChangeToRight : public PrimitiveConstAccStayLane {
 
   LaneCorridorPtr SelectTargetCorridor(
       const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors) override;
+      const PrimitiveContext& context) override;
 
-  bool IsPreConditionSatisfied(
-      const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors) override;
+  bool IsPreConditionSatisfied(const ObservedWorld& observed_world,
+                               const PrimitiveContext& context) override;
 
  private:
   float min_length_;
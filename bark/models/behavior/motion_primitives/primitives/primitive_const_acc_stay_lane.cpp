@@ -27,16 +27,12 @@ bark::models::behavior::primitives::PrimitiveConstAccStayLane::
 bool bark::models::behavior::primitives::PrimitiveConstAccStayLane::
     IsPreConditionSatisfied(
         const bark::world::ObservedWorld& observed_world,
-        const bark::models::behavior::primitives::AdjacentLaneCorridors&
-            adjacent_corridors) {
-  auto single_track = std::dynamic_pointer_cast<dynamic::SingleTrackModel>(
-      observed_world.GetEgoAgent()->GetDynamicModel());
-  if (!single_track) {
+        const bark::models::behavior::primitives::PrimitiveContext& context) {
+  if (!context.GetSingleTrackModel()) {
     LOG(FATAL) << "Only single track model supported! Aborting!";
   }
-  auto ego_state = observed_world.CurrentEgoState();
-  return acceleration_ >= single_track->GetMinAcceleration(ego_state) &&
-         acceleration_ <= single_track->GetMaxAcceleration(ego_state);
+  return acceleration_ >= context.GetMinAcceleration() &&
+         acceleration_ <= context.GetMaxAcceleration();
 }
 
 bark::models::dynamic::Trajectory
@@ -70,10 +66,9 @@ bark::models::behavior::primitives::PrimitiveConstAccStayLane::Plan(
 bark::world::LaneCorridorPtr bark::models::behavior::primitives::
     PrimitiveConstAccStayLane::SelectTargetCorridor(
         const bark::world::ObservedWorld& observed_world,
-        const bark::models::behavior::primitives::AdjacentLaneCorridors&
-            adjacent_corridors) {
-  BARK_EXPECT_TRUE(adjacent_corridors.current);
-  return adjacent_corridors.current;
+        const bark::models::behavior::primitives::PrimitiveContext& context) {
+  BARK_EXPECT_TRUE(context.GetAdjacentCorridors().current);
+  return context.GetAdjacentCorridors().current;
 }
 
 std::pair<double, double>
@@ -23,16 +23,15 @@ class PrimitiveConstAccStayLane : public Primitive,
   PrimitiveConstAccStayLane(const commons::ParamsPtr& params,
                             float acceleration);
   explicit PrimitiveConstAccStayLane(const commons::ParamsPtr& params);
-  bool IsPreConditionSatisfied(
-      const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors) override;
+  bool IsPreConditionSatisfied(const ObservedWorld& observed_world,
+                               const PrimitiveContext& context) override;
 
   Trajectory Plan(float min_planning_time, const ObservedWorld& observed_world,
                   const LaneCorridorPtr& target_corridor);
 
   LaneCorridorPtr SelectTargetCorridor(
       const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors) override;
+      const PrimitiveContext& context) override;
 
  protected:
   std::pair<double, double> GetTotalAcc(const ObservedWorld& observed_world,
@@ -0,0 +1,60 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/behavior/motion_primitives/primitives/primitive_context.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+namespace primitives {
+
+PrimitiveContext::PrimitiveContext(
+    const ObservedWorld& observed_world,
+    const AdjacentLaneCorridors& adjacent_corridors)
+    : road_corridor_(observed_world.GetRoadCorridor()),
+      adjacent_corridors_(adjacent_corridors),
+      ego_position_(observed_world.CurrentEgoPosition()),
+      single_track_(std::dynamic_pointer_cast<dynamic::SingleTrackModel>(
+          observed_world.GetEgoAgent()->GetDynamicModel())),
+      min_acceleration_(0.0f),
+      max_acceleration_(0.0f),
+      current_lane_corridor_valid_(false) {
+  if (single_track_) {
+    const auto& ego_state = observed_world.CurrentEgoState();
+    min_acceleration_ = single_track_->GetMinAcceleration(ego_state);
+    max_acceleration_ = single_track_->GetMaxAcceleration(ego_state);
+  }
+}
+
+const LaneCorridorPtr& PrimitiveContext::GetCurrentLaneCorridor() const {
+  if (!current_lane_corridor_valid_) {
+    current_lane_corridor_ =
+        road_corridor_->GetCurrentLaneCorridor(ego_position_);
+    current_lane_corridor_valid_ = true;
+  }
+  return current_lane_corridor_;
+}
+
+float PrimitiveContext::GetLengthUntilEnd(
+    const LaneCorridorPtr& lane_corridor) const {
+  auto length_it = lengths_until_end_.find(lane_corridor.get());
+  if (length_it == lengths_until_end_.end()) {
+    const Point2d point_on_line =
+        GetNearestPoint(lane_corridor->GetCenterLine(), ego_position_);
+    length_it = lengths_until_end_
+                    .emplace(lane_corridor.get(),
+                             lane_corridor->LengthUntilEnd(point_on_line))
+                    .first;
+  }
+  return length_it->second;
+}
+
+}  // namespace primitives
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
@@ -0,0 +1,89 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_CONTEXT_HPP_
+#define BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_CONTEXT_HPP_
+
+#include <map>
+#include <memory>
+
+#include "bark/models/dynamic/single_track.hpp"
+#include "bark/world/map/lane_corridor.hpp"
+#include "bark/world/map/road_corridor.hpp"
+#include "bark/world/observed_world.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+namespace primitives {
+
+using bark::geometry::Point2d;
+using world::ObservedWorld;
+using world::map::LaneCorridor;
+using world::map::LaneCorridorPtr;
+using world::map::RoadCorridorPtr;
+
+struct AdjacentLaneCorridors {
+  LaneCorridorPtr current;
+  LaneCorridorPtr left;
+  LaneCorridorPtr right;
+};
+
+/**
+ * @brief Ego related quantities of one observed world that are shared by
+ * the preconditions and the target corridor selection of all primitives.
+ * Map queries are evaluated at most once per lane corridor. The context
+ * does not refer to the observed world and may outlive it.
+ */
+class PrimitiveContext {
+ public:
+  PrimitiveContext(const ObservedWorld& observed_world,
+                   const AdjacentLaneCorridors& adjacent_corridors);
+
+  const AdjacentLaneCorridors& GetAdjacentCorridors() const {
+    return adjacent_corridors_;
+  }
+  const Point2d& GetEgoPosition() const { return ego_position_; }
+
+  //! single track model of the ego agent; nullptr for other dynamic models
+  const std::shared_ptr<dynamic::SingleTrackModel>& GetSingleTrackModel()
+      const {
+    return single_track_;
+  }
+  float GetMinAcceleration() const { return min_acceleration_; }
+  float GetMaxAcceleration() const { return max_acceleration_; }
+
+  //! lane corridor of the road corridor that contains the ego position
+  const LaneCorridorPtr& GetCurrentLaneCorridor() const;
+
+  /**
+   * @brief Distance until the end of the lane corridor
+   * @details The ego position is matched to the center line, as the agent
+   * may not have reached the lane corridor yet
+   */
+  float GetLengthUntilEnd(const LaneCorridorPtr& lane_corridor) const;
+
+ private:
+  RoadCorridorPtr road_corridor_;
+  AdjacentLaneCorridors adjacent_corridors_;
+  Point2d ego_position_;
+  std::shared_ptr<dynamic::SingleTrackModel> single_track_;
+  float min_acceleration_;
+  float max_acceleration_;
+
+  mutable bool current_lane_corridor_valid_;
+  mutable LaneCorridorPtr current_lane_corridor_;
+  mutable std::map<const LaneCorridor*, float> lengths_until_end_;
+};
+
+}  // namespace primitives
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
+
+#endif  // BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_CONTEXT_HPP_
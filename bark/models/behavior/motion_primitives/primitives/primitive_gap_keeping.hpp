@@ -27,9 +27,8 @@ class PrimitiveGapKeeping : public Primitive, public BehaviorIDMLaneTracking {
         BehaviorIDMLaneTracking(params) {
     Primitive::SetLastAction(Continuous1DAction(0.0f));
   }
-  bool IsPreConditionSatisfied(
-      const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors) override {
+  bool IsPreConditionSatisfied(const ObservedWorld& observed_world,
+                               const PrimitiveContext& context) override {
     return true;
   }
   Trajectory Plan(float min_planning_time, const ObservedWorld& observed_world,
@@ -46,9 +45,8 @@ class PrimitiveGapKeeping : public Primitive, public BehaviorIDMLaneTracking {
 
   LaneCorridorPtr SelectTargetCorridor(
       const ObservedWorld& observed_world,
-      const AdjacentLaneCorridors& adjacent_corridors) override {
-    return observed_world.GetRoadCorridor()->GetCurrentLaneCorridor(
-        observed_world.CurrentEgoPosition());
+      const PrimitiveContext& context) override {
+    return context.GetCurrentLaneCorridor();
   }
 };
 
@@ -14,10 +14,12 @@
 #include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "bark/commons/params/setter_params.hpp"
 #include "bark/commons/transformation/frenet.hpp"
 #include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
+#include "bark/models/behavior/constant_acceleration/constant_acceleration_prediction.hpp"
 #include "bark/models/dynamic/integration.hpp"
 #include "bark/models/dynamic/single_track.hpp"
 #include "bark/world/observed_world.hpp"
@@ -28,8 +30,10 @@ namespace behavior {
 
 using bark::commons::SetterParams;
 using bark::commons::transformation::FrenetPosition;
+using bark::geometry::Collide;
 using bark::geometry::Norm0To2PI;
 using bark::geometry::Point2d;
+using bark::geometry::Polygon;
 using bark::geometry::SignedAngleDiff;
 using bark::models::behavior::BehaviorConstantAcceleration;
 using bark::models::dynamic::DynamicModelPtr;
@@ -40,11 +44,9 @@ using bark::models::dynamic::StateDefinition::VEL_POSITION;
 using bark::world::AgentId;
 using bark::world::AgentMap;
 using bark::world::ObservedWorld;
-using bark::world::ObservedWorldPtr;
 using bark::world::WorldPtr;
 using bark::world::objects::Agent;
 using bark::world::objects::AgentPtr;
-using bark::world::prediction::PredictionSettings;
 
 /**
  * @brief Returns the first intersecting agent for the ego LaneCorr.
@@ -61,38 +63,49 @@ std::pair<AgentId, bool> BehaviorIntersectionRuleBased::GetIntersectingAgent(
   for (const auto& agent : intersecting_agents) {
     if (!observed_world.GetEgoAgent() || !agent.second)
       return std::pair<AgentId, bool>(intersecting_agent_id, false);
-    const auto& road_corr = agent.second->GetRoadCorridor();
-    const auto& agent_pos = agent.second->GetCurrentPosition();
-    const auto& ego_state = observed_world.CurrentEgoState();
-    const auto& ego_pos = observed_world.CurrentEgoPosition();
-    const auto& agent_state = agent.second->GetCurrentState();
-    const auto& lane_corr = road_corr->GetCurrentLaneCorridor(agent_pos);
-
-    if (lane_corr != observed_world.GetLaneCorridor() &&
-        agent.second != observed_world.GetEgoAgent() &&
-        observed_world.GetLaneCorridor() != nullptr && lane_corr != nullptr) {
-      // only if s of intersecting agent is larger
-      double s_ego = std::get<1>(GetNearestPointAndS(
-          observed_world.GetLaneCorridor()->GetCenterLine(), ego_pos));
-      double s_other = std::get<1>(GetNearestPointAndS(
-          observed_world.GetLaneCorridor()->GetCenterLine(), agent_pos));
-      double ego_angle = Norm0To2PI(ego_state[THETA_POSITION]);
-      double other_angle = Norm0To2PI(agent_state[THETA_POSITION]);
-      if (fabs(ego_angle - other_angle) > angle_diff_for_intersection_ &&
-          s_other > s_ego && s_other - s_ego < braking_distance_) {
-        intersecting_agent_id = agent.second->GetAgentId();
-        is_intersecting = true;
-        break;
-      }
+    if (agent.second != observed_world.GetEgoAgent() &&
+        IsIntersectingAgent(observed_world.CurrentEgoState(),
+                            observed_world.GetLaneCorridor(), agent.second,
+                            agent.second->GetCurrentState())) {
+      intersecting_agent_id = agent.second->GetAgentId();
+      is_intersecting = true;
+      break;
     }
   }
   return std::pair<AgentId, bool>(intersecting_agent_id, is_intersecting);
 }
 
+bool BehaviorIntersectionRuleBased::IsIntersectingAgent(
+    const State& ego_state, const LaneCorridorPtr& ego_lane_corr,
+    const AgentPtr& agent, const State& agent_state) const {
+  const auto& road_corr = agent->GetRoadCorridor();
+  if (!road_corr || !ego_lane_corr) return false;
+  Point2d agent_pos(agent_state(StateDefinition::X_POSITION),
+                    agent_state(StateDefinition::Y_POSITION));
+  Point2d ego_pos(ego_state(StateDefinition::X_POSITION),
+                  ego_state(StateDefinition::Y_POSITION));
+  const auto& lane_corr = road_corr->GetCurrentLaneCorridor(agent_pos);
+  if (lane_corr == ego_lane_corr || lane_corr == nullptr) return false;
+
+  // only if s of intersecting agent is larger
+  double s_ego = std::get<1>(
+      GetNearestPointAndS(ego_lane_corr->GetCenterLine(), ego_pos));
+  double s_other = std::get<1>(
+      GetNearestPointAndS(ego_lane_corr->GetCenterLine(), agent_pos));
+  double ego_angle = Norm0To2PI(ego_state[THETA_POSITION]);
+  double other_angle = Norm0To2PI(agent_state[THETA_POSITION]);
+  return fabs(ego_angle - other_angle) > angle_diff_for_intersection_ &&
+         s_other > s_ego && s_other - s_ego < braking_distance_;
+}
+
 /**
  * @brief Checks for intersecting agents on the ego
  *        LaneCorridor
  *
+ * All agents are predicted with a constant acceleration along their
+ * LaneCorridors. Only agents whose swept footprint can reach the ego
+ * LaneCorridor are checked at the prediction times.
+ *
  * @param observed_world ObservedWorld
  * @param t_inc Forward delta time for the prediction
  * @return std::tuple<double, AgentPtr> time to interception and agent
@@ -100,34 +113,57 @@ std::pair<AgentId, bool> BehaviorIntersectionRuleBased::GetIntersectingAgent(
 std::tuple<double, AgentPtr>
 BehaviorIntersectionRuleBased::CheckIntersectingVehicles(
     const ObservedWorld& observed_world, double t_inc) {
+  namespace bg = boost::geometry;
   double intersection_time = 0.;
   LaneCorridorPtr lane_corr = GetLaneCorridor();
   AgentPtr lane_corr_intersecting_agent;
   // prediction
   auto params = std::make_shared<SetterParams>();
-  BehaviorModelPtr prediction_model(new BehaviorConstantAcceleration(params));
-  PredictionSettings prediction_settings(prediction_model, prediction_model);
-  ObservedWorldPtr tmp_observed_world =
-      std::dynamic_pointer_cast<ObservedWorld>(observed_world.Clone());
-  tmp_observed_world->SetupPrediction(prediction_settings);
+  BehaviorConstantAcceleration prediction_model(params);
+  ConstantAccelerationPrediction prediction(observed_world, prediction_model);
+
+  // valid agents that can intersect the ego LaneCorridor within the
+  // horizon; World::GetAgentsIntersectingPolygon only returns valid agents
+  const Polygon& lane_corr_polygon = lane_corr->GetMergedPolygon();
+  BoundingBox lane_corr_box;
+  bg::envelope(lane_corr_polygon.obj_, lane_corr_box);
+  const AgentId ego_agent_id = observed_world.GetEgoAgentId();
+  std::vector<AgentId> candidate_ids;
+  for (const auto& agent : prediction.GetAgents()) {
+    BoundingBox swept_box;
+    if (agent.first != ego_agent_id &&
+        agent.second->GetBehaviorStatus() == BehaviorStatus::VALID &&
+        prediction.GetSweptBoundingBox(agent.first, prediction_time_horizon_,
+                                       &swept_box) &&
+        bg::intersects(swept_box, lane_corr_box)) {
+      candidate_ids.push_back(agent.first);
+    }
+  }
+  if (candidate_ids.empty()) {
+    return std::tuple<double, AgentPtr>(intersection_time,
+                                        lane_corr_intersecting_agent);
+  }
 
+  const auto& ego_road_corr = observed_world.GetRoadCorridor();
+  State ego_state, agent_state;
   // predict for n seconds
   for (double t = 0.; t < prediction_time_horizon_; t += prediction_t_inc_) {
-    ObservedWorldPtr predicted_world = tmp_observed_world->Predict(t);
-    // all agents intersecting at time t
-    AgentMap intersecting_agents =
-        predicted_world->GetAgentsIntersectingPolygon(
-            lane_corr->GetMergedPolygon());
-    // first agent intersecting
-    std::pair<AgentId, bool> intersecting_agent_id =
-        GetIntersectingAgent(intersecting_agents, *predicted_world);
-    if (intersecting_agent_id.second) {
-      lane_corr_intersecting_agent =
-          observed_world.GetAgent(intersecting_agent_id.first);
-      // if there is an agent that intersects at time t
-      if (lane_corr_intersecting_agent) {
+    if (!prediction.PredictState(ego_agent_id, t, &ego_state)) {
+      ego_state = observed_world.CurrentEgoState();
+    }
+    LaneCorridorPtr ego_lane_corr = ego_road_corr->GetNearestLaneCorridor(
+        Point2d(ego_state(StateDefinition::X_POSITION),
+                ego_state(StateDefinition::Y_POSITION)));
+    // first agent intersecting at time t
+    for (const AgentId& agent_id : candidate_ids) {
+      if (!prediction.PredictState(agent_id, t, &agent_state)) continue;
+      const AgentPtr& agent = prediction.GetAgents().at(agent_id);
+      if (Collide(agent->GetPolygonFromState(agent_state), lane_corr_polygon) &&
+          IsIntersectingAgent(ego_state, ego_lane_corr, agent, agent_state)) {
+        lane_corr_intersecting_agent = observed_world.GetAgent(agent_id);
         intersection_time = t;
-        break;
+        return std::tuple<double, AgentPtr>(intersection_time,
+                                            lane_corr_intersecting_agent);
       }
     }
   }
@@ -65,6 +65,15 @@ class BehaviorIntersectionRuleBased : public BehaviorLaneChangeRuleBased {
       const AgentMap& intersecting_agents,
       const ObservedWorld& observed_world) const;
 
+  /**
+   * @brief Whether the other agent crosses the ego LaneCorridor in front
+   *        of the ego vehicle
+   */
+  bool IsIntersectingAgent(const dynamic::State& ego_state,
+                           const LaneCorridorPtr& ego_lane_corr,
+                           const AgentPtr& agent,
+                           const dynamic::State& agent_state) const;
+
   virtual ~BehaviorIntersectionRuleBased() {}
 
   virtual std::shared_ptr<BehaviorModel> Clone() const;
@@ -79,7 +88,7 @@ class BehaviorIntersectionRuleBased : public BehaviorLaneChangeRuleBased {
 inline std::shared_ptr<BehaviorModel> BehaviorIntersectionRuleBased::Clone()
     const {
   std::shared_ptr<BehaviorIntersectionRuleBased> model_ptr =
-      std::make_shared<BehaviorIntersectionRuleBased>(*this);
+      commons::MakePooled<BehaviorIntersectionRuleBased>(*this);
   return model_ptr;
 }
 
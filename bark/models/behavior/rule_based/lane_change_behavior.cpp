@@ -49,8 +49,15 @@ std::pair<AgentInformation, AgentInformation>
 BehaviorLaneChangeRuleBased::FrontRearAgents(
     const ObservedWorld& observed_world,
     const LaneCorridorPtr& lane_corr) const {
+  return FrontRearAgents(observed_world,
+                         observed_world.GetAgentFrontRear(lane_corr));
+}
+
+std::pair<AgentInformation, AgentInformation>
+BehaviorLaneChangeRuleBased::FrontRearAgents(
+    const ObservedWorld& observed_world,
+    const world::FrontRearAgents& front_rear) const {
   AgentInformation front_info, rear_info;
-  const auto& front_rear = observed_world.GetAgentFrontRear(lane_corr);
   const auto& ego_agent = observed_world.GetEgoAgent();
   if (front_rear.front.first) {
     // front info
@@ -79,11 +86,12 @@ LaneCorridorInformation
 BehaviorLaneChangeRuleBased::FillLaneCorridorInformation(
     const ObservedWorld& observed_world,
     const LaneCorridorPtr& lane_corr) const {
-  const auto& ego_pos = observed_world.CurrentEgoPosition();  // x, y
-
+  // the projections and agent queries are shared with the other agents
+  // planning in this step
+  world::LaneScan lane_scan = observed_world.GetLaneScan(lane_corr);
   std::pair<AgentInformation, AgentInformation> agent_lane_info =
-      FrontRearAgents(observed_world, lane_corr);
-  double remaining_distance = lane_corr->LengthUntilEnd(ego_pos);
+      FrontRearAgents(observed_world, lane_scan.front_rear);
+  double remaining_distance = lane_scan.remaining_distance;
   // include distance to the end of the LaneCorridor
   agent_lane_info.first.rel_distance =
       std::min(remaining_distance, agent_lane_info.first.rel_distance);
@@ -111,6 +111,10 @@ class BehaviorLaneChangeRuleBased : public BehaviorIDMLaneTracking {
       const ObservedWorld& observed_world,
       const LaneCorridorPtr& lane_corr) const;
 
+  std::pair<AgentInformation, AgentInformation> FrontRearAgents(
+      const ObservedWorld& observed_world,
+      const world::FrontRearAgents& front_rear) const;
+
   LaneCorridorInformation FillLaneCorridorInformation(
       const ObservedWorld& observed_world,
       const LaneCorridorPtr& lane_corr) const;
@@ -180,7 +184,7 @@ class BehaviorLaneChangeRuleBased : public BehaviorIDMLaneTracking {
 inline std::shared_ptr<BehaviorModel> BehaviorLaneChangeRuleBased::Clone()
     const {
   std::shared_ptr<BehaviorLaneChangeRuleBased> model_ptr =
-      std::make_shared<BehaviorLaneChangeRuleBased>(*this);
+      commons::MakePooled<BehaviorLaneChangeRuleBased>(*this);
   return model_ptr;
 }
 
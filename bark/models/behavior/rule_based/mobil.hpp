@@ -98,7 +98,7 @@ class BehaviorMobil : public BehaviorLaneChangeRuleBased {
 
 inline std::shared_ptr<BehaviorModel> BehaviorMobil::Clone() const {
   std::shared_ptr<BehaviorMobil> model_ptr =
-      std::make_shared<BehaviorMobil>(*this);
+      commons::MakePooled<BehaviorMobil>(*this);
   return model_ptr;
 }
 
@@ -65,7 +65,7 @@ class BehaviorMobilRuleBased : public BehaviorLaneChangeRuleBased {
 
 inline std::shared_ptr<BehaviorModel> BehaviorMobilRuleBased::Clone() const {
   std::shared_ptr<BehaviorMobilRuleBased> model_ptr =
-      std::make_shared<BehaviorMobilRuleBased>(*this);
+      commons::MakePooled<BehaviorMobilRuleBased>(*this);
   return model_ptr;
 }
 
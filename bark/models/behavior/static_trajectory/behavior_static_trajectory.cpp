@@ -6,6 +6,8 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 
 #include "bark/commons/transformation/frenet_state.hpp"
@@ -21,19 +23,58 @@ using bark::models::dynamic::StateDefinition;
 BehaviorStaticTrajectory::BehaviorStaticTrajectory(
     const commons::ParamsPtr& params)
     : BehaviorModel(params, BehaviorStatus::NOT_STARTED_YET),
-      static_trajectory_(ReadInStaticTrajectory(params->GetListListFloat(
-          "static_trajectory",
-          "List of states that form a static trajectory to follow", {{}}))) {
+      static_trajectory_(std::make_shared<const Trajectory>(
+          ReadInStaticTrajectory(params->GetListListFloat(
+              "static_trajectory",
+              "List of states that form a static trajectory to follow",
+              {{}})))),
+      first_row_(0),
+      num_rows_(static_trajectory_->rows()),
+      time_offset_(0.),
+      cursor_(0) {
+  InitTimeRange();
   SetLastAction(LonLatAction{0.0f, 0.0f});
 }
 
 BehaviorStaticTrajectory::BehaviorStaticTrajectory(
     const commons::ParamsPtr& params, const Trajectory& static_trajectory)
+    : BehaviorStaticTrajectory(
+          params, std::make_shared<const Trajectory>(static_trajectory)) {}
+
+BehaviorStaticTrajectory::BehaviorStaticTrajectory(
+    const commons::ParamsPtr& params,
+    const StaticTrajectoryPtr& static_trajectory)
+    : BehaviorStaticTrajectory(params, static_trajectory, 0,
+                               static_trajectory->rows(), 0.) {}
+
+BehaviorStaticTrajectory::BehaviorStaticTrajectory(
+    const commons::ParamsPtr& params,
+    const StaticTrajectoryPtr& static_trajectory, int first_row,
+    int num_rows, double time_offset)
     : BehaviorModel(params, BehaviorStatus::NOT_STARTED_YET),
-      static_trajectory_(static_trajectory) {
+      static_trajectory_(static_trajectory),
+      first_row_(first_row),
+      num_rows_(num_rows),
+      time_offset_(time_offset),
+      cursor_(0) {
+  BARK_EXPECT_TRUE(first_row_ >= 0 && num_rows_ >= 0 &&
+                   first_row_ + num_rows_ <= static_trajectory_->rows());
+  InitTimeRange();
   SetLastAction(LonLatAction{0.0f, 0.0f});
 }
 
+void BehaviorStaticTrajectory::InitTimeRange() {
+  if (num_rows_ > 0 && static_trajectory_->cols() > dynamic::TIME_POSITION) {
+    const auto window = GetWindow();
+    start_time_ =
+        window.col(dynamic::TIME_POSITION).minCoeff() - time_offset_;
+    end_time_ = window.col(dynamic::TIME_POSITION).maxCoeff() - time_offset_;
+  } else {
+    start_time_ = std::numeric_limits<double>::infinity();
+    end_time_ = -std::numeric_limits<double>::infinity();
+  }
+}
+
 Trajectory BehaviorStaticTrajectory::Plan(
     float delta_time, const bark::world::ObservedWorld& observed_world) {
   UpdateBehaviorStatus(delta_time, observed_world);
@@ -58,10 +99,12 @@ Trajectory BehaviorStaticTrajectory::Plan(
   traj.row(0) = interp_start;
   traj.row(traj.rows() - 1) = interp_end;
   traj.block(1, 0, num_rows, traj.cols()) =
-      static_trajectory_.block(idx_start, 0, num_rows, traj.cols());
+      GetWindow().block(idx_start, 0, num_rows, traj.cols());
+  traj.col(dynamic::TIME_POSITION).segment(1, num_rows).array() -=
+      static_cast<float>(time_offset_);
   this->SetLastTrajectory(traj);
-  this->SetLastAction(BehaviorStaticTrajectory::CalculateAction(
-      delta_time, observed_world, traj));
+  this->SetLastAction(
+      CalculateActionFromLastEnd(delta_time, observed_world, traj));
   return traj;
 }
 
@@ -71,7 +114,7 @@ Action BehaviorStaticTrajectory::CalculateAction(
   auto lane_corridor = observed_world.GetLaneCorridor();
   BARK_EXPECT_TRUE(bool(lane_corridor));
 
-  auto center_line = lane_corridor->GetCenterLine();
+  const auto& center_line = lane_corridor->GetCenterLine();
   bark::commons::transformation::FrenetState frenet_state_start(
       trajectory.row(0), center_line);
   bark::commons::transformation::FrenetState frenet_state_end(
@@ -82,30 +125,63 @@ Action BehaviorStaticTrajectory::CalculateAction(
   return LonLatAction{acc_lat, acc_lon};
 }
 
+Action BehaviorStaticTrajectory::CalculateActionFromLastEnd(
+    float delta_time, const bark::world::ObservedWorld& observed_world,
+    const dynamic::Trajectory& trajectory) {
+  const auto lane_corridor = observed_world.GetLaneCorridor();
+  BARK_EXPECT_TRUE(bool(lane_corridor));
+
+  // consecutive plans start where the previous one ended
+  const auto& center_line = lane_corridor->GetCenterLine();
+  const bool reuse_start = lane_corridor == last_end_lane_corridor_ &&
+                           last_end_state_.size() == trajectory.cols() &&
+                           last_end_state_ == trajectory.row(0);
+  const bark::commons::transformation::FrenetState frenet_state_start =
+      reuse_start ? last_end_frenet_state_
+                  : bark::commons::transformation::FrenetState(
+                        trajectory.row(0), center_line);
+  last_end_state_ = trajectory.row(trajectory.rows() - 1);
+  last_end_frenet_state_ = bark::commons::transformation::FrenetState(
+      last_end_state_, center_line);
+  last_end_lane_corridor_ = lane_corridor;
+
+  const auto& frenet_state_end = last_end_frenet_state_;
+  auto acc_lat = (frenet_state_end.vlat - frenet_state_start.vlat) / delta_time;
+  auto acc_lon = (frenet_state_end.vlon - frenet_state_start.vlon) / delta_time;
+
+  return LonLatAction{acc_lat, acc_lon};
+}
+
 std::pair<int, int> BehaviorStaticTrajectory::Interpolate(
-    const double t, StateRowVector* interpolated) const {
+    const double time, StateRowVector* interpolated) {
+  const auto static_trajectory = GetWindow();
+  const double t = time + time_offset_;
   StateRowVector delta;
   double alpha;
-  int idx = -1;
-  if (static_trajectory_.rows() < 2) {
+  const int num_rows = static_trajectory.rows();
+  if (num_rows < 2) {
     return {-1, -1};
   }
-  for (int i = 0; i < static_trajectory_.rows() - 1; ++i) {
-    float t_i = static_trajectory_(i, dynamic::TIME_POSITION);
-    float t_i_succ = static_trajectory_(i + 1, dynamic::TIME_POSITION);
-
-    if (t_i <= t && t <= t_i_succ) {
-      idx = i;
-      break;
-    }
+  // first segment with t_i <= t <= t_i_succ, starting at the cursor
+  int idx = std::min(cursor_, num_rows - 2);
+  while (idx > 0 && t <= static_trajectory(idx, dynamic::TIME_POSITION)) {
+    --idx;
+  }
+  while (idx < num_rows - 1 &&
+         t > static_trajectory(idx + 1, dynamic::TIME_POSITION)) {
+    ++idx;
   }
-  if (idx < 0) {
+  if (idx == num_rows - 1 ||
+      t < static_trajectory(idx, dynamic::TIME_POSITION)) {
     return {-1, -1};
   }
-  delta = static_trajectory_.row(idx + 1) - static_trajectory_.row(idx);
-  alpha = (t - static_trajectory_(idx, dynamic::TIME_POSITION)) /
+  cursor_ = idx;
+
+  delta = static_trajectory.row(idx + 1) - static_trajectory.row(idx);
+  alpha = (t - static_trajectory(idx, dynamic::TIME_POSITION)) /
           delta(dynamic::TIME_POSITION);
-  *interpolated = (static_trajectory_.row(idx) + alpha * delta);
+  *interpolated = (static_trajectory.row(idx) + alpha * delta);
+  (*interpolated)(dynamic::TIME_POSITION) -= time_offset_;
   // Index of next valid entry
   if (alpha == 0.0) {
     return {idx - 1, idx + 1};
@@ -118,7 +194,7 @@ std::pair<int, int> BehaviorStaticTrajectory::Interpolate(
 
 std::shared_ptr<BehaviorModel> BehaviorStaticTrajectory::Clone() const {
   std::shared_ptr<BehaviorStaticTrajectory> model_ptr =
-      std::make_shared<BehaviorStaticTrajectory>(*this);
+      commons::MakePooled<BehaviorStaticTrajectory>(*this);
   return std::dynamic_pointer_cast<BehaviorModel>(model_ptr);
 }
 
@@ -134,8 +210,13 @@ Trajectory BehaviorStaticTrajectory::ReadInStaticTrajectory(
   return traj;
 }
 
-const Trajectory& BehaviorStaticTrajectory::GetStaticTrajectory() const {
-  return static_trajectory_;
+Trajectory BehaviorStaticTrajectory::GetReplayedTrajectory() const {
+  Trajectory window = GetWindow();
+  if (window.cols() > dynamic::TIME_POSITION) {
+    window.col(dynamic::TIME_POSITION).array() -=
+        static_cast<float>(time_offset_);
+  }
+  return window;
 }
 
 void BehaviorStaticTrajectory::UpdateBehaviorStatus(
@@ -143,10 +224,8 @@ void BehaviorStaticTrajectory::UpdateBehaviorStatus(
   const double start_time = observed_world.GetWorldTime();
   const double end_time = start_time + delta_time;
 
-  const double start_time_static_traj =
-      (static_trajectory_.col(dynamic::TIME_POSITION)).minCoeff();
-  const double end_time_static_traj =
-      (static_trajectory_.col(dynamic::TIME_POSITION)).maxCoeff();
+  const double start_time_static_traj = start_time_;
+  const double end_time_static_traj = end_time_;
 
   if (start_time_static_traj > start_time) {
     SetBehaviorStatus(BehaviorStatus::NOT_STARTED_YET);
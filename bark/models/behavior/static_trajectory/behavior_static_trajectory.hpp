@@ -13,8 +13,10 @@
 #include <utility>
 #include <vector>
 
+#include "bark/commons/transformation/frenet_state.hpp"
 #include "bark/models/behavior/behavior_model.hpp"
 #include "bark/models/dynamic/dynamic_model.hpp"
+#include "bark/world/map/lane_corridor.hpp"
 
 namespace bark {
 namespace models {
@@ -27,18 +29,33 @@ using dynamic::Trajectory;
 using world::ObservedWorld;
 using world::objects::AgentId;
 using StateRowVector = Eigen::Matrix<State::Scalar, 1, Eigen::Dynamic>;
+typedef std::shared_ptr<const Trajectory> StaticTrajectoryPtr;
 
 // model for replaying static trajectories
 // can e.g. be used for dataset replay
+// the static trajectory is immutable and shared between clones; a model
+// can replay a window of its rows with the times shifted by an offset
 class BehaviorStaticTrajectory : public BehaviorModel {
  public:
   explicit BehaviorStaticTrajectory(const commons::ParamsPtr& params);
   BehaviorStaticTrajectory(const commons::ParamsPtr& params,
                            const Trajectory& static_trajectory);
+  BehaviorStaticTrajectory(const commons::ParamsPtr& params,
+                           const StaticTrajectoryPtr& static_trajectory);
+  //! replays the rows [first_row, first_row + num_rows) of the static
+  //! trajectory, the time time_offset of the trajectory being time zero
+  BehaviorStaticTrajectory(const commons::ParamsPtr& params,
+                           const StaticTrajectoryPtr& static_trajectory,
+                           int first_row, int num_rows, double time_offset);
   Trajectory Plan(float min_planning_time,
                   const world::ObservedWorld& observed_world) override;
   std::shared_ptr<BehaviorModel> Clone() const override;
-  const Trajectory& GetStaticTrajectory() const;
+  const Trajectory& GetStaticTrajectory() const { return *static_trajectory_; }
+  //! the replayed window with shifted times
+  Trajectory GetReplayedTrajectory() const;
+  const StaticTrajectoryPtr& GetStaticTrajectoryPtr() const {
+    return static_trajectory_;
+  }
   void UpdateBehaviorStatus(float delta_time,
                             const world::ObservedWorld& observed_world);
   static Action CalculateAction(
@@ -48,9 +65,31 @@ class BehaviorStaticTrajectory : public BehaviorModel {
  private:
   static Trajectory ReadInStaticTrajectory(
       std::vector<std::vector<float>> list);
-  std::pair<int, int> Interpolate(const double t,
-                                  StateRowVector* interpolated) const;
-  Trajectory static_trajectory_;
+  //! searches from the cursor of the previous query, which makes
+  //! interpolating at increasing times amortized O(1)
+  std::pair<int, int> Interpolate(const double time,
+                                  StateRowVector* interpolated);
+  //! as CalculateAction, but reuses the frenet state of the last end state
+  //! if the trajectory starts there
+  Action CalculateActionFromLastEnd(
+      float delta_time, const bark::world::ObservedWorld& observed_world,
+      const dynamic::Trajectory& trajectory);
+  void InitTimeRange();
+  Eigen::Block<const Trajectory> GetWindow() const {
+    return static_trajectory_->middleRows(first_row_, num_rows_);
+  }
+
+  StaticTrajectoryPtr static_trajectory_;
+  int first_row_;
+  int num_rows_;
+  double time_offset_;
+  double start_time_;
+  double end_time_;
+  int cursor_;
+
+  world::map::LaneCorridorPtr last_end_lane_corridor_;
+  StateRowVector last_end_state_;
+  commons::transformation::FrenetState last_end_frenet_state_;
 };
 
 }  // namespace behavior
@@ -10,12 +10,14 @@
 #define BARK_MODELS_DYNAMIC_DYNAMIC_MODEL_HPP_
 
 #include <Eigen/Core>
+#include <atomic>
 #include <boost/variant.hpp>
 #include <memory>
 #include <queue>
 #include <utility>
 
 #include "bark/commons/commons.hpp"
+#include "bark/commons/util/pool_allocator.hpp"
 
 namespace bark {
 namespace models {
@@ -37,6 +39,71 @@ using State = Eigen::Matrix<float, Eigen::Dynamic, 1>;
 using Input = Eigen::Matrix<float, Eigen::Dynamic, 1>;
 
 using Trajectory = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>;
+//! one input per row
+using InputTrajectory = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>;
+//! states or inputs of many agents, one agent per row; as the storage is
+//! column-major, each component is contiguous over the agents
+using StateBatch = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>;
+
+//! Trajectory of a model that its clones share until one of them sets a
+//! new trajectory. The buffer is only overwritten while it has a single
+//! owner, so trajectories returned by Get() remain unchanged for the other
+//! owners. A reference returned by Get() is invalidated by the next Set()
+//! or Mutable() of the same owner.
+class SharedTrajectory {
+ public:
+  SharedTrajectory() : buffer_(std::make_shared<Trajectory>()) {}
+
+  const Trajectory& Get() const { return *buffer_; }
+
+  void Set(const Trajectory& trajectory) {
+    if (IsUnique()) {
+      *buffer_ = trajectory;
+    } else {
+      buffer_ = std::make_shared<Trajectory>(trajectory);
+    }
+  }
+
+  //! trajectory to be overwritten in place; a buffer that is shared with
+  //! other owners is first replaced by a new one of the same size
+  Trajectory* Mutable() {
+    if (!IsUnique()) {
+      buffer_ = std::make_shared<Trajectory>(buffer_->rows(), buffer_->cols());
+    }
+    return buffer_.get();
+  }
+
+ private:
+  //! use_count() is a relaxed load; the fence orders the following writes
+  //! after the reads of owners on other threads that released the buffer
+  bool IsUnique() const {
+    if (buffer_.use_count() != 1) {
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+  }
+
+  std::shared_ptr<Trajectory> buffer_;
+};
+
+enum class IntegrationMethod { EULER, RK4 };
+
+//! one fixed step of the method; the derivative f is evaluated at states
+//! of the type of x, which can be a fixed-size state or a batch of states
+template <typename StateType, typename Derivative>
+inline StateType IntegrationStep(const StateType& x, float dt,
+                                 IntegrationMethod method,
+                                 const Derivative& f) {
+  if (method == IntegrationMethod::EULER) {
+    return x + dt * f(x);
+  }
+  const StateType k0 = dt * f(x);
+  const StateType k1 = dt * f(StateType(x + k0 / 2));
+  const StateType k2 = dt * f(StateType(x + k1 / 2));
+  const StateType k3 = dt * f(StateType(x + k2));
+  return x + 1.0 / 6.0 * (k0 + 2 * k1 + 2 * k2 + k3);
+}
 
 inline bool IsValid(const State& state) {
   return ((state - state).array() == (state - state).array()).all() &&
@@ -57,11 +124,67 @@ class DynamicModel : public commons::BaseType {
 
   virtual State StateSpaceModel(const State& x, const Input& u) const = 0;
 
+  //! integrates num_steps fixed steps of dt; the inputs hold one row per
+  //! step or a single row that is applied in all steps; row i of the
+  //! trajectory is the state after i steps
+  virtual void IntegrateTrajectoryInPlace(
+      const State& x0, const InputTrajectory& inputs, float dt, int num_steps,
+      Trajectory* trajectory,
+      IntegrationMethod method = IntegrationMethod::EULER) const;
+
+  Trajectory IntegrateTrajectory(
+      const State& x0, const InputTrajectory& inputs, float dt, int num_steps,
+      IntegrationMethod method = IntegrationMethod::EULER) const {
+    Trajectory trajectory;
+    IntegrateTrajectoryInPlace(x0, inputs, dt, num_steps, &trajectory, method);
+    return trajectory;
+  }
+
+  //! advances the states of all agents by num_steps fixed steps of dt; the
+  //! inputs hold one row per agent or a single row for all agents
+  virtual void IntegrateBatch(
+      StateBatch* states, const StateBatch& inputs, float dt, int num_steps,
+      IntegrationMethod method = IntegrationMethod::EULER) const;
+
   virtual std::shared_ptr<DynamicModel> Clone() const = 0;
 
   int input_size_;
 };
 
+inline void DynamicModel::IntegrateTrajectoryInPlace(
+    const State& x0, const InputTrajectory& inputs, float dt, int num_steps,
+    Trajectory* trajectory, IntegrationMethod method) const {
+  BARK_EXPECT_TRUE(inputs.rows() == 1 || inputs.rows() >= num_steps);
+  trajectory->resize(num_steps + 1, x0.rows());
+  trajectory->row(0) = x0;
+  State x = x0;
+  Input u;
+  for (int i = 0; i < num_steps; ++i) {
+    u = inputs.row(inputs.rows() == 1 ? 0 : i).transpose();
+    x = IntegrationStep(x, dt, method,
+                        [&](const State& s) { return StateSpaceModel(s, u); });
+    trajectory->row(i + 1) = x;
+  }
+}
+
+inline void DynamicModel::IntegrateBatch(StateBatch* states,
+                                         const StateBatch& inputs, float dt,
+                                         int num_steps,
+                                         IntegrationMethod method) const {
+  BARK_EXPECT_TRUE(inputs.rows() == 1 || inputs.rows() == states->rows());
+  State x;
+  Input u;
+  for (int a = 0; a < states->rows(); ++a) {
+    x = states->row(a).transpose();
+    u = inputs.row(inputs.rows() == 1 ? 0 : a).transpose();
+    for (int i = 0; i < num_steps; ++i) {
+      x = IntegrationStep(
+          x, dt, method, [&](const State& s) { return StateSpaceModel(s, u); });
+    }
+    states->row(a) = x.transpose();
+  }
+}
+
 typedef std::shared_ptr<DynamicModel> DynamicModelPtr;
 
 }  // namespace dynamic
@@ -48,15 +48,87 @@ class SingleTrackModel : public DynamicModel {
     return tmp;
   }
 
+  //! fixed-size inner loop without virtual calls per step
+  void IntegrateTrajectoryInPlace(const State& x0,
+                                  const InputTrajectory& inputs, float dt,
+                                  int num_steps, Trajectory* trajectory,
+                                  IntegrationMethod method) const override {
+    if (x0.rows() != StateDefinition::MIN_STATE_SIZE || inputs.cols() != 2 ||
+        (inputs.rows() != 1 && inputs.rows() < num_steps)) {
+      DynamicModel::IntegrateTrajectoryInPlace(x0, inputs, dt, num_steps,
+                                               trajectory, method);
+      return;
+    }
+    typedef Eigen::Matrix<float, StateDefinition::MIN_STATE_SIZE, 1>
+        FixedState;
+    trajectory->resize(num_steps + 1, StateDefinition::MIN_STATE_SIZE);
+    trajectory->row(0) = x0;
+    FixedState x = x0;
+    for (int i = 0; i < num_steps; ++i) {
+      const int row = inputs.rows() == 1 ? 0 : i;
+      const float acceleration = inputs(row, 0);
+      const float curvature = tan(inputs(row, 1)) / wheel_base_;
+      x = IntegrationStep(x, dt, method, [&](const FixedState& s) {
+        const float v = s(StateDefinition::VEL_POSITION);
+        const float theta = s(StateDefinition::THETA_POSITION);
+        FixedState x_dot;
+        x_dot << 1, v * cos(theta), v * sin(theta), v * curvature,
+            acceleration;
+        return x_dot;
+      });
+      trajectory->row(i + 1) = x.transpose();
+    }
+  }
+
+  //! integrates all agents at once, each state component is one column
+  void IntegrateBatch(StateBatch* states, const StateBatch& inputs, float dt,
+                      int num_steps, IntegrationMethod method) const override {
+    const int num_agents = states->rows();
+    if (states->cols() != StateDefinition::MIN_STATE_SIZE ||
+        inputs.cols() != 2 ||
+        (inputs.rows() != 1 && inputs.rows() != num_agents)) {
+      DynamicModel::IntegrateBatch(states, inputs, dt, num_steps, method);
+      return;
+    }
+    Eigen::ArrayXf acceleration(num_agents), curvature(num_agents);
+    if (inputs.rows() == 1) {
+      acceleration.setConstant(inputs(0, 0));
+      curvature.setConstant(tan(inputs(0, 1)) / wheel_base_);
+    } else {
+      acceleration = inputs.col(0).array();
+      curvature = inputs.col(1).array().tan() / wheel_base_;
+    }
+    StateBatch x = *states;
+    for (int i = 0; i < num_steps; ++i) {
+      x = IntegrationStep(x, dt, method, [&](const StateBatch& s) {
+        const auto v = s.col(StateDefinition::VEL_POSITION).array();
+        const auto theta = s.col(StateDefinition::THETA_POSITION).array();
+        StateBatch x_dot(num_agents, StateDefinition::MIN_STATE_SIZE);
+        x_dot.col(StateDefinition::TIME_POSITION).setOnes();
+        x_dot.col(StateDefinition::X_POSITION) =
+            (v * theta.cos()).matrix();
+        x_dot.col(StateDefinition::Y_POSITION) =
+            (v * theta.sin()).matrix();
+        x_dot.col(StateDefinition::THETA_POSITION) =
+            (v * curvature).matrix();
+        x_dot.col(StateDefinition::VEL_POSITION) = acceleration.matrix();
+        return x_dot;
+      });
+    }
+    *states = x;
+  }
+
   std::shared_ptr<DynamicModel> Clone() const {
     std::shared_ptr<SingleTrackModel> model_ptr =
-        std::make_shared<SingleTrackModel>(*this);
+        commons::MakePooled<SingleTrackModel>(*this);
     return std::dynamic_pointer_cast<DynamicModel>(model_ptr);
   }
 
   double GetWheelBase() const { return wheel_base_; }
   double GetSteeringAngleMax() const { return steering_angle_max_; }
   double GetLatAccelerationMax() const { return lat_acceleration_max_; }
+  float GetLonAccelerationMax() const { return lon_acceleration_max_; }
+  float GetLonAccelerationMin() const { return lon_acceleration_min_; }
   float GetMaxAcceleration(const State& x) const {
     return lon_acceleration_max_;
   }
@@ -36,34 +36,172 @@ class TripleIntegratorModel : public DynamicModel {
    * @return State
    */
   State StateSpaceModel(const State& x, const Input& u) const {
-    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> A(15, 15);
-    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> B(15, 3);
-    A << 1., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 1., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 1., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 1., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 1.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 1., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 1., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 0.;
-    B << 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.,
-        0., 0., 0., 0., 0., 0., 1., 0., 0., 0., 0., 0., 0., 0., 0., 0., 1., 0.,
-        0., 0., 0., 0., 0., 0., 0., 0., 1.;
-    return A * x + B * u;
+    FixedState x_dot;
+    Derivative(x, u, &x_dot);
+    return x_dot;
+  }
+
+  //! exact discrete-time propagation by dt with a constant input; each axis
+  //! is a chain of three integrators, so no numerical integration is needed
+  State Propagate(const State& x, const Input& u, float dt) const {
+    FixedState next_x = x;
+    ExactStep(FixedInput(u), dt, &next_x);
+    return next_x;
+  }
+
+  //! exact propagation for piecewise-constant inputs held for dt each; the
+  //! inputs hold one row per step or a single row that is applied in all
+  //! steps
+  Trajectory PropagateTrajectory(const State& x0,
+                                 const InputTrajectory& inputs, float dt,
+                                 int num_steps) const {
+    BARK_EXPECT_TRUE(inputs.cols() == kInputSize &&
+                     (inputs.rows() == 1 || inputs.rows() >= num_steps));
+    Trajectory trajectory(num_steps + 1, kStateSize);
+    trajectory.row(0) = x0;
+    FixedState x = x0;
+    for (int i = 0; i < num_steps; ++i) {
+      ExactStep(
+          FixedInput(inputs.row(inputs.rows() == 1 ? 0 : i).transpose()), dt,
+          &x);
+      trajectory.row(i + 1) = x.transpose();
+    }
+    return trajectory;
+  }
+
+  //! exact propagation of all agents of a batch by dt
+  void PropagateBatch(StateBatch* states, const StateBatch& inputs,
+                      float dt) const {
+    BARK_EXPECT_TRUE(states->cols() == kStateSize &&
+                     inputs.cols() == kInputSize &&
+                     (inputs.rows() == 1 || inputs.rows() == states->rows()));
+    const float dt2 = dt * dt / 2.f, dt3 = dt * dt * dt / 6.f;
+    states->col(StateDefinition::TIME_POSITION).array() += dt;
+    for (int axis = 0; axis < kInputSize; ++axis) {
+      const int position = kFirstAxisPosition + 3 * axis;
+      auto p = states->col(position).array();
+      auto v = states->col(position + 1).array();
+      auto a = states->col(position + 2).array();
+      if (inputs.rows() == 1) {
+        const float u = inputs(0, axis);
+        p += dt * v + dt2 * a + dt3 * u;
+        v += dt * a + dt2 * u;
+        a += dt * u;
+      } else {
+        const auto u = inputs.col(axis).array();
+        p += dt * v + dt2 * a + dt3 * u;
+        v += dt * a + dt2 * u;
+        a += dt * u;
+      }
+    }
+  }
+
+  //! fixed-size inner loop without virtual calls per step
+  void IntegrateTrajectoryInPlace(const State& x0,
+                                  const InputTrajectory& inputs, float dt,
+                                  int num_steps, Trajectory* trajectory,
+                                  IntegrationMethod method) const override {
+    if (x0.rows() != kStateSize || inputs.cols() != kInputSize ||
+        (inputs.rows() != 1 && inputs.rows() < num_steps)) {
+      DynamicModel::IntegrateTrajectoryInPlace(x0, inputs, dt, num_steps,
+                                               trajectory, method);
+      return;
+    }
+    trajectory->resize(num_steps + 1, kStateSize);
+    trajectory->row(0) = x0;
+    FixedState x = x0;
+    for (int i = 0; i < num_steps; ++i) {
+      const FixedInput u =
+          inputs.row(inputs.rows() == 1 ? 0 : i).transpose();
+      x = IntegrationStep(x, dt, method, [&](const FixedState& s) {
+        FixedState x_dot;
+        Derivative(s, u, &x_dot);
+        return x_dot;
+      });
+      trajectory->row(i + 1) = x.transpose();
+    }
+  }
+
+  //! integrates all agents at once, each state component is one column
+  void IntegrateBatch(StateBatch* states, const StateBatch& inputs, float dt,
+                      int num_steps, IntegrationMethod method) const override {
+    const int num_agents = states->rows();
+    if (states->cols() != kStateSize || inputs.cols() != kInputSize ||
+        (inputs.rows() != 1 && inputs.rows() != num_agents)) {
+      DynamicModel::IntegrateBatch(states, inputs, dt, num_steps, method);
+      return;
+    }
+    StateBatch u(num_agents, kInputSize);
+    if (inputs.rows() == 1) {
+      u.rowwise() = inputs.row(0);
+    } else {
+      u = inputs;
+    }
+    StateBatch x = *states;
+    for (int i = 0; i < num_steps; ++i) {
+      x = IntegrationStep(x, dt, method, [&](const StateBatch& s) {
+        StateBatch x_dot;
+        Derivative(s, u, &x_dot);
+        return x_dot;
+      });
+    }
+    *states = x;
   }
 
   std::shared_ptr<DynamicModel> Clone() const {
     std::shared_ptr<TripleIntegratorModel> model_ptr =
-        std::make_shared<TripleIntegratorModel>(*this);
+        commons::MakePooled<TripleIntegratorModel>(*this);
     return std::dynamic_pointer_cast<DynamicModel>(model_ptr);
   }
 
  private:
+  static const int kStateSize = 15;
+  static const int kInputSize = 3;
+  //! the x, y and z chains follow the minimal state
+  static const int kFirstAxisPosition = 6;
+  typedef Eigen::Matrix<float, kStateSize, 1> FixedState;
+  typedef Eigen::Matrix<float, kInputSize, 1> FixedInput;
+
+  //! derivative of the state space model, xyz positions are integrated
+  //! from velocities, velocities from accelerations and the accelerations
+  //! from their inputs
+  static void Derivative(const FixedState& x, const FixedInput& u,
+                         FixedState* x_dot) {
+    x_dot->setZero();
+    (*x_dot)(StateDefinition::TIME_POSITION) = 1.;
+    for (int axis = 0; axis < kInputSize; ++axis) {
+      const int position = kFirstAxisPosition + 3 * axis;
+      (*x_dot)(position) = x(position + 1);
+      (*x_dot)(position + 1) = x(position + 2);
+      (*x_dot)(position + 2) = u(axis);
+    }
+  }
+
+  static void ExactStep(const FixedInput& u, float dt, FixedState* x) {
+    const float dt2 = dt * dt / 2.f, dt3 = dt * dt * dt / 6.f;
+    (*x)(StateDefinition::TIME_POSITION) += dt;
+    for (int axis = 0; axis < kInputSize; ++axis) {
+      const int position = kFirstAxisPosition + 3 * axis;
+      const float v = (*x)(position + 1), a = (*x)(position + 2);
+      (*x)(position) += dt * v + dt2 * a + dt3 * u(axis);
+      (*x)(position + 1) += dt * a + dt2 * u(axis);
+      (*x)(position + 2) += dt * u(axis);
+    }
+  }
+
+  //! the same for a batch with one agent per row
+  static void Derivative(const StateBatch& x, const StateBatch& u,
+                         StateBatch* x_dot) {
+    x_dot->setZero(x.rows(), kStateSize);
+    x_dot->col(StateDefinition::TIME_POSITION).setOnes();
+    for (int axis = 0; axis < kInputSize; ++axis) {
+      const int position = kFirstAxisPosition + 3 * axis;
+      x_dot->col(position) = x.col(position + 1);
+      x_dot->col(position + 1) = x.col(position + 2);
+      x_dot->col(position + 2) = u.col(axis);
+    }
+  }
+
   float mass_;
 };
 
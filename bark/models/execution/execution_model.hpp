@@ -13,6 +13,7 @@
 #include <memory>
 
 #include "bark/commons/base_type.hpp"
+#include "bark/commons/util/pool_allocator.hpp"
 #include "bark/models/dynamic/dynamic_model.hpp"
 
 namespace bark {
@@ -36,17 +37,26 @@ class ExecutionModel : public commons::BaseType {
   ExecutionModel(const ExecutionModel& execution_model)
       : BaseType(execution_model.GetParams()),
         last_state_(execution_model.GetExecutedState()),
-        last_trajectory_(execution_model.GetLastTrajectory()),
+        last_trajectory_(execution_model.last_trajectory_),
         execution_status_(execution_model.GetExecutionStatus()) {}
 
   virtual ~ExecutionModel() {}
 
   State GetExecutedState() const { return last_state_; }
-  Trajectory GetLastTrajectory() const { return last_trajectory_; }
+  //! the reference is invalidated by the next SetLastTrajectory, i.e. by
+  //! the next Execute
+  const Trajectory& GetLastTrajectory() const {
+    return last_trajectory_.Get();
+  }
 
   void SetLastState(const State& state) { last_state_ = state; }
+  //! assigns an expression without a temporary state
+  template <typename Derived>
+  void SetLastState(const Eigen::MatrixBase<Derived>& state) {
+    last_state_ = state;
+  }
 
-  void SetLastTrajectory(const Trajectory& traj) { last_trajectory_ = traj; }
+  void SetLastTrajectory(const Trajectory& traj) { last_trajectory_.Set(traj); }
 
   void SetExecutionStatus(const ExecutionStatus& execution_status) {
     execution_status_ = execution_status;
@@ -62,7 +72,7 @@ class ExecutionModel : public commons::BaseType {
 
  private:
   State last_state_;
-  Trajectory last_trajectory_;
+  dynamic::SharedTrajectory last_trajectory_;
   ExecutionStatus execution_status_;
 };
 
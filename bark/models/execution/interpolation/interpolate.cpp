@@ -7,7 +7,8 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "bark/models/execution/interpolation/interpolate.hpp"
-#include <iostream>
+#include <algorithm>
+#include <cmath>
 
 namespace bark {
 namespace models {
@@ -24,50 +25,23 @@ bool ExecutionModelInterpolate::CheckIfWorldTimeIsWithinTrajectory(
   if ((world_time + delta) < trajectory(0, TIME_POSITION) ||
       (world_time - delta) > trajectory(trajectory.rows() - 1, TIME_POSITION)) {
     is_in_traj = false;
-    LOG(INFO) << "World time " << world_time << " out of trajectory."
-              << " Trajectory start_time: " << trajectory(0, TIME_POSITION)
-              << ", end_time: "
-              << trajectory(trajectory.rows() - 1, TIME_POSITION) << "."
-              << std::endl;
-    LOG(INFO) << trajectory << std::endl;
+    VLOG(3) << "World time " << world_time << " out of trajectory."
+            << " Trajectory start_time: " << trajectory(0, TIME_POSITION)
+            << ", end_time: "
+            << trajectory(trajectory.rows() - 1, TIME_POSITION) << ".";
   }
   return is_in_traj;
 }
 
-std::pair<State, bool>
-ExecutionModelInterpolate::CheckIfTimeExactIsInTrajectory(
+int ExecutionModelInterpolate::FindLowerTrajectoryRow(
     const Trajectory& trajectory, const double& world_time) const {
-  const float delta = 1e-3;
-  float start_time = trajectory(0, TIME_POSITION);
-  float end_time = trajectory(trajectory.rows() - 1, TIME_POSITION);
-  int half_traj_num = static_cast<int>(trajectory.rows() / 2);
-
-  // closer to the end; reverse; only need to check half of the traj.
-  if (fabs(world_time - end_time) < fabs(world_time - start_time)) {
-    for (int i = trajectory.rows() - 1; half_traj_num - 1 < i; i--)
-      if (fabs(trajectory(i, TIME_POSITION) - world_time) < delta)
-        return {State(trajectory.row(i)), true};
-  } else {
-    for (int i = 0; i < half_traj_num + 1; i++)
-      if (fabs(trajectory(i, TIME_POSITION) - world_time) < delta)
-        return {State(trajectory.row(i)), true};
-  }
-  return {State(), false};
-}
-
-std::pair<int, bool> ExecutionModelInterpolate::FindClosestLowerTrajectoryRow(
-    const Trajectory& trajectory, const double& world_time) const {
-  const float delta = 1e-3;
-  int ret_idx = 0;
-  bool found_closest_pt = false;
-  for (int i = 0; i < trajectory.rows(); i++) {
-    if (world_time >= trajectory(i, TIME_POSITION)) {
-      ret_idx = i;
-      found_closest_pt = true;
-      break;
-    }
-  }
-  return {ret_idx, found_closest_pt};
+  // the time column is contiguous as the trajectory is stored column-major
+  const float* times = trajectory.col(TIME_POSITION).data();
+  const int num_rows = trajectory.rows();
+  const int upper_idx = std::upper_bound(times, times + num_rows,
+                                         static_cast<float>(world_time)) -
+                        times;
+  return std::max(0, std::min(upper_idx - 1, num_rows - 2));
 }
 
 State ExecutionModelInterpolate::Interpolate(const State& p0, const State& p1,
@@ -86,38 +60,35 @@ void ExecutionModelInterpolate::Execute(const float& new_world_time,
   SetLastTrajectory(trajectory);
 
   // check time and size
-  if (!CheckIfWorldTimeIsWithinTrajectory(trajectory, new_world_time)) {
+  if (trajectory.rows() == 0 ||
+      !CheckIfWorldTimeIsWithinTrajectory(trajectory, new_world_time)) {
     SetExecutionStatus(ExecutionStatus::INVALID);
     return;
-  } else {
-    SetExecutionStatus(ExecutionStatus::VALID);
   }
+  SetExecutionStatus(ExecutionStatus::VALID);
 
-  // check if we can quickly find an exact point
-  std::pair<State, bool> has_exact_point =
-      CheckIfTimeExactIsInTrajectory(trajectory, new_world_time);
-  if (has_exact_point.second) {
-    SetLastState(has_exact_point.first);
+  // take exact points as they are; of repeated time points, e.g. of a
+  // trajectory planned for a zero time span, the first one is taken
+  const float delta = 1e-3;
+  const float* times = trajectory.col(TIME_POSITION).data();
+  const int num_rows = trajectory.rows();
+  const int exact_id =
+      std::lower_bound(times, times + num_rows, new_world_time - delta) -
+      times;
+  if (exact_id < num_rows && fabs(times[exact_id] - new_world_time) <= delta) {
+    SetLastState(trajectory.row(exact_id).transpose());
     return;
   }
 
-  // if not, interpolate
-  std::pair<int, bool> lower_idx =
-      FindClosestLowerTrajectoryRow(trajectory, new_world_time);
-  if (lower_idx.second == true) {
-    int lower_id = lower_idx.first;
-    int upper_id = lower_id + 1;
-    State p0 = trajectory.row(lower_id);
-    State p1 = trajectory.row(upper_id);
-    State interp_state = Interpolate(p0, p1, new_world_time);
-    SetLastState(interp_state);
-    // assert that the interpolated point is near the world time
-    BARK_EXPECT_TRUE(fabs(interp_state(TIME_POSITION) - new_world_time) < 0.02);
-    return;
-  } else {
-    LOG(INFO) << "ExecutionStatus is invalid." << std::endl;
-    SetExecutionStatus(ExecutionStatus::INVALID);
-  }
+  // otherwise the world time lies in between the lower and the upper row
+  const int lower_id = FindLowerTrajectoryRow(trajectory, new_world_time);
+  const int upper_id = lower_id + 1;
+  const float start_time = trajectory(lower_id, TIME_POSITION);
+  const float end_time = trajectory(upper_id, TIME_POSITION);
+  const float lambda = (new_world_time - start_time) / (end_time - start_time);
+  SetLastState(((1 - lambda) * trajectory.row(lower_id) +
+                lambda * trajectory.row(upper_id))
+                   .transpose());
 }
 
 }  // namespace execution
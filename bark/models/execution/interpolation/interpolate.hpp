@@ -10,6 +10,7 @@
 #define BARK_MODELS_EXECUTION_INTERPOLATION_INTERPOLATE_HPP_
 
 #include <Eigen/Core>
+#include <algorithm>
 #include "bark/models/execution/execution_model.hpp"
 
 namespace bark {
@@ -34,18 +35,13 @@ class ExecutionModelInterpolate : public ExecutionModel {
                                           const float& world_time) const;
 
   /**
-   * @brief  Find exact time in trajectory
-   * @retval BARK state and whether is was found
+   * @brief  Binary search for the last row with a time not after
+   *         world_time; rows before the last one are returned so that the
+   *         next row can be used for interpolation
+   * @retval Trajectory row-id
    */
-  std::pair<State, bool> CheckIfTimeExactIsInTrajectory(
-      const Trajectory& trajectory, const double& world_time) const;
-
-  /**
-   * @brief  Find lower time point in trajectory for world_time
-   * @retval Trajectory row-id and whether it was found
-   */
-  std::pair<int, bool> FindClosestLowerTrajectoryRow(
-      const Trajectory& trajectory, const double& world_time) const;
+  int FindLowerTrajectoryRow(const Trajectory& trajectory,
+                             const double& world_time) const;
 
   /**
    * @brief  Interpolates between two states
@@ -66,7 +62,7 @@ class ExecutionModelInterpolate : public ExecutionModel {
 inline std::shared_ptr<ExecutionModel> ExecutionModelInterpolate::Clone()
     const {
   std::shared_ptr<ExecutionModelInterpolate> model_ptr =
-      std::make_shared<ExecutionModelInterpolate>(*this);
+      commons::MakePooled<ExecutionModelInterpolate>(*this);
   return std::dynamic_pointer_cast<ExecutionModel>(model_ptr);
 }
 
@@ -9,6 +9,8 @@
 #ifndef BARK_MODELS_EXECUTION_MPC_COMMON_HPP_
 #define BARK_MODELS_EXECUTION_MPC_COMMON_HPP_
 
+#include <Eigen/Core>
+
 namespace bark {
 namespace models {
 namespace execution {
@@ -16,6 +18,29 @@ namespace execution {
 struct OptimizationSettings {
   int num_optimization_steps;
   float dt;
+  double wheel_base;
+  double weight_acceleration;
+  double weight_steering;
+  //! budget of one optimization
+  int max_num_iterations;
+  double max_solver_time;
+};
+
+//! number of control inputs per stage: acceleration and steering angle
+const int kMpcControlSize = 2;
+//! state of the kinematic model: x, y, theta and velocity
+const int kMpcStateSize = 4;
+
+typedef Eigen::Matrix<double, kMpcStateSize, 1> MpcState;
+
+//! reference of the optimization; the cost functions of the reused
+//! problem read it, so it is updated in place for every optimization
+struct MpcReference {
+  MpcState initial_state;
+  //! desired state and square roots of the weights for the stages
+  //! 1, ..., num_optimization_steps - 1 (row i - 1 for stage i)
+  Eigen::Matrix<double, Eigen::Dynamic, kMpcStateSize> desired_states;
+  Eigen::Matrix<double, Eigen::Dynamic, kMpcStateSize> sqrt_weights;
 };
 
 }  // namespace execution
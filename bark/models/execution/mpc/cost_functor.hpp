@@ -9,118 +9,125 @@
 #ifndef BARK_MODELS_EXECUTION_MPC_COST_FUNCTOR_HPP_
 #define BARK_MODELS_EXECUTION_MPC_COST_FUNCTOR_HPP_
 
+#include <cmath>
 #include <Eigen/Dense>
-#include <iostream>
+#include "ceres/ceres.h"
+
 #include "bark/models/execution/mpc/common.hpp"
 
 namespace bark {
 namespace models {
 namespace execution {
-using namespace bark::models::dynamic;
-
-template <typename T>
-inline Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> KinematicModel(
-    T const* const* parameters,
-    bark::models::dynamic::Trajectory desired_trajectory,
-    const OptimizationSettings& optimization_settings) {
-  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> traj =
-      desired_trajectory.cast<T>();
-
-  // TODO: Lf als Parameter
-  T Lf = T(2.6);
-
-  for (int i = 1; i < optimization_settings.num_optimization_steps; i++) {
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> f_dot(1, 5);
-
-    // fill matrix
-    f_dot << T(1),  // (0) t' = 1
-        traj(i - 1, StateDefinition::VEL_POSITION) *
-            cos(traj(
-                i - 1,
-                StateDefinition::THETA_POSITION)),  // (1) x_dot = v*cos(psi)
-        traj(i - 1, StateDefinition::VEL_POSITION) *
-            sin(traj(
-                i - 1,
-                StateDefinition::THETA_POSITION)),  // (2) y_dot = v*sin(psi)
-        tan(parameters[1][i - 1]) / Lf,  // (3) theta_dot = tan(delta)/Lf
-        parameters[0][i - 1];            // (4) v_dot = a
 
-    traj.block(i, 0, 1, 5) =
-        traj.block(i - 1, 0, 1, 5) + T(optimization_settings.dt) * f_dot;
-  }
-  return traj;
+//! euler step of the kinematic single track model
+//! x' = v cos(theta), y' = v sin(theta), theta' = v tan(delta) / L, v' = a
+inline MpcState KinematicStep(const MpcState& state, double acceleration,
+                              double steering, double dt, double wheel_base) {
+  const double theta = state(2), v = state(3);
+  MpcState next_state;
+  next_state(0) = state(0) + dt * v * cos(theta);
+  next_state(1) = state(1) + dt * v * sin(theta);
+  next_state(2) = state(2) + dt * v * tan(steering) / wheel_base;
+  next_state(3) = state(3) + dt * acceleration;
+  return next_state;
 }
 
-struct CostFunctor {
-  template <typename T>
-  bool operator()(T const* const* parameters, T* residual) {
-    // initialize
-    T cost = T(0.0);
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> traj = KinematicModel(
-        parameters, desired_discrete_states_, optimization_settings_);
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> desired_discrete_states =
-        desired_discrete_states_.cast<T>();
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> weights =
-        weights_.cast<T>();
-
-    // offsets
-    for (int i = 0; i < optimization_settings_.num_optimization_steps - 1;
-         i++) {
-      T xDiff, yDiff, thetaDiff, velDiff;
-      xDiff = traj(i, StateDefinition::X_POSITION) -
-              desired_discrete_states(i, StateDefinition::X_POSITION);
-      yDiff = traj(i, StateDefinition::Y_POSITION) -
-              desired_discrete_states(i, StateDefinition::Y_POSITION);
-      thetaDiff = traj(i, StateDefinition::THETA_POSITION) -
-                  desired_discrete_states(i, StateDefinition::THETA_POSITION);
-      velDiff = traj(i, StateDefinition::VEL_POSITION) -
-                desired_discrete_states(i, StateDefinition::VEL_POSITION);
-
-      cost += weights(i, StateDefinition::X_POSITION) * xDiff * xDiff;
-      cost += weights(i, StateDefinition::Y_POSITION) * yDiff * yDiff;
-      cost +=
-          weights(i, StateDefinition::THETA_POSITION) * thetaDiff * thetaDiff;
-      cost += weights(i, StateDefinition::VEL_POSITION) * velDiff * velDiff;
+//! Residual of the state of one stage to its desired state. The state is
+//! rolled out from the initial state with the controls of the previous
+//! stages, which are the parameter blocks of the residual; the jacobians
+//! are propagated analytically along the rollout.
+class StageTrackingCost : public ceres::CostFunction {
+ public:
+  StageTrackingCost(const MpcReference* reference, int stage,
+                    const OptimizationSettings& settings)
+      : reference_(reference), stage_(stage), settings_(settings) {
+    set_num_residuals(kMpcStateSize);
+    for (int i = 0; i < stage_; ++i) {
+      mutable_parameter_block_sizes()->push_back(kMpcControlSize);
     }
+  }
 
-    // differential values
-    // TODO(@all): seperate weights
-    T weights_acc = T(1e1);
-    T weights_delta = T(1);
-    for (int i = 0; i < optimization_settings_.num_optimization_steps - 1;
-         i++) {
-      cost +=
-          weights_acc * parameters[0][i] * parameters[0][i];  // acceleration
-      cost += weights_delta * parameters[1][i] * parameters[1][i];  // steering
+  bool Evaluate(double const* const* parameters, double* residuals,
+                double** jacobians) const override {
+    const double dt = settings_.dt;
+    const double wheel_base = settings_.wheel_base;
+    MpcState state = reference_->initial_state;
+    // sensitivities of the state w.r.t. the controls of the previous stages
+    Eigen::Matrix<double, kMpcStateSize, Eigen::Dynamic> sensitivities;
+    if (jacobians != nullptr) {
+      sensitivities.setZero(kMpcStateSize, kMpcControlSize * stage_);
+    }
+    for (int k = 0; k < stage_; ++k) {
+      const double acceleration = parameters[k][0];
+      const double steering = parameters[k][1];
+      if (jacobians != nullptr) {
+        const double theta = state(2), v = state(3);
+        const double cos_steering = cos(steering);
+        Eigen::Matrix<double, kMpcStateSize, kMpcStateSize> state_jacobian;
+        state_jacobian << 1, 0, -dt * v * sin(theta), dt * cos(theta), 0, 1,
+            dt * v * cos(theta), dt * sin(theta), 0, 0, 1,
+            dt * tan(steering) / wheel_base, 0, 0, 0, 1;
+        const int num_cols = kMpcControlSize * k;
+        sensitivities.leftCols(num_cols) =
+            state_jacobian * sensitivities.leftCols(num_cols);
+        sensitivities.col(num_cols) << 0, 0, 0, dt;
+        sensitivities.col(num_cols + 1) << 0, 0,
+            dt * v / (wheel_base * cos_steering * cos_steering), 0;
+      }
+      state = KinematicStep(state, acceleration, steering, dt, wheel_base);
     }
 
-    residual[0] = cost / (weights.sum() +
-                          (weights_acc + weights_delta) *
-                              T(optimization_settings_.num_optimization_steps));
-    return true;
-  }
-
-  bool set_desired_states(
-      const bark::models::dynamic::Trajectory& desired_states) {
-    desired_discrete_states_ = desired_states;
+    const auto desired = reference_->desired_states.row(stage_ - 1);
+    const auto sqrt_weights = reference_->sqrt_weights.row(stage_ - 1);
+    MpcState error = state - desired.transpose();
+    error(2) = std::remainder(error(2), 2. * M_PI);
+    Eigen::Map<MpcState> residual(residuals);
+    residual = sqrt_weights.transpose().cwiseProduct(error);
+
+    if (jacobians != nullptr) {
+      for (int k = 0; k < stage_; ++k) {
+        if (jacobians[k] == nullptr) continue;
+        Eigen::Map<Eigen::Matrix<double, kMpcStateSize, kMpcControlSize,
+                                 Eigen::RowMajor>>
+            jacobian(jacobians[k]);
+        jacobian = sqrt_weights.transpose().asDiagonal() *
+                   sensitivities.middleCols(kMpcControlSize * k,
+                                            kMpcControlSize);
+      }
+    }
     return true;
   }
 
-  bool set_optimization_settings(
-      const OptimizationSettings& optimization_settings) {
-    optimization_settings_ = optimization_settings;
-    return true;
-  }
+ private:
+  const MpcReference* reference_;
+  int stage_;
+  OptimizationSettings settings_;
+};
 
-  bool set_weights(
-      const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> weights) {
-    weights_ = weights;
+//! weighted acceleration and steering angle of one stage
+class ControlCost
+    : public ceres::SizedCostFunction<kMpcControlSize, kMpcControlSize> {
+ public:
+  explicit ControlCost(const OptimizationSettings& settings)
+      : sqrt_weight_acceleration_(std::sqrt(settings.weight_acceleration)),
+        sqrt_weight_steering_(std::sqrt(settings.weight_steering)) {}
+
+  bool Evaluate(double const* const* parameters, double* residuals,
+                double** jacobians) const override {
+    residuals[0] = sqrt_weight_acceleration_ * parameters[0][0];
+    residuals[1] = sqrt_weight_steering_ * parameters[0][1];
+    if (jacobians != nullptr && jacobians[0] != nullptr) {
+      jacobians[0][0] = sqrt_weight_acceleration_;
+      jacobians[0][1] = 0.;
+      jacobians[0][2] = 0.;
+      jacobians[0][3] = sqrt_weight_steering_;
+    }
     return true;
   }
 
-  bark::models::dynamic::Trajectory desired_discrete_states_;
-  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> weights_;
-  OptimizationSettings optimization_settings_;
+ private:
+  double sqrt_weight_acceleration_;
+  double sqrt_weight_steering_;
 };
 
 }  // namespace execution
@@ -6,169 +6,263 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
-#include <iostream>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "bark/models/execution/mpc/mpc.hpp"
 
 namespace bark {
 namespace models {
+namespace execution {
 
-// TODO(@all) !
-execution::ExecutionModelMpc::ExecutionModelMpc(
-    const bark::commons::ParamsPtr params)
-    : ExecutionModel(params) {
+using dynamic::StateDefinition;
+
+ExecutionModelMpc::ExecutionModelMpc(const commons::ParamsPtr& params)
+    : ExecutionModel(params),
+      has_last_solution_(false),
+      last_start_time_(0.),
+      last_num_iterations_(0),
+      last_solver_time_(0.) {
   optimization_settings_.num_optimization_steps = params->GetInt(
       "NumOptimizationSteps",
       "Number of optimization steps for Execution Optimimizer", 20);
   optimization_settings_.dt = params->GetReal(
       "OptimizationStepSize", "Step Size for Execution Optimimizer", 0.1);
+  optimization_settings_.wheel_base = params->GetReal(
+      "DynamicModel::wheel_base",
+      "Distance between front and rear wheel center", 2.7);
+  optimization_settings_.weight_acceleration = params->GetReal(
+      "WeightAcceleration", "Weight of the squared accelerations", 10.);
+  optimization_settings_.weight_steering = params->GetReal(
+      "WeightSteering", "Weight of the squared steering angles", 1.);
+  optimization_settings_.max_num_iterations = params->GetInt(
+      "MaxNumIterations", "Maximum number of solver iterations per step", 20);
+  optimization_settings_.max_solver_time = params->GetReal(
+      "MaxSolverTime", "Maximum solver time per step in seconds", 0.01);
+  BARK_EXPECT_TRUE(optimization_settings_.num_optimization_steps > 1);
+  controls_.assign(
+      kMpcControlSize * (optimization_settings_.num_optimization_steps - 1),
+      0.);
 }
 
-dynamic::Trajectory execution::ExecutionModelMpc::Execute(
-    const float& new_world_time, const dynamic::Trajectory& trajectory,
-    const dynamic::DynamicModelPtr dynamic_model,
-    const dynamic::State current_state) {
-  double current_world_time = current_state(StateDefinition::TIME_POSITION);
-
-  // initial estimate of atomic element
-  std::vector<double> acceleration, steering_rate;
-
-  for (int i = 0; i < optimization_settings_.num_optimization_steps; i++) {
-    acceleration.push_back(0.0);
-    steering_rate.push_back(0.0);
-  }
+ExecutionModelMpc::ExecutionModelMpc(const ExecutionModelMpc& other)
+    : ExecutionModel(other),
+      optimization_settings_(other.optimization_settings_),
+      last_weights_(other.last_weights_),
+      last_desired_states_(other.last_desired_states_),
+      controls_(other.controls_),
+      reference_(other.reference_),
+      problem_(),
+      has_last_solution_(other.has_last_solution_),
+      last_start_time_(other.last_start_time_),
+      last_num_iterations_(other.last_num_iterations_),
+      last_solver_time_(other.last_solver_time_) {}
 
-  // make parameter_block compatible with ceres-format
-  std::vector<double*> parameter_block;
-  parameter_block.push_back(&acceleration[0]);
-  parameter_block.push_back(&steering_rate[0]);
-
-  dynamic::Trajectory desired_states(
-      optimization_settings_.num_optimization_steps,
-      static_cast<int>(StateDefinition::MIN_STATE_SIZE));
-  desired_states.setZero();
-  desired_states.col(StateDefinition::TIME_POSITION) =
-      Eigen::ArrayXf::LinSpaced(
-          optimization_settings_.num_optimization_steps, current_world_time,
-          current_world_time +
-              (optimization_settings_.num_optimization_steps - 1) *
-                  optimization_settings_.dt);
-
-  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> weights_desired_states(
-      optimization_settings_.num_optimization_steps,
-      static_cast<int>(StateDefinition::MIN_STATE_SIZE));
-  weights_desired_states.setZero();
-  weights_desired_states.col(StateDefinition::TIME_POSITION) =
-      Eigen::ArrayXf::LinSpaced(
-          optimization_settings_.num_optimization_steps, current_world_time,
-          current_world_time +
-              (optimization_settings_.num_optimization_steps - 1) *
-                  optimization_settings_.dt)
-          .cast<double>();
-
-  // get discrete states ready for optimization grid
-  for (int i = 0; i < trajectory.rows(); ++i) {
-    for (int j = 0; j < optimization_settings_.num_optimization_steps; j++) {
-      if (trajectory(i, StateDefinition::TIME_POSITION) ==
-          current_world_time + j * optimization_settings_.dt) {
-        desired_states.row(j) = trajectory.row(i);
-
-        // set weights
-        weights_desired_states(j, StateDefinition::X_POSITION) = 100;
-        weights_desired_states(j, StateDefinition::Y_POSITION) = 100;
-        weights_desired_states(j, StateDefinition::THETA_POSITION) = 100;
-        weights_desired_states(j, StateDefinition::VEL_POSITION) = 0;
-
-        break;
-      }
-    }
+void ExecutionModelMpc::Execute(const float& new_world_time,
+                                const dynamic::Trajectory& trajectory,
+                                const dynamic::DynamicModelPtr dynamic_model) {
+  if (trajectory.rows() == 0) {
+    SetExecutionStatus(ExecutionStatus::INVALID);
+    return;
   }
+  const dynamic::State current_state = trajectory.row(0);
+  const double current_world_time =
+      current_state(StateDefinition::TIME_POSITION);
+  const int num_steps = optimization_settings_.num_optimization_steps;
+  const double dt = optimization_settings_.dt;
 
-  // Overwrite first desired entry with current vehicle state no matter what
-  // planner wants std::cout << "Current State \n" << current_state <<
-  // std::endl;
-
+  dynamic::Trajectory desired_states;
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> weights_desired_states;
+  ResampleOnGrid(trajectory, &desired_states, &weights_desired_states);
+  // the optimization starts at the current state
   desired_states.row(0) = current_state;
-  weights_desired_states(0, StateDefinition::X_POSITION) = 100;
-  weights_desired_states(0, StateDefinition::Y_POSITION) = 100;
-  weights_desired_states(0, StateDefinition::THETA_POSITION) = 100;
-  weights_desired_states(0, StateDefinition::VEL_POSITION) = 0;
 
   dynamic::Trajectory optimized_trajectory =
-      Optimize(parameter_block, desired_states, weights_desired_states);
+      Optimize(desired_states, weights_desired_states);
 
   // safe optimized_trajectory and weights for debugging
   SetLastTrajectory(optimized_trajectory);
   set_last_desired_states(desired_states);
   set_last_weights(weights_desired_states);
 
-  return optimized_trajectory;
+  // the executed state lies on the optimized trajectory
+  const double step = (new_world_time - current_world_time) / dt;
+  if (step < 0. || step > num_steps - 1) {
+    SetExecutionStatus(ExecutionStatus::INVALID);
+    return;
+  }
+  SetExecutionStatus(ExecutionStatus::VALID);
+  const int lower = std::min(static_cast<int>(step), num_steps - 2);
+  const float lambda = step - lower;
+  State state = (1.f - lambda) * optimized_trajectory.row(lower) +
+                lambda * optimized_trajectory.row(lower + 1);
+  SetLastState(state);
 }
 
-dynamic::Trajectory execution::ExecutionModelMpc::Optimize(
-    std::vector<double*> parameter_block,
-    const dynamic::Trajectory& discrete_states,
-    const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>
+dynamic::Trajectory ExecutionModelMpc::Optimize(
+    const dynamic::Trajectory& desired_states,
+    const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>&
         weights_desired_states) {
-  // objective function
-  CostFunctor* cost_functor = new CostFunctor();
-  cost_functor->set_desired_states(discrete_states);
-  cost_functor->set_optimization_settings(optimization_settings_);
-  cost_functor->set_weights(weights_desired_states);
-
-  // Build the problem.
-  ceres::Problem problem;
-
-  // Set up the only cost function (also known as residual). This uses
-  // auto-differentiation to obtain the derivative (jacobian).
-  ceres::DynamicAutoDiffCostFunction<
-      CostFunctor, static_cast<int>(StateDefinition::MIN_STATE_SIZE)>*
-      cost_function = new ceres::DynamicAutoDiffCostFunction<
-          CostFunctor, static_cast<int>(StateDefinition::MIN_STATE_SIZE)>(
-          cost_functor);
-
-  cost_function->AddParameterBlock(
-      optimization_settings_.num_optimization_steps - 1);
-  cost_function->AddParameterBlock(
-      optimization_settings_.num_optimization_steps - 1);
-
-  cost_function->SetNumResiduals(1);
-
-  problem.AddResidualBlock(cost_function, new ceres::TrivialLoss(),
-                           parameter_block);
-
-  // Run the solver!
-  ceres::Solver::Options options;
-  // options.max_num_consecutive_invalid_steps = 1000;
-  options.max_num_iterations = 4000;
-  options.minimizer_type = ceres::MinimizerType::LINE_SEARCH;
-  options.function_tolerance = 10e-8;
-  options.line_search_direction_type = ceres::LineSearchDirectionType::LBFGS;
+  const int num_steps = optimization_settings_.num_optimization_steps;
+  const double start_time =
+      desired_states(0, StateDefinition::TIME_POSITION);
+  if (!problem_) {
+    BuildProblem();
+  }
+  ShiftControls(start_time);
+
+  // the problem reads the reference, only its values change
+  const int columns[kMpcStateSize] = {
+      StateDefinition::X_POSITION, StateDefinition::Y_POSITION,
+      StateDefinition::THETA_POSITION, StateDefinition::VEL_POSITION};
+  for (int c = 0; c < kMpcStateSize; ++c) {
+    reference_.initial_state(c) = desired_states(0, columns[c]);
+    for (int i = 1; i < num_steps; ++i) {
+      reference_.desired_states(i - 1, c) = desired_states(i, columns[c]);
+      reference_.sqrt_weights(i - 1, c) =
+          std::sqrt(weights_desired_states(i, columns[c]));
+    }
+  }
 
-  options.use_inner_iterations = false;
+  // small dense least squares problem, solved with Levenberg-Marquardt
+  ceres::Solver::Options options;
+  options.minimizer_type = ceres::TRUST_REGION;
+  options.trust_region_strategy_type = ceres::LEVENBERG_MARQUARDT;
+  options.linear_solver_type = ceres::DENSE_QR;
+  options.max_num_iterations = optimization_settings_.max_num_iterations;
+  options.max_solver_time_in_seconds = optimization_settings_.max_solver_time;
+  options.function_tolerance = 1e-8;
   options.logging_type = ceres::SILENT;
   options.minimizer_progress_to_stdout = false;
   ceres::Solver::Summary summary;
-  ceres::Solve(options, &problem, &summary);
-  // std::cout << summary.FullReport() << "\n";
+  ceres::Solve(options, problem_.get(), &summary);
+  VLOG(3) << summary.BriefReport();
+  last_num_iterations_ =
+      summary.num_successful_steps + summary.num_unsuccessful_steps;
+  last_solver_time_ = summary.total_time_in_seconds;
+
+  has_last_solution_ = true;
+  last_start_time_ = start_time;
+  return Rollout(start_time);
+}
+
+Matrix<double, Dynamic, kMpcControlSize, Eigen::RowMajor>
+ExecutionModelMpc::GetControls() const {
+  return Eigen::Map<
+      const Matrix<double, Dynamic, kMpcControlSize, Eigen::RowMajor>>(
+      controls_.data(), controls_.size() / kMpcControlSize, kMpcControlSize);
+}
+
+void ExecutionModelMpc::ResampleOnGrid(
+    const dynamic::Trajectory& trajectory, dynamic::Trajectory* desired_states,
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>*
+        weights_desired_states) const {
+  const int num_steps = optimization_settings_.num_optimization_steps;
+  const double dt = optimization_settings_.dt;
+  const double start_time = trajectory(0, StateDefinition::TIME_POSITION);
+  desired_states->setZero(num_steps,
+                          static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  weights_desired_states->setZero(
+      num_steps, static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+
+  // the grid times increase, so the segment search continues from the
+  // previous grid point
+  const int num_rows = trajectory.rows();
+  const double end_time =
+      trajectory(num_rows - 1, StateDefinition::TIME_POSITION);
+  int idx = 0;
+  for (int j = 0; j < num_steps; ++j) {
+    const double t = start_time + j * dt;
+    (*desired_states)(j, StateDefinition::TIME_POSITION) = t;
+    if (num_rows < 2 || t > end_time + 1e-4) continue;
+    while (idx + 2 < num_rows &&
+           trajectory(idx + 1, StateDefinition::TIME_POSITION) < t) {
+      ++idx;
+    }
+    const int next_idx = idx + 1;
+    const double t0 = trajectory(idx, StateDefinition::TIME_POSITION);
+    const double t1 = trajectory(next_idx, StateDefinition::TIME_POSITION);
+    const double lambda =
+        t1 > t0 ? std::min(1., std::max(0., (t - t0) / (t1 - t0))) : 0.;
+    for (int c : {StateDefinition::X_POSITION, StateDefinition::Y_POSITION,
+                  StateDefinition::VEL_POSITION}) {
+      (*desired_states)(j, c) = (1. - lambda) * trajectory(idx, c) +
+                                lambda * trajectory(next_idx, c);
+    }
+    // interpolate the heading along the shorter arc
+    const double theta0 = trajectory(idx, StateDefinition::THETA_POSITION);
+    const double delta_theta = std::remainder(
+        trajectory(next_idx, StateDefinition::THETA_POSITION) - theta0,
+        2. * M_PI);
+    (*desired_states)(j, StateDefinition::THETA_POSITION) =
+        theta0 + lambda * delta_theta;
+
+    // set weights
+    (*weights_desired_states)(j, StateDefinition::X_POSITION) = 100;
+    (*weights_desired_states)(j, StateDefinition::Y_POSITION) = 100;
+    (*weights_desired_states)(j, StateDefinition::THETA_POSITION) = 100;
+    (*weights_desired_states)(j, StateDefinition::VEL_POSITION) = 0;
+  }
+}
 
-  ceres::Problem::EvaluateOptions eval_options;
-  double total_cost = 0.0;
-  std::vector<double> residuals;
-  problem.Evaluate(eval_options, &total_cost, &residuals, nullptr, nullptr);
+void ExecutionModelMpc::BuildProblem() {
+  const int num_stages = optimization_settings_.num_optimization_steps - 1;
+  reference_.desired_states.setZero(num_stages, kMpcStateSize);
+  reference_.sqrt_weights.setZero(num_stages, kMpcStateSize);
 
-  const double* const* const_parameter_block;
-  const_parameter_block =
-      reinterpret_cast<const double* const*>(&parameter_block[0]);
+  // the stage i depends on the controls of the stages 0, ..., i - 1
+  problem_.reset(new ceres::Problem());
+  std::vector<double*> parameter_blocks;
+  for (int stage = 1; stage <= num_stages; ++stage) {
+    parameter_blocks.push_back(&controls_[kMpcControlSize * (stage - 1)]);
+    problem_->AddResidualBlock(
+        new StageTrackingCost(&reference_, stage, optimization_settings_),
+        nullptr, parameter_blocks);
+  }
+  for (double* control : parameter_blocks) {
+    problem_->AddResidualBlock(new ControlCost(optimization_settings_),
+                               nullptr, control);
+  }
+}
 
-  // call kinematic model one last time to get optimized trajectory
-  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> traj =
-      KinematicModel<double>(const_parameter_block, discrete_states,
-                             optimization_settings_);
+void ExecutionModelMpc::ShiftControls(double start_time) {
+  if (!has_last_solution_) return;
+  const int shift = static_cast<int>(std::round(
+      (start_time - last_start_time_) / optimization_settings_.dt));
+  if (shift <= 0) return;
+  const int num_stages = controls_.size() / kMpcControlSize;
+  for (int k = 0; k < num_stages; ++k) {
+    const int source = std::min(k + shift, num_stages - 1);
+    for (int c = 0; c < kMpcControlSize; ++c) {
+      controls_[kMpcControlSize * k + c] =
+          controls_[kMpcControlSize * source + c];
+    }
+  }
+}
 
-  return traj.cast<float>();
+dynamic::Trajectory ExecutionModelMpc::Rollout(double start_time) const {
+  const int num_steps = optimization_settings_.num_optimization_steps;
+  dynamic::Trajectory traj(num_steps,
+                           static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  MpcState state = reference_.initial_state;
+  for (int i = 0; i < num_steps; ++i) {
+    if (i > 0) {
+      state = KinematicStep(state, controls_[kMpcControlSize * (i - 1)],
+                            controls_[kMpcControlSize * (i - 1) + 1],
+                            optimization_settings_.dt,
+                            optimization_settings_.wheel_base);
+    }
+    traj(i, StateDefinition::TIME_POSITION) =
+        start_time + i * optimization_settings_.dt;
+    traj(i, StateDefinition::X_POSITION) = state(0);
+    traj(i, StateDefinition::Y_POSITION) = state(1);
+    traj(i, StateDefinition::THETA_POSITION) = state(2);
+    traj(i, StateDefinition::VEL_POSITION) = state(3);
+  }
+  return traj;
 }
 
+}  // namespace execution
 }  // namespace models
 }  // namespace bark
@@ -10,6 +10,7 @@
 #define BARK_MODELS_EXECUTION_MPC_MPC_HPP_
 
 #include <Eigen/Core>
+#include <memory>
 #include <vector>
 #include "ceres/ceres.h"
 #include "glog/logging.h"
@@ -28,9 +29,16 @@ using dynamic::Trajectory;
 using Eigen::Dynamic;
 using Eigen::Matrix;
 
+//! Tracks the planned trajectory with a kinematic single track model. The
+//! least squares problem has one residual block per stage and is built
+//! once; consecutive optimizations only update the reference and start
+//! from the shifted controls of the previous solution.
 class ExecutionModelMpc : public ExecutionModel {
  public:
   explicit ExecutionModelMpc(const commons::ParamsPtr& params);
+  //! copies the last solution, the problem is rebuilt on first use
+  ExecutionModelMpc(const ExecutionModelMpc& other);
+  ExecutionModelMpc& operator=(const ExecutionModelMpc&) = delete;
 
   ~ExecutionModelMpc() {}
 
@@ -46,26 +54,58 @@ class ExecutionModelMpc : public ExecutionModel {
     last_desired_states_ = desired_states;
   }
 
-  virtual Trajectory Execute(const float& new_world_time,
-                             const Trajectory& trajectory,
-                             const DynamicModelPtr dynamic_model,
-                             const State current_state);
+  //! optimizes from the first state of the trajectory, which is the
+  //! current state of the agent
+  virtual void Execute(const float& new_world_time,
+                       const Trajectory& trajectory,
+                       const DynamicModelPtr dynamic_model);
 
+  //! optimizes the controls from the first desired state; the weights of
+  //! the first row are ignored as the first state is fixed
   Trajectory Optimize(
-      std::vector<double*> parameter_block, const Trajectory& discrete_behavior,
-      const Matrix<double, Dynamic, Dynamic> weights_desired_states);
+      const Trajectory& desired_states,
+      const Matrix<double, Dynamic, Dynamic>& weights_desired_states);
+
+  //! controls of the stages, acceleration and steering angle per row
+  Matrix<double, Dynamic, kMpcControlSize, Eigen::RowMajor> GetControls()
+      const;
+
+  //! iterations and wall time of the last optimization
+  int GetLastNumIterations() const { return last_num_iterations_; }
+  double GetLastSolverTime() const { return last_solver_time_; }
 
   virtual std::shared_ptr<ExecutionModel> Clone() const;
 
  private:
+  //! linearly interpolates the trajectory at the times of the
+  //! optimization grid; grid points outside of the trajectory get a weight
+  //! of zero
+  void ResampleOnGrid(
+      const Trajectory& trajectory, Trajectory* desired_states,
+      Matrix<double, Dynamic, Dynamic>* weights_desired_states) const;
+  void BuildProblem();
+  //! moves the controls by the number of stages that passed since the
+  //! last optimization; the last control is repeated
+  void ShiftControls(double start_time);
+  Trajectory Rollout(double start_time) const;
+
   execution::OptimizationSettings optimization_settings_;
   Matrix<double, Dynamic, Dynamic> last_weights_;
   Trajectory last_desired_states_;
+
+  //! parameter blocks of the problem, kMpcControlSize values per stage
+  std::vector<double> controls_;
+  MpcReference reference_;
+  std::unique_ptr<ceres::Problem> problem_;
+  bool has_last_solution_;
+  double last_start_time_;
+  int last_num_iterations_;
+  double last_solver_time_;
 };
 
 inline std::shared_ptr<ExecutionModel> ExecutionModelMpc::Clone() const {
   std::shared_ptr<ExecutionModelMpc> model_ptr =
-      std::make_shared<ExecutionModelMpc>(*this);
+      commons::MakePooled<ExecutionModelMpc>(*this);
   return std::dynamic_pointer_cast<ExecutionModel>(model_ptr);
 }
 
@@ -0,0 +1,338 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/geometry/standard_shapes.hpp"
+#include "bark/models/behavior/idm/idm_agent_kernels.hpp"
+#include "bark/models/behavior/idm/idm_classic.hpp"
+#include "bark/models/behavior/idm/idm_traffic_batch.hpp"
+#include "bark/models/dynamic/single_track.hpp"
+#include "bark/models/execution/interpolation/interpolate.hpp"
+#include "bark/world/goal_definition/goal_definition_polygon.hpp"
+#include "bark/world/observed_world.hpp"
+#include "bark/world/tests/make_test_world.hpp"
+#include "bark/world/tests/make_test_xodr_map.hpp"
+
+//! counts all heap allocations of the benchmark; Eigen allocates with
+//! std::malloc and operator new uses malloc as well, so the malloc family
+//! is interposed (glibc only)
+static std::size_t num_allocations = 0;
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t num, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+
+void* malloc(std::size_t size) {
+  ++num_allocations;
+  return __libc_malloc(size);
+}
+void* calloc(std::size_t num, std::size_t size) {
+  ++num_allocations;
+  return __libc_calloc(num, size);
+}
+void* realloc(void* ptr, std::size_t size) {
+  ++num_allocations;
+  return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+using bark::commons::SetterParams;
+using bark::geometry::Point2d;
+using bark::geometry::Polygon;
+using bark::geometry::standard_shapes::GenerateGoalRectangle;
+using bark::models::behavior::Action;
+using bark::models::behavior::BaseIDM;
+using bark::models::behavior::BehaviorIDMClassic;
+using bark::models::behavior::IDMClassicStaticModel;
+using bark::models::behavior::IDMRelativeValues;
+using bark::models::behavior::IDMTrafficBatchPlanner;
+using bark::models::behavior::RegisterIDMAgentKernels;
+using bark::models::dynamic::SingleTrackModel;
+using bark::models::dynamic::State;
+using bark::models::dynamic::StateDefinition;
+using bark::models::dynamic::Trajectory;
+using bark::models::execution::ExecutionModelInterpolate;
+using bark::world::ObservedWorld;
+using bark::world::ObservedWorldPtr;
+using bark::world::World;
+using bark::world::WorldPtr;
+using bark::world::goal_definition::GoalDefinitionPolygon;
+using bark::world::map::LaneCorridorPtr;
+using bark::world::map::MapInterface;
+using bark::world::map::MapInterfacePtr;
+using bark::world::objects::Agent;
+using bark::world::objects::AgentKernelRegistry;
+using bark::world::objects::AgentPtr;
+using bark::world::tests::make_test_observed_world;
+
+ObservedWorld MakeBenchmarkWorld() {
+  Polygon polygon = GenerateGoalRectangle(6, 3);
+  std::shared_ptr<Polygon> goal_polygon(
+      std::dynamic_pointer_cast<Polygon>(polygon.Translate(Point2d(50, -2))));
+  auto goal_definition = std::make_shared<GoalDefinitionPolygon>(*goal_polygon);
+  return make_test_observed_world(1, 10.0, 8.0, 2.0, goal_definition);
+}
+
+TEST(behavior_idm_benchmark, generate_trajectory_allocations) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetInt("BehaviorIDMClassic::NumTrajectoryTimePoints", 51);
+  BehaviorIDMClassic behavior(params);
+  ObservedWorld observed_world = MakeBenchmarkWorld();
+  LaneCorridorPtr lane_corridor = observed_world.GetLaneCorridor();
+  ASSERT_TRUE(lane_corridor);
+  IDMRelativeValues rel_values =
+      behavior.CalcRelativeValues(observed_world, lane_corridor);
+  const double dt = 0.1;
+
+  // the first call sizes the trajectory buffer
+  Trajectory traj;
+  behavior.GenerateTrajectoryInPlace(observed_world, lane_corridor, rel_values,
+                                     dt, &traj);
+  const int num_runs = 10000;
+  const std::size_t allocations_before = num_allocations;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_runs; ++i) {
+    behavior.GenerateTrajectoryInPlace(observed_world, lane_corridor,
+                                       rel_values, dt, &traj);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  const std::size_t steady_state_allocations =
+      num_allocations - allocations_before;
+  EXPECT_EQ(steady_state_allocations, 0u);
+
+  for (int i = 0; i < num_runs; ++i) {
+    std::tuple<Trajectory, Action> traj_action = behavior.GenerateTrajectory(
+        observed_world, lane_corridor, rel_values, dt);
+    EXPECT_TRUE(std::get<0>(traj_action).isApprox(traj));
+  }
+  auto t2 = std::chrono::steady_clock::now();
+#ifdef __GLIBC__
+  // the counter sees the trajectories allocated by Eigen
+  EXPECT_GE(num_allocations - allocations_before,
+            static_cast<std::size_t>(num_runs));
+#endif
+
+  const double in_place_us =
+      std::chrono::duration<double, std::micro>(t1 - t0).count() / num_runs;
+  const double tuple_us =
+      std::chrono::duration<double, std::micro>(t2 - t1).count() / num_runs;
+  std::cout << "GenerateTrajectoryInPlace: " << in_place_us << " us, "
+            << "GenerateTrajectory: " << tuple_us << " us per call"
+            << std::endl;
+}
+
+TEST(behavior_idm_benchmark, plan) {
+  auto params = std::make_shared<SetterParams>();
+  BehaviorIDMClassic behavior(params);
+  ObservedWorld observed_world = MakeBenchmarkWorld();
+
+  const int num_runs = 10000;
+  behavior.Plan(0.2, observed_world);
+  const std::size_t allocations_before = num_allocations;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_runs; ++i) behavior.Plan(0.2, observed_world);
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "BehaviorIDMClassic::Plan: "
+            << std::chrono::duration<double, std::micro>(t1 - t0).count() /
+                   num_runs
+            << " us, "
+            << static_cast<double>(num_allocations - allocations_before) /
+                   num_runs
+            << " allocations per call" << std::endl;
+}
+
+//! dense IDM traffic on both lanes of a 200 m two lane road
+WorldPtr MakeIDMTrafficWorld(const std::shared_ptr<SetterParams>& params,
+                             int num_agents_per_lane) {
+  MapInterfacePtr map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(
+      bark::world::tests::MakeXodrMapOneRoadTwoLanes());
+  Polygon polygon = GenerateGoalRectangle(6, 3);
+  std::shared_ptr<Polygon> goal_polygon(
+      std::dynamic_pointer_cast<Polygon>(polygon.Translate(Point2d(190, -2))));
+  auto goal_definition = std::make_shared<GoalDefinitionPolygon>(*goal_polygon);
+  WorldPtr world = std::make_shared<World>(params);
+  for (int i = 0; i < num_agents_per_lane; ++i) {
+    for (float y : {-1.75f, -5.25f}) {
+      State init_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+      init_state << 0.0, 2.0 + i * 170.0 / num_agents_per_lane, y, 0.0,
+          6.0 + (i % 5);
+      AgentPtr agent(new Agent(
+          init_state, std::make_shared<BehaviorIDMClassic>(params),
+          std::make_shared<SingleTrackModel>(params),
+          std::make_shared<ExecutionModelInterpolate>(params),
+          bark::geometry::standard_shapes::CarRectangle(), params,
+          goal_definition, map_interface, bark::geometry::Model3D()));
+      world->AddAgent(agent);
+    }
+  }
+  world->UpdateAgentRTree();
+  world->SetMap(map_interface);
+  return world;
+}
+
+TEST(behavior_idm_benchmark, traffic_batch_planner) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetInt("BehaviorIDMClassic::NumTrajectoryTimePoints", 51);
+  params->SetBool("BehaviorIDMClassic::BrakeForLaneEnd", false);
+  WorldPtr individual_world = MakeIDMTrafficWorld(params, 20);
+  WorldPtr batched_world(individual_world->Clone());
+  IDMTrafficBatchPlanner batch_planner;
+
+  const int num_runs = 200;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_runs; ++i) {
+    for (const auto& agent : individual_world->GetAgents()) {
+      ObservedWorld observed_world(individual_world, agent.first);
+      agent.second->PlanBehavior(0.2, observed_world);
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_runs; ++i) {
+    batch_planner.PlanBehaviors(0.2, batched_world->GetAgents(),
+                                batched_world);
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  EXPECT_EQ(batch_planner.GetNumPlannedAgents(), 40u);
+
+  for (const auto& agent : individual_world->GetAgents()) {
+    EXPECT_TRUE(agent.second->GetBehaviorTrajectory() ==
+                batched_world->GetAgent(agent.first)->GetBehaviorTrajectory());
+  }
+  std::cout << "40 IDM agents, per agent planning: "
+            << std::chrono::duration<double, std::micro>(t1 - t0).count() /
+                   num_runs
+            << " us, IDMTrafficBatchPlanner: "
+            << std::chrono::duration<double, std::micro>(t2 - t1).count() /
+                   num_runs
+            << " us per step" << std::endl;
+}
+
+TEST(behavior_idm_benchmark, agent_kernels) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetInt("BehaviorIDMClassic::NumTrajectoryTimePoints", 51);
+  params->SetBool("BehaviorIDMClassic::BrakeForLaneEnd", false);
+  WorldPtr polymorphic_world = MakeIDMTrafficWorld(params, 20);
+  WorldPtr kernel_world(polymorphic_world->Clone());
+  RegisterIDMAgentKernels();
+  for (const auto& agent : kernel_world->GetAgents()) {
+    ASSERT_TRUE(agent.second->GetAgentKernel());
+  }
+  AgentKernelRegistry::Clear();
+
+  // the observed worlds are made once, so only plan and execution are timed
+  auto make_observed_worlds = [](const WorldPtr& world) {
+    std::vector<std::pair<AgentPtr, ObservedWorld>> observed_worlds;
+    for (const auto& agent : world->GetAgents()) {
+      observed_worlds.emplace_back(agent.second,
+                                   ObservedWorld(world, agent.first));
+    }
+    return observed_worlds;
+  };
+  auto polymorphic_agents = make_observed_worlds(polymorphic_world);
+  auto kernel_agents = make_observed_worlds(kernel_world);
+
+  // the runs alternate, so that both see the same state of the machine
+  const int num_runs = 200;
+  std::chrono::duration<double, std::micro> polymorphic_time(0.0),
+      kernel_time(0.0);
+  for (int i = 0; i < num_runs; ++i) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (auto& agent : polymorphic_agents) {
+      agent.first->Plan(0.2, 0.2, agent.second);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (auto& agent : kernel_agents) {
+      agent.first->Plan(0.2, 0.2, agent.second);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    polymorphic_time += t1 - t0;
+    kernel_time += t2 - t1;
+  }
+  for (const auto& agent : polymorphic_world->GetAgents()) {
+    EXPECT_TRUE(agent.second->GetExecutionTrajectory() ==
+                kernel_world->GetAgent(agent.first)->GetExecutionTrajectory());
+  }
+  std::cout << "40 IDM agents, polymorphic plan and execution: "
+            << polymorphic_time.count() / num_runs
+            << " us, IDMClassicAgentKernel: " << kernel_time.count() / num_runs
+            << " us per step" << std::endl;
+
+  // the trajectory integration on its own, which the kernel calls without
+  // virtual dispatch; the cast hides the type of the IDM from the compiler
+  std::shared_ptr<BaseIDM> idm = std::dynamic_pointer_cast<BaseIDM>(
+      std::make_shared<BehaviorIDMClassic>(params)->Clone());
+  const BehaviorIDMClassic& idm_classic =
+      dynamic_cast<const BehaviorIDMClassic&>(*idm);
+  ObservedWorld observed_world = MakeBenchmarkWorld();
+  LaneCorridorPtr lane_corridor = observed_world.GetLaneCorridor();
+  ASSERT_TRUE(lane_corridor);
+  IDMRelativeValues rel_values =
+      idm->CalcRelativeValues(observed_world, lane_corridor);
+  Trajectory polymorphic_traj, kernel_traj;
+  const int num_integrations = 10000;
+  polymorphic_time = kernel_time = polymorphic_time.zero();
+  for (int i = 0; i < num_integrations; ++i) {
+    auto t0 = std::chrono::steady_clock::now();
+    idm->GenerateTrajectoryInPlace(observed_world, lane_corridor, rel_values,
+                                   0.004, &polymorphic_traj);
+    auto t1 = std::chrono::steady_clock::now();
+    IDMClassicStaticModel(idm_classic)
+        .GenerateTrajectoryInPlace(observed_world, lane_corridor, rel_values,
+                                   0.004, &kernel_traj);
+    auto t2 = std::chrono::steady_clock::now();
+    polymorphic_time += t1 - t0;
+    kernel_time += t2 - t1;
+  }
+  EXPECT_TRUE(polymorphic_traj == kernel_traj);
+  std::cout << "IDM integration, polymorphic: "
+            << polymorphic_time.count() / num_integrations
+            << " us, IDMClassicStaticModel: "
+            << kernel_time.count() / num_integrations << " us per call"
+            << std::endl;
+}
+
+TEST(behavior_idm_benchmark, traffic_checkpoint_rollback) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetBool("BehaviorIDMClassic::BrakeForLaneEnd", false);
+  WorldPtr world = MakeIDMTrafficWorld(params, 20);
+  ObservedWorld observed_world(world, world->GetAgents().begin()->first);
+
+  const int num_runs = 200;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_runs; ++i) {
+    ObservedWorldPtr predicted_world = observed_world.Predict(0.2f);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_runs; ++i) {
+    observed_world.Checkpoint();
+    observed_world.Step(0.2f);
+    observed_world.Rollback();
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  EXPECT_EQ(observed_world.GetNumCheckpoints(), 0u);
+  EXPECT_NEAR(observed_world.GetWorldTime(), 0.0, 1e-6);
+
+  std::cout << "40 IDM agents, Predict: "
+            << std::chrono::duration<double, std::micro>(t1 - t0).count() /
+                   num_runs
+            << " us, Checkpoint + Step + Rollback: "
+            << std::chrono::duration<double, std::micro>(t2 - t1).count() /
+                   num_runs
+            << " us per step" << std::endl;
+}
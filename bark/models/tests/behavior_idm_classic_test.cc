@@ -14,7 +14,12 @@
 #include "bark/geometry/line.hpp"
 #include "bark/geometry/polygon.hpp"
 #include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
+#include "bark/models/behavior/idm/idm_agent_kernels.hpp"
 #include "bark/models/behavior/idm/idm_classic.hpp"
+#include "bark/models/behavior/idm/idm_lane_tracking.hpp"
+#include "bark/models/behavior/idm/idm_traffic_batch.hpp"
+#include "bark/models/behavior/idm/stochastic/idm_stochastic.hpp"
+#include "bark/models/dynamic/single_track.hpp"
 #include "bark/models/execution/interpolation/interpolate.hpp"
 #include "bark/world/observed_world.hpp"
 #include "bark/world/tests/make_test_world.hpp"
@@ -485,6 +490,164 @@ TEST(CalcNetDistance, behavior_idm_classic) {
   EXPECT_EQ(distance, distance_expected);
 }
 
+//! IDM agents on both lanes of a two lane road and a slow leading agent
+WorldPtr MakeIDMTrafficWorld(const ParamsPtr& params) {
+  OpenDriveMapPtr open_drive_map =
+      bark::world::tests::MakeXodrMapOneRoadTwoLanes();
+  MapInterfacePtr map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(open_drive_map);
+
+  Polygon shape = bark::geometry::standard_shapes::CarRectangle();
+  Polygon polygon = GenerateGoalRectangle(6, 3);
+  std::shared_ptr<Polygon> goal_polygon(
+      std::dynamic_pointer_cast<Polygon>(polygon.Translate(Point2d(190, -2))));
+  auto goal_definition_ptr =
+      std::make_shared<GoalDefinitionPolygon>(*goal_polygon);
+
+  WorldPtr world(new World(params));
+  auto add_agent = [&](const BehaviorModelPtr& behavior, float x, float y,
+                       float vel) {
+    State init_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+    init_state << 0.0, x, y, 0.0, vel;
+    AgentPtr agent(new Agent(
+        init_state, behavior, std::make_shared<SingleTrackModel>(params),
+        std::make_shared<ExecutionModelInterpolate>(params), shape, params,
+        goal_definition_ptr, map_interface, bark::geometry::Model3D()));
+    world->AddAgent(agent);
+  };
+  // IDM agents on both lanes and a slow leading agent on the right lane
+  for (int i = 0; i < 4; ++i) {
+    add_agent(std::make_shared<BehaviorIDMClassic>(params), 5.0 + i * 12.0,
+              -1.75, 8.0 + i);
+    add_agent(std::make_shared<BehaviorIDMLaneTracking>(params), 3.0 + i * 15.0,
+              -5.25, 12.0 - i);
+  }
+  add_agent(std::make_shared<BehaviorConstantAcceleration>(params), 60.0,
+            -1.75, 4.0);
+  world->UpdateAgentRTree();
+  world->SetMap(map_interface);
+  return world;
+}
+
+TEST(traffic_batch_planner, behavior_idm_classic) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetBool("BehaviorIDMClassic::BrakeForLaneEnd", false);
+  WorldPtr world = MakeIDMTrafficWorld(params);
+
+  WorldPtr individual_world(world->Clone());
+  WorldPtr batched_world(world->Clone());
+  auto batch_planner = std::make_shared<IDMTrafficBatchPlanner>();
+  batched_world->SetAgentBatchPlanner(batch_planner);
+
+  for (int step = 0; step < 20; ++step) {
+    individual_world->Step(0.2);
+    batched_world->Step(0.2);
+    EXPECT_EQ(batch_planner->GetNumPlannedAgents(), 8u);
+    for (const auto& agent : individual_world->GetAgents()) {
+      AgentPtr batched_agent = batched_world->GetAgent(agent.first);
+      ASSERT_TRUE(batched_agent);
+      EXPECT_TRUE(
+          agent.second->GetCurrentState() == batched_agent->GetCurrentState());
+    }
+  }
+
+  // the concurrently predicted worlds plan with their own planner
+  ObservedWorld observed_world(batched_world,
+                               batched_world->GetAgents().begin()->first);
+  std::vector<BehaviorHypothesisMap> hypotheses(3);
+  for (const auto& next_world : observed_world.PredictBatch(0.2, hypotheses)) {
+    auto branch_planner = std::dynamic_pointer_cast<IDMTrafficBatchPlanner>(
+        next_world->GetAgentBatchPlanner());
+    ASSERT_TRUE(branch_planner);
+    EXPECT_NE(branch_planner, batch_planner);
+    EXPECT_EQ(branch_planner->GetNumPlannedAgents(), 8u);
+  }
+}
+
+TEST(stochastic_sampling, behavior_idm_classic) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetInt("BehaviorIDMStochastic::ResamplingPeriod", 3);
+  params->SetBool("BehaviorIDMStochastic::UseRandomStreams", true);
+  ObservedWorld observed_world = make_test_observed_world(1, 20.0, 5.0, 0.0);
+  AgentId ego_id = observed_world.GetEgoAgentId();
+  AgentId other_id = ego_id;
+  for (const auto& agent : observed_world.GetAgents()) {
+    if (agent.first != ego_id) other_id = agent.first;
+  }
+  ASSERT_NE(ego_id, other_id);
+  ObservedWorld other_observed_world = observed_world;
+  other_observed_world.SetEgoAgentId(other_id);
+
+  // the parameters are resampled every third planning step
+  BehaviorIDMStochastic behavior(params);
+  std::vector<double> desired_velocities;
+  for (int i = 0; i < 6; ++i) {
+    behavior.Plan(0.2, observed_world);
+    desired_velocities.push_back(behavior.GetDesiredVelocity());
+  }
+  EXPECT_EQ(desired_velocities[0], desired_velocities[2]);
+  EXPECT_NE(desired_velocities[2], desired_velocities[3]);
+  EXPECT_EQ(desired_velocities[3], desired_velocities[5]);
+
+  // the samples only depend on the agent and the number of sampling events
+  BehaviorIDMStochastic other_behavior(params);
+  BehaviorIDMStochastic ego_behavior(params);
+  other_behavior.Plan(0.2, other_observed_world);
+  ego_behavior.Plan(0.2, observed_world);
+  EXPECT_EQ(ego_behavior.GetDesiredVelocity(), desired_velocities[0]);
+  EXPECT_NE(other_behavior.GetDesiredVelocity(), desired_velocities[0]);
+
+  // sampling once per episode
+  params->SetInt("BehaviorIDMStochastic::ResamplingPeriod", 0);
+  BehaviorIDMStochastic episode_behavior(params);
+  episode_behavior.Plan(0.2, observed_world);
+  const double desired_velocity = episode_behavior.GetDesiredVelocity();
+  for (int i = 0; i < 5; ++i) {
+    episode_behavior.Plan(0.2, observed_world);
+    EXPECT_EQ(episode_behavior.GetDesiredVelocity(), desired_velocity);
+  }
+}
+
+TEST(agent_kernels, behavior_idm_classic) {
+  using bark::world::objects::AgentKernelRegistry;
+  auto params = std::make_shared<SetterParams>();
+  params->SetBool("BehaviorIDMClassic::BrakeForLaneEnd", false);
+  WorldPtr world = MakeIDMTrafficWorld(params);
+  WorldPtr polymorphic_world(world->Clone());
+  WorldPtr kernel_world(world->Clone());
+
+  // agents keep the kernels they have bound while they are registered
+  RegisterIDMAgentKernels();
+  std::size_t num_kernel_agents = 0;
+  for (const auto& agent : kernel_world->GetAgents()) {
+    if (agent.second->GetAgentKernel()) ++num_kernel_agents;
+  }
+  AgentKernelRegistry::Clear();
+  // derived IDMs, e.g. BehaviorIDMLaneTracking, do not match
+  EXPECT_EQ(num_kernel_agents, 4u);
+  for (const auto& agent : polymorphic_world->GetAgents()) {
+    EXPECT_FALSE(agent.second->GetAgentKernel());
+  }
+
+  for (int step = 0; step < 20; ++step) {
+    polymorphic_world->Step(0.2);
+    kernel_world->Step(0.2);
+    for (const auto& agent : polymorphic_world->GetAgents()) {
+      AgentPtr kernel_agent = kernel_world->GetAgent(agent.first);
+      ASSERT_TRUE(kernel_agent);
+      EXPECT_TRUE(agent.second->GetCurrentState() ==
+                  kernel_agent->GetCurrentState());
+    }
+  }
+
+  // replacing a model drops the kernel
+  for (const auto& agent : kernel_world->GetAgents()) {
+    if (!agent.second->GetAgentKernel()) continue;
+    agent.second->SetExecutionModel(agent.second->GetExecutionModel()->Clone());
+    EXPECT_FALSE(agent.second->GetAgentKernel());
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,151 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <cmath>
+#include "gtest/gtest.h"
+
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/geometry/polygon.hpp"
+#include "bark/geometry/standard_shapes.hpp"
+#include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
+#include "bark/models/behavior/constant_acceleration/constant_acceleration_prediction.hpp"
+#include "bark/models/behavior/rule_based/intersection_behavior.hpp"
+#include "bark/models/dynamic/single_track.hpp"
+#include "bark/models/execution/interpolation/interpolate.hpp"
+#include "bark/world/goal_definition/goal_definition_polygon.hpp"
+#include "bark/world/observed_world.hpp"
+#include "bark/world/tests/make_test_xodr_map.hpp"
+
+using namespace bark::models::dynamic;
+using namespace bark::models::execution;
+using namespace bark::commons;
+using namespace bark::models::behavior;
+using namespace bark::world::map;
+
+using bark::geometry::Model3D;
+using bark::geometry::Point2d;
+using bark::geometry::Polygon;
+using bark::geometry::standard_shapes::CarRectangle;
+using bark::geometry::standard_shapes::GenerateGoalRectangle;
+using bark::world::ObservedWorld;
+using bark::world::ObservedWorldPtr;
+using bark::world::World;
+using bark::world::WorldPtr;
+using bark::world::goal_definition::GoalDefinitionPolygon;
+using bark::world::objects::Agent;
+using bark::world::objects::AgentPtr;
+using bark::world::prediction::PredictionSettings;
+using bark::world::tests::MakeXodrMapOneRoadTwoLanes;
+
+// the ego agent has the id 0; the states of the other agents are given as
+// (x, y, theta, velocity)
+ObservedWorld MakeIntersectionTestWorld(
+    const ParamsPtr& params, const std::vector<std::vector<double>>& states) {
+  auto map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(MakeXodrMapOneRoadTwoLanes());
+  Polygon polygon = GenerateGoalRectangle(6, 3);
+  std::shared_ptr<Polygon> goal_polygon(
+      std::dynamic_pointer_cast<Polygon>(polygon.Translate(Point2d(150, -2))));
+  auto goal_definition_ptr =
+      std::make_shared<GoalDefinitionPolygon>(*goal_polygon);
+
+  WorldPtr world(new World(params));
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    State init_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+    init_state << 0.0, states[i][0], states[i][1], states[i][2], states[i][3];
+    BehaviorModelPtr behavior =
+        i == 0 ? BehaviorModelPtr(new BehaviorIntersectionRuleBased(params))
+               : BehaviorModelPtr(new BehaviorConstantAcceleration(params));
+    AgentPtr agent(new Agent(
+        init_state, behavior, std::make_shared<SingleTrackModel>(params),
+        std::make_shared<ExecutionModelInterpolate>(params), CarRectangle(),
+        params, goal_definition_ptr, map_interface, Model3D()));
+    agent->SetAgentId(i);
+    world->AddAgent(agent);
+  }
+  world->UpdateAgentRTree();
+  WorldPtr current_world_state(world->Clone());
+  return ObservedWorld(current_world_state, 0);
+}
+
+TEST(constant_acceleration_prediction, equals_world_prediction) {
+  auto params = std::make_shared<SetterParams>();
+  ObservedWorld observed_world = MakeIntersectionTestWorld(
+      params, {{10.0, -1.75, 0.0, 8.0},
+               {25.0, -1.8, 0.1, 12.0},
+               {5.0, -5.25, -0.05, 3.0},
+               {40.0, -4.5, 1.2, 0.5}});
+
+  auto prediction_params = std::make_shared<SetterParams>();
+  prediction_params->SetReal("BehaviorConstantAcceleration::ConstAcceleration",
+                             -1.0);
+  BehaviorConstantAcceleration prediction_model(prediction_params);
+  ConstantAccelerationPrediction prediction(observed_world, prediction_model);
+
+  ObservedWorldPtr tmp_observed_world =
+      std::dynamic_pointer_cast<ObservedWorld>(observed_world.Clone());
+  BehaviorModelPtr prediction_model_ptr(
+      new BehaviorConstantAcceleration(prediction_params));
+  tmp_observed_world->SetupPrediction(
+      PredictionSettings(prediction_model_ptr, prediction_model_ptr));
+
+  for (double t = 0.; t < 5.0; t += 0.5) {
+    ObservedWorldPtr predicted_world = tmp_observed_world->Predict(t);
+    for (const auto& agent : predicted_world->GetAgents()) {
+      State state;
+      ASSERT_TRUE(prediction.PredictState(agent.first, t, &state));
+      const State& expected = agent.second->GetCurrentState();
+      for (int i = 0; i < StateDefinition::MIN_STATE_SIZE; ++i) {
+        EXPECT_NEAR(state(i), expected(i), 1e-5) << "t = " << t;
+      }
+      // the footprints stay within the swept bounding box
+      BoundingBox swept_box;
+      ASSERT_TRUE(
+          prediction.GetSweptBoundingBox(agent.first, 5.0, &swept_box));
+      BoundingBox footprint_box;
+      boost::geometry::envelope(agent.second->GetPolygonFromState(state).obj_,
+                                footprint_box);
+      EXPECT_TRUE(boost::geometry::covered_by(footprint_box, swept_box));
+    }
+  }
+}
+
+TEST(behavior_intersection, check_intersecting_vehicles) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetReal("BehaviorIntersectionRuleBased::BrakingDistance", 15.0);
+
+  // agent 1 drives in the other lane and is not intersecting
+  // agent 2 stands across both lanes in front of the ego agent
+  ObservedWorld observed_world = MakeIntersectionTestWorld(
+      params, {{10.0, -1.75, 0.0, 8.0},
+               {20.0, -5.25, 0.0, 8.0},
+               {22.0, -5.0, M_PI / 2., 0.0}});
+  BehaviorIntersectionRuleBased behavior(params);
+  behavior.SetLaneCorridor(observed_world.GetLaneCorridor());
+  std::tuple<double, AgentPtr> time_agent =
+      behavior.CheckIntersectingVehicles(observed_world);
+  ASSERT_TRUE(std::get<1>(time_agent));
+  EXPECT_EQ(std::get<1>(time_agent)->GetAgentId(), 2u);
+  EXPECT_EQ(std::get<0>(time_agent), 0.);
+
+  // agents that are not valid are no conflicts
+  observed_world.GetAgent(2)->GetBehaviorModel()->SetBehaviorStatus(
+      BehaviorStatus::EXPIRED);
+  time_agent = behavior.CheckIntersectingVehicles(observed_world);
+  EXPECT_FALSE(std::get<1>(time_agent));
+
+  ObservedWorld parallel_world = MakeIntersectionTestWorld(
+      params, {{10.0, -1.75, 0.0, 8.0}, {20.0, -5.25, 0.0, 8.0}});
+  time_agent = behavior.CheckIntersectingVehicles(parallel_world);
+  EXPECT_FALSE(std::get<1>(time_agent));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,7 @@
 #include "bark/geometry/polygon.hpp"
 #include "bark/models/behavior/motion_primitives/continuous_actions.hpp"
 #include "bark/models/behavior/motion_primitives/macro_actions.hpp"
+#include "bark/models/behavior/motion_primitives/primitive_library.hpp"
 #include "bark/models/behavior/motion_primitives/primitives/primitive.hpp"
 #include "bark/models/behavior/motion_primitives/primitives/primitive_const_acc_change_to_left.hpp"
 #include "bark/models/behavior/motion_primitives/primitives/primitive_const_acc_change_to_right.hpp"
@@ -45,7 +46,7 @@ class DummyObservedWorld : public ObservedWorld {
     AddAgent(agent);
   }
 
-  virtual State CurrentEgoState() const { return init_state_; }
+  virtual const State& CurrentEgoState() const { return init_state_; }
 
   virtual double GetWorldTime() const { return 0.0f; }
 
@@ -123,9 +124,113 @@ TEST(behavior_motion_primitives_plan, behavior_test) {
               0.005);
 }
 
+TEST(primitive_library, equals_integration) {
+  auto params = std::make_shared<SetterParams>();
+  SingleTrackModel dynamics(params);
+  std::vector<Input> inputs;
+  Input u(2);
+  u << 2, 0;
+  inputs.push_back(u);
+  u << -1, 0.2;
+  inputs.push_back(u);
+  u << 0, -0.1;
+  inputs.push_back(u);
+
+  MotionPrimitiveLibrary library(dynamics, inputs, 0.5, 0.02, 0.0, 20.0, 0.5);
+  EXPECT_EQ(library.GetNumPrimitives(), 3u);
+  EXPECT_EQ(library.GetNumVelocities(), 41u);
+
+  // exact for velocities on the grid, independent of the start pose
+  State start_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  start_state << 1.0, 10.0, -5.0, 0.7, 8.0;
+  Trajectory trajectory;
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    ASSERT_TRUE(library.GetTrajectory(i, start_state, &trajectory));
+    Trajectory expected =
+        IntegratePrimitive(dynamics, start_state, inputs[i], 0.5, 0.02);
+    ASSERT_EQ(trajectory.rows(), expected.rows());
+    for (int r = 0; r < expected.rows(); ++r) {
+      for (int c = 0; c < StateDefinition::MIN_STATE_SIZE; ++c) {
+        EXPECT_NEAR(trajectory(r, c), expected(r, c), 1e-4);
+      }
+    }
+  }
+
+  // the interpolation error shrinks with the velocity resolution
+  MotionPrimitiveLibrary fine_library(dynamics, inputs, 0.5, 0.02, 0.0, 20.0,
+                                      0.1);
+  const double error = library.CalculateMaxPositionError(dynamics);
+  const double fine_error = fine_library.CalculateMaxPositionError(dynamics);
+  EXPECT_LT(error, 0.01);
+  EXPECT_LE(fine_error, error);
+
+  // velocities outside of the library are not covered
+  start_state << 0.0, 0.0, 0.0, 0.0, 25.0;
+  EXPECT_FALSE(library.GetTrajectory(0, start_state, &trajectory));
+}
+
+TEST(behavior_motion_primitives_plan, primitive_library) {
+  auto params = std::make_shared<SetterParams>();
+  auto library_params = std::make_shared<SetterParams>();
+  library_params->SetBool("BehaviorMPContinuousActions::UsePrimitiveLibrary",
+                          true);
+  BehaviorMPContinuousActions behavior(params);
+  BehaviorMPContinuousActions library_behavior(library_params);
+  Input u(2);
+  u << 1, 0.1;
+  behavior.AddMotionPrimitive(u);
+  library_behavior.AddMotionPrimitive(u);
+
+  State init_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  for (float velocity : {0.0, 4.1, 12.6, 35.0}) {
+    init_state << 0.0, 3.0, 2.0, -0.4, velocity;
+    DummyObservedWorld world(init_state, params);
+    behavior.ActionToBehavior(DiscreteAction(0));
+    library_behavior.ActionToBehavior(DiscreteAction(0));
+    Trajectory traj = behavior.Plan(0.5, world);
+    Trajectory library_traj = library_behavior.Plan(0.5, world);
+    ASSERT_EQ(traj.rows(), library_traj.rows());
+    EXPECT_NEAR(traj(traj.rows() - 1, StateDefinition::X_POSITION),
+                library_traj(traj.rows() - 1, StateDefinition::X_POSITION),
+                0.01);
+    EXPECT_NEAR(traj(traj.rows() - 1, StateDefinition::Y_POSITION),
+                library_traj(traj.rows() - 1, StateDefinition::Y_POSITION),
+                0.01);
+  }
+}
+
+TEST(behavior_motion_primitives_plan, primitive_library_model) {
+  auto params = std::make_shared<SetterParams>();
+  auto long_params = std::make_shared<SetterParams>();
+  long_params->SetReal("DynamicModel::wheel_base", 4.0);
+  SingleTrackModel dynamics(params);
+  SingleTrackModel long_dynamics(long_params);
+  BehaviorMPContinuousActions behavior(params);
+  Input u(2);
+  u << 1, 0.1;
+  behavior.AddMotionPrimitive(u);
+
+  auto library = behavior.GetPrimitiveLibrary(dynamics, 0.5);
+  EXPECT_EQ(behavior.GetPrimitiveLibrary(dynamics, 0.5), library);
+
+  // a different wheel base requires new trajectories
+  auto long_library = behavior.GetPrimitiveLibrary(long_dynamics, 0.5);
+  EXPECT_NE(long_library, library);
+  State start_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  start_state << 0.0, 0.0, 0.0, 0.0, 10.0;
+  Trajectory trajectory;
+  ASSERT_TRUE(long_library->GetTrajectory(0, start_state, &trajectory));
+  Trajectory expected =
+      IntegratePrimitive(long_dynamics, start_state, u, 0.5, 0.02);
+  const int last = expected.rows() - 1;
+  EXPECT_NEAR(trajectory(last, StateDefinition::THETA_POSITION),
+              expected(last, StateDefinition::THETA_POSITION), 1e-4);
+}
+
 TEST(primitive_constant_acceleration, behavior_test) {
   using bark::models::behavior::primitives::AdjacentLaneCorridors;
   using bark::models::behavior::primitives::PrimitiveConstAccStayLane;
+  using bark::models::behavior::primitives::PrimitiveContext;
   auto params = std::make_shared<SetterParams>();
   DynamicModelPtr dynamics(new SingleTrackModel(params));
   PrimitiveConstAccStayLane primitive(params, 0);
@@ -134,13 +239,14 @@ TEST(primitive_constant_acceleration, behavior_test) {
   std::const_pointer_cast<Agent>(world1.GetEgoAgent())
       ->SetDynamicModel(dynamics);
   AdjacentLaneCorridors corridors = GetCorridors(world1);
-  EXPECT_TRUE(primitive.IsPreConditionSatisfied(world1, corridors));
+  PrimitiveContext context1(world1, corridors);
+  EXPECT_TRUE(primitive.IsPreConditionSatisfied(world1, context1));
   auto traj1 = primitive.Plan(0.5, world1, corridors.current);
   EXPECT_NEAR(traj1(traj1.rows() - 1, StateDefinition::X_POSITION),
               traj1(0, StateDefinition::X_POSITION) + 5.0 * 0.5, 0.1);
 
   PrimitiveConstAccStayLane dec_primitive(params, -5.0);
-  EXPECT_TRUE(dec_primitive.IsPreConditionSatisfied(world1, corridors));
+  EXPECT_TRUE(dec_primitive.IsPreConditionSatisfied(world1, context1));
   auto traj2 = dec_primitive.Plan(0.5, world1, corridors.current);
   EXPECT_NEAR(traj2(traj2.rows() - 1, StateDefinition::X_POSITION),
               traj2(0, StateDefinition::X_POSITION) + 5.0 * 0.5 +
@@ -150,10 +256,11 @@ TEST(primitive_constant_acceleration, behavior_test) {
   std::const_pointer_cast<Agent>(world2.GetEgoAgent())
       ->SetDynamicModel(dynamics);
   AdjacentLaneCorridors corridors2 = GetCorridors(world2);
-  EXPECT_FALSE(dec_primitive.IsPreConditionSatisfied(world2, corridors2));
+  EXPECT_FALSE(dec_primitive.IsPreConditionSatisfied(
+      world2, PrimitiveContext(world2, corridors2)));
 
   PrimitiveConstAccStayLane acc_primitive(params, 4.0);
-  EXPECT_TRUE(acc_primitive.IsPreConditionSatisfied(world1, corridors));
+  EXPECT_TRUE(acc_primitive.IsPreConditionSatisfied(world1, context1));
   auto traj3 = acc_primitive.Plan(0.5, world1, corridors.current);
   EXPECT_NEAR(
       traj3(traj3.rows() - 1, StateDefinition::X_POSITION),
@@ -163,39 +270,46 @@ TEST(primitive_constant_acceleration, behavior_test) {
 
 TEST(primitive_change_left, behavior_test) {
   using bark::models::behavior::primitives::PrimitiveConstAccChangeToLeft;
+  using bark::models::behavior::primitives::PrimitiveContext;
   auto params = std::make_shared<SetterParams>();
   PrimitiveConstAccChangeToLeft primitive(params);
   auto world = MakeTestWorldHighway();
   auto observed_worlds = world->Observe({1, 4});
   auto corridors0 = GetCorridors(observed_worlds[0]);
+  PrimitiveContext context0(observed_worlds[0], corridors0);
   EXPECT_FALSE(
-      primitive.IsPreConditionSatisfied(observed_worlds[0], corridors0));
+      primitive.IsPreConditionSatisfied(observed_worlds[0], context0));
   auto corridors1 = GetCorridors(observed_worlds[1]);
+  PrimitiveContext context1(observed_worlds[1], corridors1);
   EXPECT_TRUE(
-      primitive.IsPreConditionSatisfied(observed_worlds[1], corridors1));
+      primitive.IsPreConditionSatisfied(observed_worlds[1], context1));
   auto target_corridor =
-      primitive.SelectTargetCorridor(observed_worlds[1], corridors1);
+      primitive.SelectTargetCorridor(observed_worlds[1], context1);
   EXPECT_EQ(target_corridor, corridors1.left);
 }
 
 TEST(primitive_change_right, behavior_test) {
   using bark::models::behavior::primitives::PrimitiveConstAccChangeToRight;
+  using bark::models::behavior::primitives::PrimitiveContext;
   auto params = std::make_shared<SetterParams>();
   PrimitiveConstAccChangeToRight primitive(params);
   auto world = MakeTestWorldHighway();
   auto observed_worlds = world->Observe({1, 4});
   auto corridors0 = GetCorridors(observed_worlds[0]);
+  PrimitiveContext context0(observed_worlds[0], corridors0);
   EXPECT_TRUE(
-      primitive.IsPreConditionSatisfied(observed_worlds[0], corridors0));
+      primitive.IsPreConditionSatisfied(observed_worlds[0], context0));
   auto target_corridor =
-      primitive.SelectTargetCorridor(observed_worlds[0], corridors0);
+      primitive.SelectTargetCorridor(observed_worlds[0], context0);
   EXPECT_EQ(target_corridor, corridors0.right);
   auto corridors1 = GetCorridors(observed_worlds[1]);
+  PrimitiveContext context1(observed_worlds[1], corridors1);
   EXPECT_FALSE(
-      primitive.IsPreConditionSatisfied(observed_worlds[1], corridors1));
+      primitive.IsPreConditionSatisfied(observed_worlds[1], context1));
 }
 
 TEST(primitive_gap_keeping, precondition_test) {
+  using bark::models::behavior::primitives::PrimitiveContext;
   using bark::models::behavior::primitives::PrimitiveGapKeeping;
   auto params = std::make_shared<SetterParams>();
   DynamicModelPtr dynamics(new SingleTrackModel(params));
@@ -205,10 +319,38 @@ TEST(primitive_gap_keeping, precondition_test) {
   init_state << 0.0, 0.0, 0.0, 0.0, 5.0;
   auto world1 = DummyObservedWorld(init_state, params);
   AdjacentLaneCorridors corridors = {nullptr, nullptr, nullptr};
-  EXPECT_TRUE(primitive.IsPreConditionSatisfied(world1, corridors));
+  PrimitiveContext context(world1, corridors);
+  EXPECT_TRUE(primitive.IsPreConditionSatisfied(world1, context));
   // auto traj = primitive.Plan(0.5, world1);
 }
 
+TEST(primitive_context, cached_queries) {
+  using bark::models::behavior::primitives::PrimitiveContext;
+  auto world = MakeTestWorldHighway();
+  auto observed_worlds = world->Observe({1, 4});
+  const ObservedWorld& observed_world = observed_worlds[1];
+  auto corridors = GetCorridors(observed_world);
+  ASSERT_TRUE(corridors.left);
+  PrimitiveContext context(observed_world, corridors);
+
+  const Point2d ego_pos = observed_world.CurrentEgoPosition();
+  const Point2d point_on_left =
+      GetNearestPoint(corridors.left->GetCenterLine(), ego_pos);
+  EXPECT_NEAR(context.GetLengthUntilEnd(corridors.left),
+              corridors.left->LengthUntilEnd(point_on_left), 1e-4);
+  EXPECT_EQ(context.GetLengthUntilEnd(corridors.left),
+            context.GetLengthUntilEnd(corridors.left));
+  EXPECT_EQ(context.GetCurrentLaneCorridor(),
+            observed_world.GetRoadCorridor()->GetCurrentLaneCorridor(ego_pos));
+
+  // the context does not depend on the lifetime of the observed world
+  const LaneCorridorPtr current_corridor = context.GetCurrentLaneCorridor();
+  PrimitiveContext detached_context(observed_world, corridors);
+  observed_worlds.clear();
+  world.reset();
+  EXPECT_EQ(detached_context.GetCurrentLaneCorridor(), current_corridor);
+}
+
 TEST(macro_actions, behavior_test) {
   using namespace bark::models::behavior::primitives;
   using bark::models::behavior::primitives::PrimitiveConstAccStayLane;
@@ -71,6 +71,71 @@ TEST(behavior_static_trajectory_plan, plan) {
   EXPECT_EQ(expected, traj.row(2));
 }
 
+TEST(behavior_static_trajectory_plan, cursor_and_shared_storage) {
+  const int num_rows = 200;
+  Trajectory static_traj(num_rows,
+                         static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  for (int i = 0; i < num_rows; ++i) {
+    static_traj.row(i) << 0.1 * i, 0.5 * i, -1.75, 0, 5;
+  }
+  BehaviorStaticTrajectory model(nullptr, static_traj);
+  auto clone = std::dynamic_pointer_cast<BehaviorStaticTrajectory>(
+      model.Clone());
+  EXPECT_EQ(clone->GetStaticTrajectoryPtr(), model.GetStaticTrajectoryPtr());
+
+  auto observed_world =
+      bark::world::tests::make_test_observed_world(0, 0, 0, 0);
+  // forward steps and a jump back in time give the same trajectories as a
+  // freshly created model
+  std::vector<double> times{0.0, 0.35, 0.7, 1.5, 1.85, 10.0, 0.5, 0.85, 19.5};
+  for (double time : times) {
+    observed_world.SetWorldTime(time);
+    BehaviorStaticTrajectory fresh_model(nullptr, static_traj);
+    Trajectory traj = model.Plan(0.35, observed_world);
+    Trajectory expected = fresh_model.Plan(0.35, observed_world);
+    ASSERT_EQ(traj.rows(), expected.rows()) << "t = " << time;
+    EXPECT_EQ(traj, expected) << "t = " << time;
+    LonLatAction action = boost::get<LonLatAction>(model.GetLastAction());
+    LonLatAction expected_action = boost::get<LonLatAction>(
+        BehaviorStaticTrajectory::CalculateAction(0.35, observed_world,
+                                                  expected));
+    EXPECT_NEAR(action.acc_lon, expected_action.acc_lon, 1e-4);
+    EXPECT_NEAR(action.acc_lat, expected_action.acc_lat, 1e-4);
+  }
+}
+
+TEST(behavior_static_trajectory_plan, window) {
+  const int num_rows = 50;
+  Trajectory static_traj(num_rows,
+                         static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  for (int i = 0; i < num_rows; ++i) {
+    static_traj.row(i) << 0.1 * i, 0.5 * i, -1.75, 0, 5;
+  }
+  auto static_traj_ptr = std::make_shared<const Trajectory>(static_traj);
+  // rows 10 to 29, the time 1.0 of the static trajectory being time zero
+  BehaviorStaticTrajectory model(nullptr, static_traj_ptr, 10, 20, 1.0);
+  EXPECT_EQ(model.GetStaticTrajectoryPtr(), static_traj_ptr);
+  EXPECT_EQ(&model.GetStaticTrajectory(), static_traj_ptr.get());
+
+  Trajectory window = static_traj.middleRows(10, 20);
+  window.col(StateDefinition::TIME_POSITION).array() -= 1.0f;
+  EXPECT_TRUE(model.GetReplayedTrajectory().isApprox(window));
+
+  auto observed_world =
+      bark::world::tests::make_test_observed_world(0, 0, 0, 0);
+  for (double time : {0.0, 0.35, 0.7, 1.75}) {
+    observed_world.SetWorldTime(time);
+    BehaviorStaticTrajectory window_model(nullptr, window);
+    Trajectory traj = model.Plan(0.35, observed_world);
+    Trajectory expected = window_model.Plan(0.35, observed_world);
+    ASSERT_EQ(traj.rows(), expected.rows()) << "t = " << time;
+    EXPECT_TRUE(traj.isApprox(expected, 1e-5)) << "t = " << time;
+    EXPECT_EQ(model.GetBehaviorStatus(), window_model.GetBehaviorStatus());
+  }
+  observed_world.SetWorldTime(1.8);
+  EXPECT_EQ(model.Plan(0.35, observed_world).rows(), 0);
+}
+
 TEST(behavior_static_trajectory_plan, calculate_action) {
   // two lane road along x= 0 , 200, lane1 -1.75, lan2 -3.0
   Polygon polygon(Pose(0, 0, 0),
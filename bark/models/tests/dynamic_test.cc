@@ -175,6 +175,161 @@ TEST(triple_integrator_model, dynamic_test) {
   // TODO(@hart): assert state
 }
 
+TEST(single_track_model, integrate_trajectory) {
+  auto params = std::make_shared<SetterParams>();
+  SingleTrackModel model(params);
+  State x0(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  x0 << 0, 1, 2, 0.3, 5;
+  InputTrajectory inputs(10, 2);
+  for (int i = 0; i < inputs.rows(); ++i) {
+    inputs.row(i) << 0.1 * i, 0.02 * i - 0.1;
+  }
+  const float dt = 0.1;
+
+  for (auto method : {IntegrationMethod::EULER, IntegrationMethod::RK4}) {
+    const Trajectory traj =
+        model.IntegrateTrajectory(x0, inputs, dt, 10, method);
+    ASSERT_EQ(traj.rows(), 11);
+    State x = x0;
+    for (int i = 0; i < 10; ++i) {
+      const Input u = inputs.row(i).transpose();
+      x = method == IntegrationMethod::EULER ? euler_int(model, x, u, dt)
+                                             : rk4(model, x, u, dt);
+      for (int c = 0; c < x.rows(); ++c) {
+        EXPECT_NEAR(traj(i + 1, c), x(c), 1e-4);
+      }
+    }
+  }
+}
+
+TEST(single_track_model, integrate_batch) {
+  auto params = std::make_shared<SetterParams>();
+  SingleTrackModel model(params);
+  const int num_agents = 7;
+  StateBatch states(num_agents,
+                    static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  StateBatch inputs(num_agents, 2);
+  for (int a = 0; a < num_agents; ++a) {
+    states.row(a) << 0, a, -a, 0.1 * a, 2 + a;
+    inputs.row(a) << 0.5 * a - 1, 0.03 * a - 0.1;
+  }
+
+  for (auto method : {IntegrationMethod::EULER, IntegrationMethod::RK4}) {
+    StateBatch batch = states;
+    model.IntegrateBatch(&batch, inputs, 0.05, 20, method);
+    for (int a = 0; a < num_agents; ++a) {
+      const Trajectory traj = model.IntegrateTrajectory(
+          states.row(a).transpose(), inputs.row(a), 0.05, 20, method);
+      for (int c = 0; c < batch.cols(); ++c) {
+        EXPECT_NEAR(batch(a, c), traj(20, c), 1e-4);
+      }
+    }
+  }
+}
+
+TEST(triple_integrator_model, integrate_batch) {
+  auto params = std::make_shared<SetterParams>();
+  TripleIntegratorModel model(params);
+  const int num_agents = 3;
+  StateBatch states = StateBatch::Zero(num_agents, 15);
+  StateBatch inputs(num_agents, 3);
+  for (int a = 0; a < num_agents; ++a) {
+    states.row(a).tail(9) << a, 1, 0, -a, 2, 0.5, 0, 0, 1;
+    inputs.row(a) << 1, -a, 0.5;
+  }
+
+  for (auto method : {IntegrationMethod::EULER, IntegrationMethod::RK4}) {
+    StateBatch batch = states;
+    model.IntegrateBatch(&batch, inputs, 0.1, 10, method);
+    for (int a = 0; a < num_agents; ++a) {
+      State x = states.row(a).transpose();
+      const Input u = inputs.row(a).transpose();
+      for (int i = 0; i < 10; ++i) {
+        x = method == IntegrationMethod::EULER ? euler_int(model, x, u, 0.1)
+                                               : rk4(model, x, u, 0.1);
+      }
+      const Trajectory traj =
+          model.IntegrateTrajectory(states.row(a).transpose(), inputs.row(a),
+                                    0.1, 10, method);
+      for (int c = 0; c < 15; ++c) {
+        EXPECT_NEAR(batch(a, c), x(c), 1e-4);
+        EXPECT_NEAR(traj(10, c), x(c), 1e-4);
+      }
+      // the time advances with the integration
+      EXPECT_NEAR(x(StateDefinition::TIME_POSITION), 1., 1e-5);
+    }
+  }
+}
+
+TEST(triple_integrator_model, exact_propagation) {
+  auto params = std::make_shared<SetterParams>();
+  TripleIntegratorModel model(params);
+
+  // constant jerk from rest: p = t^3 / 6, v = t^2 / 2, a = t
+  State x0 = State::Zero(15);
+  InputTrajectory jerk(1, 3);
+  jerk << 1, 2, -1;
+  const Trajectory traj = model.PropagateTrajectory(x0, jerk, 0.1, 20);
+  ASSERT_EQ(traj.rows(), 21);
+  const float t = 2.;
+  EXPECT_NEAR(traj(20, StateDefinition::TIME_POSITION), t, 1e-5);
+  for (int axis = 0; axis < 3; ++axis) {
+    const float u = jerk(0, axis);
+    EXPECT_NEAR(traj(20, 6 + 3 * axis), u * t * t * t / 6, 1e-4);
+    EXPECT_NEAR(traj(20, 7 + 3 * axis), u * t * t / 2, 1e-4);
+    EXPECT_NEAR(traj(20, 8 + 3 * axis), u * t, 1e-4);
+  }
+
+  // rk4 is exact for the cubic polynomials of a constant input
+  State x(15);
+  x << 0, 0, 0, 0, 0, 0, 1, 2, 3, -1, 0.5, 0, 4, -2, 1;
+  Input u(3);
+  u << 0.5, -1, 2;
+  const State exact = model.Propagate(x, u, 0.3);
+  const State numeric = rk4(model, x, u, 0.3);
+  for (int c = 0; c < 15; ++c) {
+    EXPECT_NEAR(exact(c), numeric(c), 1e-4);
+  }
+
+  // piecewise-constant inputs for a batch of agents
+  StateBatch states(2, 15);
+  states.row(0) = x.transpose();
+  states.row(1) = -x.transpose();
+  StateBatch inputs(2, 3);
+  inputs << 1, 0, -1, 0, 2, 1;
+  StateBatch batch = states;
+  model.PropagateBatch(&batch, inputs, 0.1);
+  model.PropagateBatch(&batch, inputs, 0.1);
+  for (int a = 0; a < 2; ++a) {
+    const Trajectory expected = model.PropagateTrajectory(
+        states.row(a).transpose(), inputs.row(a), 0.1, 2);
+    for (int c = 0; c < 15; ++c) {
+      EXPECT_NEAR(batch(a, c), expected(2, c), 1e-4);
+    }
+  }
+}
+
+TEST(shared_trajectory, copy_on_write) {
+  Trajectory traj = Trajectory::Zero(3, 5);
+  SharedTrajectory shared;
+  shared.Set(traj);
+  const float* data = shared.Get().data();
+
+  // a single owner overwrites its buffer
+  traj(1, 1) = 1.f;
+  shared.Set(traj);
+  EXPECT_EQ(shared.Get().data(), data);
+
+  // copies share the buffer until one of them sets a new trajectory
+  SharedTrajectory copy = shared;
+  EXPECT_EQ(copy.Get().data(), data);
+  traj(1, 1) = 2.f;
+  shared.Set(traj);
+  EXPECT_NE(shared.Get().data(), data);
+  EXPECT_EQ(copy.Get()(1, 1), 1.f);
+  EXPECT_EQ(shared.Get()(1, 1), 2.f);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
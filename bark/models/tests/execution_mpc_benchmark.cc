@@ -0,0 +1,88 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/models/dynamic/single_track.hpp"
+#include "bark/models/execution/mpc/mpc.hpp"
+
+using namespace bark::models::dynamic;
+using namespace bark::models::execution;
+using bark::commons::SetterParams;
+
+//! lane change of 3.5m within 4s at 10m/s, sampled every 0.1s
+Trajectory MakeLaneChange(double start_time) {
+  const int num_points = 61;
+  Trajectory traj(num_points,
+                  static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  for (int i = 0; i < num_points; ++i) {
+    const double t = start_time + 0.1 * i;
+    const double phase = std::min(1., std::max(0., t / 4.));
+    const double y =
+        3.5 * (phase - std::sin(2. * M_PI * phase) / (2. * M_PI));
+    const double dy = 3.5 / 4. * (1. - std::cos(2. * M_PI * phase));
+    traj.row(i) << t, 10. * t, y, std::atan2(dy, 10.), std::hypot(10., dy);
+  }
+  return traj;
+}
+
+TEST(execution_mpc_benchmark, execute) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetInt("MaxNumIterations", 10);
+  DynamicModelPtr dynamic_model(new SingleTrackModel(params));
+  const int num_agents = 10;
+  const int num_world_steps = 20;
+  const float world_step = 0.2;
+
+  // warm started: each model keeps its problem and last solution
+  std::vector<ExecutionModelMpc> warm_models(num_agents,
+                                             ExecutionModelMpc(params));
+  auto t0 = std::chrono::steady_clock::now();
+  for (int step = 0; step < num_world_steps; ++step) {
+    const Trajectory trajectory = MakeLaneChange(step * world_step);
+    for (auto& model : warm_models) {
+      model.Execute((step + 1) * world_step, trajectory, dynamic_model);
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  // cold started: a new problem from zero controls in every step
+  for (int step = 0; step < num_world_steps; ++step) {
+    const Trajectory trajectory = MakeLaneChange(step * world_step);
+    for (int agent = 0; agent < num_agents; ++agent) {
+      ExecutionModelMpc model(params);
+      model.Execute((step + 1) * world_step, trajectory, dynamic_model);
+      EXPECT_EQ(model.GetExecutionStatus(), ExecutionStatus::VALID);
+    }
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  // the optimized trajectory follows the lane change within the budget
+  ExecutionModelMpc& model = warm_models.front();
+  EXPECT_LE(model.GetLastNumIterations(), 10);
+  const Trajectory desired = model.get_last_desired_states();
+  const Trajectory optimized = model.GetLastTrajectory();
+  for (int i = 0; i < optimized.rows(); ++i) {
+    EXPECT_NEAR(optimized(i, StateDefinition::Y_POSITION),
+                desired(i, StateDefinition::Y_POSITION), 0.2);
+  }
+
+  const int num_calls = num_agents * num_world_steps;
+  std::cout << "ExecutionModelMpc::Execute warm started: "
+            << std::chrono::duration<double, std::micro>(t1 - t0).count() /
+                   num_calls
+            << " us, cold started: "
+            << std::chrono::duration<double, std::micro>(t2 - t1).count() /
+                   num_calls
+            << " us per call" << std::endl;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <cmath>
+#include <vector>
+
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/models/dynamic/single_track.hpp"
+#include "bark/models/execution/mpc/mpc.hpp"
+#include "ceres/gradient_checker.h"
+#include "gtest/gtest.h"
+
+using namespace bark::models::dynamic;
+using namespace bark::models::execution;
+using namespace bark::commons;
+
+TEST(execution_model, execution_model_mpc) {
+  auto params = std::make_shared<SetterParams>();
+
+  Trajectory test_trajectory(3, (int)StateDefinition::MIN_STATE_SIZE);
+  test_trajectory.col(StateDefinition::TIME_POSITION) =
+      Eigen::ArrayXf::LinSpaced(3, 0, 10);  // Time 0 to 10 seconds
+  test_trajectory.col(StateDefinition::X_POSITION) =
+      Eigen::ArrayXf::LinSpaced(3, 0, 10);
+  test_trajectory.col(StateDefinition::Y_POSITION) =
+      Eigen::ArrayXf::LinSpaced(3, 0, 0);
+  test_trajectory.col(StateDefinition::THETA_POSITION) =
+      Eigen::ArrayXf::LinSpaced(3, 0, 0);
+  test_trajectory.col(StateDefinition::VEL_POSITION) =
+      Eigen::ArrayXf::LinSpaced(3, 1, 1);
+
+  ExecutionModelMpc exec_model(params);
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  exec_model.Execute(0.5, test_trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::VALID);
+
+  // the straight line at constant velocity is followed
+  const Trajectory& optimized = exec_model.GetLastTrajectory();
+  for (int i = 0; i < optimized.rows(); ++i) {
+    EXPECT_NEAR(optimized(i, StateDefinition::Y_POSITION), 0., 1e-2);
+    EXPECT_NEAR(optimized(i, StateDefinition::VEL_POSITION), 1., 1e-2);
+  }
+  EXPECT_NEAR(exec_model.GetExecutedState()(StateDefinition::X_POSITION), 0.5,
+              1e-2);
+
+  // before the start of the trajectory
+  exec_model.Execute(-0.5, test_trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::INVALID);
+}
+
+TEST(execution_model, execution_model_mpc_jacobians) {
+  OptimizationSettings settings{20, 0.1f, 2.7, 10., 1.};
+  MpcReference reference;
+  reference.initial_state << 0., 0., 0.1, 8.;
+  reference.desired_states.setRandom(19, kMpcStateSize);
+  reference.sqrt_weights.setOnes(19, kMpcStateSize);
+  std::vector<double> controls(kMpcControlSize * 19);
+  for (std::size_t i = 0; i < controls.size(); ++i) {
+    controls[i] = 0.05 * std::sin(static_cast<double>(i));
+  }
+
+  // the analytic jacobians of the rollout match central differences
+  for (int stage = 1; stage < 20; stage += 6) {
+    StageTrackingCost cost(&reference, stage, settings);
+    std::vector<const double*> parameters;
+    for (int k = 0; k < stage; ++k) {
+      parameters.push_back(&controls[kMpcControlSize * k]);
+    }
+    ceres::NumericDiffOptions numeric_diff_options;
+    ceres::GradientChecker checker(&cost, nullptr, numeric_diff_options);
+    ceres::GradientChecker::ProbeResults results;
+    EXPECT_TRUE(checker.Probe(parameters.data(), 1e-6, &results))
+        << results.error_log;
+  }
+}
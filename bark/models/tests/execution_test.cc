@@ -9,7 +9,6 @@
 #include "bark/models/dynamic/single_track.hpp"
 #include "bark/models/execution/interpolation/interpolate.hpp"
 #include "gtest/gtest.h"
-//#include "bark/models/execution/mpc/mpc.hpp"
 #include "bark/commons/params/setter_params.hpp"
 
 using namespace bark::models::dynamic;
@@ -50,27 +49,48 @@ TEST(execution_model, execution_model_interpolate) {
   //   EXPECT_NEAR(next_state3(StateDefinition::Y_POSITION),0.9,0.001);
 }
 
-/*
-TEST(execution_model, execution_model_mpc) {
-
+TEST(execution_model, execution_model_interpolate_lookup) {
   auto params = std::make_shared<SetterParams>();
-
-  Trajectory test_trajectory(3, (int)StateDefinition::MIN_STATE_SIZE);
+  // x = t^2, so interpolating between the wrong rows is visible
+  Trajectory test_trajectory(11, (int)StateDefinition::MIN_STATE_SIZE);
+  test_trajectory.setZero();
   test_trajectory.col(StateDefinition::TIME_POSITION) =
-Eigen::ArrayXf::LinSpaced(3, 0, 10); // Time 0 to 10 seconds
+      Eigen::ArrayXf::LinSpaced(11, 0, 10);
   test_trajectory.col(StateDefinition::X_POSITION) =
-Eigen::ArrayXf::LinSpaced(3, 0, 10);
-  test_trajectory.col(StateDefinition::Y_POSITION) =
-Eigen::ArrayXf::LinSpaced(3, 0, 0);
-  test_trajectory.col(StateDefinition::THETA_POSITION) =
-Eigen::ArrayXf::LinSpaced(3, 0, 0);
-  test_trajectory.col(StateDefinition::VEL_POSITION) =
-Eigen::ArrayXf::LinSpaced(3, 1, 1);
-
-  ExecutionModelPtr exec_model(new ExecutionModelMpc(params));
+      Eigen::ArrayXf::LinSpaced(11, 0, 10).square();
+  ExecutionModelInterpolate exec_model(params);
   DynamicModelPtr dyn_model(new SingleTrackModel(params));
 
-  Trajectory followed_trajectory1 = exec_model->Execute(0.5, test_trajectory,
-dyn_model, test_trajectory.row(0));
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, 0.), 0);
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, 4.5), 4);
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, 10.), 9);
+
+  exec_model.Execute(4.5, test_trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::VALID);
+  EXPECT_NEAR(exec_model.GetExecutedState()(StateDefinition::X_POSITION),
+              20.5, 1e-4);
+  EXPECT_NEAR(exec_model.GetExecutedState()(StateDefinition::TIME_POSITION),
+              4.5, 1e-5);
+
+  // exact points within the tolerance are taken as they are
+  exec_model.Execute(7.0005, test_trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutedState()(StateDefinition::X_POSITION), 49.);
+  exec_model.Execute(10.0005, test_trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::VALID);
+  EXPECT_EQ(exec_model.GetExecutedState()(StateDefinition::X_POSITION), 100.);
+
+  exec_model.Execute(10.5, test_trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::INVALID);
+  exec_model.Execute(-0.5, test_trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::INVALID);
+
+  // of repeated time points, e.g. of a trajectory planned for a zero time
+  // span, the first row is taken
+  Trajectory zero_span_trajectory(3, (int)StateDefinition::MIN_STATE_SIZE);
+  zero_span_trajectory.setZero();
+  zero_span_trajectory.col(StateDefinition::X_POSITION) =
+      Eigen::ArrayXf::LinSpaced(3, 1, 3);
+  exec_model.Execute(0., zero_span_trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::VALID);
+  EXPECT_EQ(exec_model.GetExecutedState()(StateDefinition::X_POSITION), 1.);
 }
-*/
\ No newline at end of file
@@ -9,8 +9,10 @@
 #include "behavior.hpp"
 #include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
 #include "bark/models/behavior/dynamic_model/dynamic_model.hpp"
+#include "bark/models/behavior/idm/idm_agent_kernels.hpp"
 #include "bark/models/behavior/idm/idm_classic.hpp"
 #include "bark/models/behavior/idm/idm_lane_tracking.hpp"
+#include "bark/models/behavior/idm/idm_traffic_batch.hpp"
 #include "bark/models/behavior/idm/stochastic/idm_stochastic.hpp"
 #include "bark/models/behavior/motion_primitives/continuous_actions.hpp"
 #include "bark/models/behavior/motion_primitives/macro_actions.hpp"
@@ -40,8 +42,12 @@ void python_behavior(py::module m) {
       .def("SetLastAction", &BehaviorModel::SetLastAction)
       .def("GetLastAction", &BehaviorModel::GetLastAction)
       .def("ActionToBehavior", &BehaviorModel::ActionToBehavior)
-      .def_property("last_trajectory", &BehaviorModel::GetLastTrajectory,
-                    &BehaviorModel::SetLastTrajectory);
+      .def_property(
+          "last_trajectory",
+          [](const BehaviorModel& b) -> Trajectory {
+            return b.GetLastTrajectory();
+          },
+          &BehaviorModel::SetLastTrajectory);
 
   py::class_<BehaviorConstantAcceleration, BehaviorModel,
              shared_ptr<BehaviorConstantAcceleration>>(m,
@@ -102,6 +108,22 @@ void python_behavior(py::module m) {
                 PythonToParams(t[0].cast<py::tuple>()));
           }));
 
+  py::class_<bark::world::AgentBatchPlanner,
+             bark::world::AgentBatchPlannerPtr>(m, "AgentBatchPlanner");
+
+  py::class_<IDMTrafficBatchPlanner, bark::world::AgentBatchPlanner,
+             IDMTrafficBatchPlannerPtr>(m, "IDMTrafficBatchPlanner")
+      .def(py::init<>())
+      .def_property_readonly("num_planned_agents",
+                             &IDMTrafficBatchPlanner::GetNumPlannedAgents)
+      .def("__repr__", [](const IDMTrafficBatchPlanner& b) {
+        return "bark.behavior.IDMTrafficBatchPlanner";
+      });
+
+  m.def("RegisterIDMAgentKernels", &RegisterIDMAgentKernels);
+  m.def("ClearAgentKernels",
+        &bark::world::objects::AgentKernelRegistry::Clear);
+
   py::class_<BehaviorMobil, BehaviorModel, shared_ptr<BehaviorMobil>>(
       m, "BehaviorMobil")
       .def(py::init<const bark::commons::ParamsPtr&>())
@@ -223,6 +245,23 @@ void python_behavior(py::module m) {
       .def("AddMotionPrimitive",
            &BehaviorMPContinuousActions::AddMotionPrimitive);
 
+  py::class_<PrimitiveContext, std::shared_ptr<PrimitiveContext>>(
+      m, "PrimitiveContext")
+      .def("GetCurrentLaneCorridor", &PrimitiveContext::GetCurrentLaneCorridor)
+      .def("GetLengthUntilEnd", &PrimitiveContext::GetLengthUntilEnd)
+      .def_property_readonly("ego_position", &PrimitiveContext::GetEgoPosition)
+      .def_property_readonly(
+          "current_corridor",
+          [](const PrimitiveContext& c) {
+            return c.GetAdjacentCorridors().current;
+          })
+      .def_property_readonly(
+          "left_corridor",
+          [](const PrimitiveContext& c) { return c.GetAdjacentCorridors().left; })
+      .def_property_readonly("right_corridor", [](const PrimitiveContext& c) {
+        return c.GetAdjacentCorridors().right;
+      });
+
   py::class_<Primitive, PyPrimitive, PrimitivePtr>(m, "Primitive")
       .def(py::init<const bark::commons::ParamsPtr&>())
       .def("Plan", &Primitive::Plan)
@@ -349,7 +388,7 @@ void python_behavior(py::module m) {
       .def(py::init<const bark::commons::ParamsPtr&,
                     const bark::models::dynamic::Trajectory&>())
       .def_property_readonly("static_trajectory",
-                             &BehaviorStaticTrajectory::GetStaticTrajectory)
+                             &BehaviorStaticTrajectory::GetReplayedTrajectory)
       .def("__repr__",
            [](const BehaviorStaticTrajectory& b) {
              return "bark.behavior.BehaviorStaticTrajectory";
@@ -357,7 +396,7 @@ void python_behavior(py::module m) {
       .def(py::pickle(
           [](const BehaviorStaticTrajectory& b) {
             return py::make_tuple(ParamsToPython(b.GetParams()),
-                                  b.GetStaticTrajectory());
+                                  b.GetReplayedTrajectory());
           },
           [](py::tuple t) {
             if (t.size() != 2)
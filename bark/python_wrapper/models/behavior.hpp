@@ -51,10 +51,9 @@ class PyPrimitive : public Primitive {
 
   bool IsPreConditionSatisfied(
       const ObservedWorld& observed_world,
-      const bark::models::behavior::primitives::AdjacentLaneCorridors&
-          adjacent_corridors) {
+      const bark::models::behavior::primitives::PrimitiveContext& context) {
     PYBIND11_OVERLOAD_PURE(bool, Primitive, IsPreConditionSatisfied,
-                           observed_world, adjacent_corridors);
+                           observed_world, context);
   }
 
   Trajectory Plan(float min_planning_time, const ObservedWorld& observed_world,
@@ -65,11 +64,9 @@ class PyPrimitive : public Primitive {
 
   bark::world::LaneCorridorPtr SelectTargetCorridor(
       const ObservedWorld& observed_world,
-      const bark::models::behavior::primitives::AdjacentLaneCorridors&
-          adjacent_corridors) {
+      const bark::models::behavior::primitives::PrimitiveContext& context) {
     PYBIND11_OVERLOAD_PURE(bark::world::LaneCorridorPtr, Primitive,
-                           SelectTargetCorridor, observed_world,
-                           adjacent_corridors);
+                           SelectTargetCorridor, observed_world, context);
   }
 };
 
@@ -17,9 +17,26 @@ using namespace bark::models::dynamic;
 using namespace bark::commons;
 
 void python_dynamic(py::module m) {
+  py::enum_<IntegrationMethod>(m, "IntegrationMethod")
+      .value("EULER", IntegrationMethod::EULER)
+      .value("RK4", IntegrationMethod::RK4)
+      .export_values();
+
   py::class_<DynamicModel, PyDynamicModel, DynamicModelPtr>(m, "DynamicModel")
       .def(py::init<ParamsPtr>())
-      .def("stateSpaceModel", &DynamicModel::StateSpaceModel);
+      .def("stateSpaceModel", &DynamicModel::StateSpaceModel)
+      .def("integrateTrajectory", &DynamicModel::IntegrateTrajectory,
+           py::arg("x0"), py::arg("inputs"), py::arg("dt"),
+           py::arg("num_steps"), py::arg("method") = IntegrationMethod::EULER)
+      .def(
+          "integrateBatch",
+          [](const DynamicModel& m, StateBatch states, const StateBatch& inputs,
+             float dt, int num_steps, IntegrationMethod method) {
+            m.IntegrateBatch(&states, inputs, dt, num_steps, method);
+            return states;
+          },
+          py::arg("states"), py::arg("inputs"), py::arg("dt"),
+          py::arg("num_steps"), py::arg("method") = IntegrationMethod::EULER);
 
   py::class_<SingleTrackModel, DynamicModel, std::shared_ptr<SingleTrackModel>>(
       m, "SingleTrackModel")
@@ -42,6 +59,14 @@ void python_dynamic(py::module m) {
   py::class_<TripleIntegratorModel, DynamicModel,
              std::shared_ptr<TripleIntegratorModel>>(m, "TripleIntegratorModel")
       .def(py::init<ParamsPtr>())
+      .def("propagate", &TripleIntegratorModel::Propagate)
+      .def("propagateTrajectory", &TripleIntegratorModel::PropagateTrajectory)
+      .def("propagateBatch",
+           [](const TripleIntegratorModel& m, StateBatch states,
+              const StateBatch& inputs, float dt) {
+             m.PropagateBatch(&states, inputs, dt);
+             return states;
+           })
       .def("__repr__",
            [](const TripleIntegratorModel& m) {
              return "bark.dynamic.TripleIntegratorModel";
@@ -24,7 +24,9 @@ void python_execution(py::module m) {
       .def("Execute", &ExecutionModel::Execute)
       .def_property_readonly("last_state", &ExecutionModel::GetExecutedState)
       .def_property_readonly("last_trajectory",
-                             &ExecutionModel::GetLastTrajectory);
+                             [](const ExecutionModel& e) -> Trajectory {
+                               return e.GetLastTrajectory();
+                             });
 
   py::class_<ExecutionModelInterpolate, ExecutionModel,
              shared_ptr<ExecutionModelInterpolate>>(m,
@@ -43,16 +43,22 @@ void python_agent(py::module m) {
       .def_property_readonly("history", &Agent::GetStateInputHistory)
       .def_property_readonly("shape", &Agent::GetShape)
       .def_property_readonly("id", &Agent::GetAgentId)
+      // trajectories are copied, the agent may replace their buffers
       .def_property_readonly("followed_trajectory",
-                             &Agent::GetExecutionTrajectory)
+                             [](const Agent& a) -> Trajectory {
+                               return a.GetExecutionTrajectory();
+                             })
       .def_property_readonly("planned_trajectory",
-                             &Agent::GetBehaviorTrajectory)
+                             [](const Agent& a) -> Trajectory {
+                               return a.GetBehaviorTrajectory();
+                             })
       .def_property("behavior_model", &Agent::GetBehaviorModel,
                     &Agent::SetBehaviorModel)
       .def_property_readonly("execution_model", &Agent::GetExecutionModel)
       .def_property_readonly("dynamic_model", &Agent::GetDynamicModel)
       .def_property_readonly("model3d", &Agent::GetModel3d)
-      .def_property_readonly("state", &Agent::GetCurrentState)
+      .def_property_readonly("state", &Agent::GetCurrentState,
+                             py::return_value_policy::copy)
       .def_property("road_corridor", &Agent::GetRoadCorridor,
                     &Agent::SetRoadCorridor)
       .def_property("goal_definition", &Agent::GetGoalDefinition,
@@ -0,0 +1,30 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/python_wrapper/world/interaction_dataset.hpp"
+#include <string>
+#include "bark/world/interaction_dataset/track_store.hpp"
+
+namespace py = pybind11;
+using bark::world::interaction_dataset::TrackStore;
+using bark::world::interaction_dataset::TrackStorePtr;
+
+void python_interaction_dataset(py::module m) {
+  py::class_<TrackStore, TrackStorePtr>(m, "TrackStore")
+      .def(py::init<const std::string&>())
+      .def("GetTrackIds", &TrackStore::GetTrackIds)
+      .def_property_readonly("num_tracks", &TrackStore::GetNumTracks)
+      .def("MakeBehavior", &TrackStore::MakeBehavior)
+      .def("GetInitState", &TrackStore::GetInitState)
+      .def("GetShape", &TrackStore::GetShape)
+      .def("GetGoalDefinition", &TrackStore::GetGoalDefinition)
+      .def("MakeAgent", &TrackStore::MakeAgent)
+      .def("__repr__", [](const TrackStore& t) {
+        return "bark.core.world.interaction_dataset.TrackStore";
+      });
+}
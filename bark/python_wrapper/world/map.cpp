@@ -48,7 +48,26 @@ void python_map(py::module m) {
       .def("GetRoadCorridor", &MapInterface::GetRoadCorridor)
       .def("GetLane", &MapInterface::GetLane)
       .def("ComputeAllPathBoundaries", &MapInterface::ComputeAllPathBoundaries)
-      .def("FindLane", &MapInterface::FindXodrLane);
+      .def("FindLane", &MapInterface::FindXodrLane)
+      .def("SetRouteCacheCapacity", &MapInterface::SetRouteCacheCapacity)
+      .def("ClearRouteCache", &MapInterface::ClearRouteCache)
+      .def_property_readonly("route_cache_size",
+                             &MapInterface::GetRouteCacheSize)
+      .def_property_readonly("route_cache_hits",
+                             &MapInterface::GetRouteCacheHits)
+      .def_property_readonly("route_cache_misses",
+                             &MapInterface::GetRouteCacheMisses)
+      .def("EnableTiling", &MapInterface::EnableTiling, py::arg("tile_size"),
+           py::arg("max_num_tiles"), py::arg("max_num_road_corridors") = 64)
+      .def_property_readonly("is_tiled", &MapInterface::IsTiled)
+      .def_property_readonly(
+          "num_loaded_tiles",
+          [](const MapInterface& m) {
+            return m.IsTiled() ? m.GetMapTiles()->GetNumLoadedTiles() : 0;
+          })
+      .def_property("road_sdf_grid_resolution",
+                    &MapInterface::GetRoadSignedDistanceGridResolution,
+                    &MapInterface::SetRoadSignedDistanceGridResolution);
 
   py::class_<Roadgraph, std::shared_ptr<Roadgraph>>(m, "Roadgraph")
       .def(py::init<>())
@@ -67,10 +86,15 @@ void python_map(py::module m) {
       .def("AddOuterNeighbor", &Roadgraph::AddOuterNeighbor)
       .def("FindDrivableLanePath", &Roadgraph::FindDrivableLanePath)
       .def("FindRoadPath", &Roadgraph::FindRoadPath)
+      .def("PrecomputeRoutingTables", &Roadgraph::PrecomputeRoutingTables,
+           py::arg("max_num_vertices") = 4000)
+      .def("HasRoutingTables", &Roadgraph::HasRoutingTables)
+      .def("ClearRoutingTables", &Roadgraph::ClearRoutingTables)
       .def("PrintGraph",
            (void (Roadgraph::*)(const char*)) & Roadgraph::PrintGraph)
       .def("AddLaneSuccessor", &Roadgraph::AddLaneSuccessor)
       .def("Generate", &Roadgraph::Generate)
+      .def("GenerateTopology", &Roadgraph::GenerateTopology)
       .def("GetLanePolygonForLaneId", &Roadgraph::GetLanePolygonForLaneId)
       .def("GetRoadForLaneId", &Roadgraph::GetRoadForLaneId)
       .def("GetDrivingDirectionsForRoadId",
@@ -85,6 +109,10 @@ void python_map(py::module m) {
       .def_property_readonly("road_ids", &RoadCorridor::GetRoadIds)
       .def("GetRoad", &RoadCorridor::GetRoad)
       .def_property_readonly("polygon", &RoadCorridor::GetPolygon)
+      .def("ComputeSignedDistanceGrid",
+           &RoadCorridor::ComputeSignedDistanceGrid,
+           py::arg("resolution") = 0.25)
+      .def("IsWithinPolygon", &RoadCorridor::IsWithinPolygon)
       .def("GetLaneCorridor", &RoadCorridor::GetLaneCorridor)
       .def("GetCurrentLaneCorridor", &RoadCorridor::GetCurrentLaneCorridor)
       .def("GetLeftRightLaneCorridor", &RoadCorridor::GetLeftRightLaneCorridor)
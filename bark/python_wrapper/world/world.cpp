@@ -13,6 +13,7 @@
 #include "bark/python_wrapper/world/agent.hpp"
 #include "bark/python_wrapper/world/evaluation.hpp"
 #include "bark/python_wrapper/world/goal_definition.hpp"
+#include "bark/python_wrapper/world/interaction_dataset.hpp"
 #include "bark/python_wrapper/world/map.hpp"
 #include "bark/python_wrapper/world/opendrive.hpp"
 #include "bark/python_wrapper/world/world.hpp"
@@ -28,6 +29,7 @@ using bark::commons::ParamsPtr;
 using bark::models::behavior::Action;
 using bark::models::behavior::BehaviorDynamicModel;
 using bark::models::behavior::BehaviorIDMClassic;
+using bark::world::BehaviorHypothesisMap;
 using bark::world::ObservedWorldPtr;
 using bark::world::World;
 using bark::world::WorldPtr;
@@ -59,6 +61,11 @@ void python_world(py::module m) {
       .def_property("map", &World::GetMap, &World::SetMap)
       .def("Copy", &World::Clone)
       .def("GetWorldAtTime", &World::GetWorldAtTime)
+      .def("Checkpoint", &World::Checkpoint)
+      .def("Rollback", &World::Rollback)
+      .def_property_readonly("num_checkpoints", &World::GetNumCheckpoints)
+      .def_property("batch_planner", &World::GetAgentBatchPlanner,
+                    &World::SetAgentBatchPlanner)
       // .def("FillWorldFromCarla",&World::FillWorldFromCarla)
       // .def("PlanAgents",&World::PlanSpecificAgents)
       .def("__repr__", [](const World& a) { return "bark.core.world.World"; });
@@ -82,10 +89,28 @@ void python_world(py::module m) {
       .def_property_readonly("ego_agent", &ObservedWorld::GetEgoAgent)
       .def_property_readonly("lane_corridor", &ObservedWorld::GetLaneCorridor)
       .def_property_readonly("other_agents", &ObservedWorld::GetOtherAgents)
-      .def_property_readonly("ego_state", &ObservedWorld::CurrentEgoState)
+      .def_property_readonly("ego_state", &ObservedWorld::CurrentEgoState,
+                             py::return_value_policy::copy)
       .def_property_readonly("ego_position", &ObservedWorld::CurrentEgoPosition)
       .def("PredictWithOthersIDM",
            &ObservedWorld::Predict<BehaviorIDMClassic, BehaviorDynamicModel>)
+      // python behavior models acquire the GIL when they are called
+      .def("PredictBatch",
+           py::overload_cast<float, const std::vector<Action>&>(
+               &ObservedWorld::PredictBatch, py::const_),
+           py::call_guard<py::gil_scoped_release>())
+      .def("PredictBatch",
+           py::overload_cast<float, const std::vector<BehaviorHypothesisMap>&>(
+               &ObservedWorld::PredictBatch, py::const_),
+           py::call_guard<py::gil_scoped_release>())
+      .def("PredictBatchAndEvaluate",
+           py::overload_cast<float, const std::vector<Action>&>(
+               &ObservedWorld::PredictBatchAndEvaluate, py::const_),
+           py::call_guard<py::gil_scoped_release>())
+      .def("PredictBatchAndEvaluate",
+           py::overload_cast<float, const std::vector<BehaviorHypothesisMap>&>(
+               &ObservedWorld::PredictBatchAndEvaluate, py::const_),
+           py::call_guard<py::gil_scoped_release>())
       .def_property_readonly("other_agents", &ObservedWorld::GetOtherAgents)
       .def("__repr__", [](const ObservedWorld& a) {
         return "bark.core.world.ObservedWorld";
@@ -121,4 +146,7 @@ void python_world(py::module m) {
   python_map(m.def_submodule("map", "mapInterface wrapping"));
 
   python_evaluation(m.def_submodule("evaluation", "evaluators"));
+
+  python_interaction_dataset(m.def_submodule(
+      "interaction_dataset", "replay of interaction dataset tracks"));
 }
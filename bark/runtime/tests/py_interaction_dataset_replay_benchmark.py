@@ -0,0 +1,76 @@
+# Copyright (c) 2020 fortiss GmbH
+#
+# Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+# Tobias Kessler
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+import os
+import time
+import unittest
+import numpy as np
+
+from bark.core.models.dynamic import SingleTrackModel, StateDefinition
+from bark.core.models.execution import ExecutionModelInterpolate
+from bark.core.world.agent import Agent
+from bark.core.world.interaction_dataset import TrackStore
+from bark.runtime.commons.parameters import ParameterServer
+from bark.runtime.scenario.interaction_dataset_processing.interaction_dataset_reader import \
+  BehaviorFromTrack, InitStateFromTrack, ShapeFromTrack, GoalDefinitionFromTrack
+from com_github_interaction_dataset_interaction_dataset.python.utils import dataset_reader
+
+TRACK_FILENAME = os.path.join(os.path.dirname(__file__),
+                              "data/interaction_dataset_dummy_track.csv")
+NUM_REPETITIONS = 200
+START_TS = 500
+END_TS = 1000
+
+
+def AgentsFromPython(params, dynamic_model, execution_model):
+  agents = []
+  tracks = dataset_reader.read_tracks(TRACK_FILENAME)
+  for track_id, track in tracks.items():
+    agent = Agent(InitStateFromTrack(track, START_TS),
+                  BehaviorFromTrack(track, params, START_TS, END_TS),
+                  dynamic_model, execution_model, ShapeFromTrack(track),
+                  params, GoalDefinitionFromTrack(track, END_TS), None)
+    agent.SetAgentId(track_id)
+    agents.append(agent)
+  return agents
+
+
+def AgentsFromTrackStore(params, dynamic_model, execution_model):
+  track_store = TrackStore(TRACK_FILENAME)
+  return [track_store.MakeAgent(track_id, START_TS, END_TS, params,
+                                dynamic_model, execution_model, None, 2.7)
+          for track_id in track_store.GetTrackIds()]
+
+
+class InteractionDatasetReplayBenchmark(unittest.TestCase):
+  def test_replay_benchmark(self):
+    params = ParameterServer()
+    dynamic_model = SingleTrackModel(params)
+    execution_model = ExecutionModelInterpolate(params)
+
+    # both paths replay the same states
+    python_agents = AgentsFromPython(params, dynamic_model, execution_model)
+    store_agents = AgentsFromTrackStore(params, dynamic_model, execution_model)
+    for python_agent, store_agent in zip(python_agents, store_agents):
+      self.assertEqual(python_agent.id, store_agent.id)
+      np.testing.assert_allclose(
+        python_agent.behavior_model.static_trajectory,
+        store_agent.behavior_model.static_trajectory, atol=1e-4)
+
+    for name, make_agents in [("python", AgentsFromPython),
+                              ("track store", AgentsFromTrackStore)]:
+      start = time.perf_counter()
+      for _ in range(NUM_REPETITIONS):
+        make_agents(params, dynamic_model, execution_model)
+      elapsed = time.perf_counter() - start
+      print("{}: {:.3f} ms per scenario".format(
+        name, 1000. * elapsed / NUM_REPETITIONS))
+
+
+if __name__ == '__main__':
+  unittest.main()
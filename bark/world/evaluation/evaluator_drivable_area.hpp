@@ -30,7 +30,6 @@ class EvaluatorDrivableArea : public BaseEvaluator {
 
   virtual EvaluationReturn Evaluate(const world::World& world) {
     using bark::geometry::Polygon;
-    namespace bg = boost::geometry;
 
     if (agent_id_ != std::numeric_limits<AgentId>::max()) {
       const auto& agent = world.GetAgent(agent_id_);
@@ -38,8 +37,7 @@ class EvaluatorDrivableArea : public BaseEvaluator {
         return true;
       }
       Polygon poly_agent = agent->GetPolygonFromState(agent->GetCurrentState());
-      const auto& poly_road = agent->GetRoadCorridor()->GetPolygon();
-      if (!bg::within(poly_agent.obj_, poly_road.obj_)) {
+      if (!agent->GetRoadCorridor()->IsWithinPolygon(poly_agent)) {
         return true;
       }
       return false;
@@ -48,8 +46,7 @@ class EvaluatorDrivableArea : public BaseEvaluator {
     for (const auto& agent : world.GetValidAgents()) {
       Polygon poly_agent =
           agent.second->GetPolygonFromState(agent.second->GetCurrentState());
-      auto poly_road = agent.second->GetRoadCorridor()->GetPolygon();
-      if (!bg::within(poly_agent.obj_, poly_road.obj_)) {
+      if (!agent.second->GetRoadCorridor()->IsWithinPolygon(poly_agent)) {
         return true;
       }
     }
@@ -59,12 +56,10 @@ class EvaluatorDrivableArea : public BaseEvaluator {
   virtual EvaluationReturn Evaluate(
       const world::ObservedWorld& observed_world) {
     using bark::geometry::Polygon;
-    namespace bg = boost::geometry;
 
     const auto& agent = observed_world.GetEgoAgent();
     Polygon poly_agent = agent->GetPolygonFromState(agent->GetCurrentState());
-    const auto& poly_road = agent->GetRoadCorridor()->GetPolygon();
-    if (!bg::within(poly_agent.obj_, poly_road.obj_)) {
+    if (!agent->GetRoadCorridor()->IsWithinPolygon(poly_agent)) {
       return true;
     }
     return false;
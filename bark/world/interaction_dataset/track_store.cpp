@@ -0,0 +1,235 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/world/interaction_dataset/track_store.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include "bark/geometry/angle.hpp"
+
+namespace bark {
+namespace world {
+namespace interaction_dataset {
+
+using geometry::Point2d;
+using geometry::Polygon;
+using geometry::Pose;
+using models::behavior::BehaviorStaticTrajectory;
+using models::dynamic::StateDefinition;
+using models::dynamic::Trajectory;
+using world::goal_definition::GoalDefinitionPolygon;
+using world::objects::Agent;
+
+namespace {
+
+struct MotionState {
+  int64_t timestamp_ms;
+  float x, y, vx, vy, psi_rad;
+};
+
+std::vector<std::string> SplitLine(const std::string& line) {
+  std::vector<std::string> fields;
+  std::stringstream stream(line);
+  std::string field;
+  while (std::getline(stream, field, ',')) {
+    if (!field.empty() && field.back() == '\r') field.pop_back();
+    fields.push_back(field);
+  }
+  return fields;
+}
+
+}  // namespace
+
+TrackStore::TrackStore(const std::string& filename) {
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open track file " + filename + ".");
+  }
+  std::string line;
+  if (!std::getline(file, line)) {
+    throw std::runtime_error("Track file " + filename + " is empty.");
+  }
+  const std::vector<std::string> header = SplitLine(line);
+  auto column = [&](const std::string& name) {
+    auto it = std::find(header.begin(), header.end(), name);
+    if (it == header.end()) {
+      throw std::runtime_error("Track file " + filename +
+                               " has no column " + name + ".");
+    }
+    return static_cast<std::size_t>(it - header.begin());
+  };
+  const std::size_t track_id_col = column("track_id");
+  const std::size_t timestamp_col = column("timestamp_ms");
+  const std::size_t agent_type_col = column("agent_type");
+  const std::size_t x_col = column("x");
+  const std::size_t y_col = column("y");
+  const std::size_t vx_col = column("vx");
+  const std::size_t vy_col = column("vy");
+  const std::size_t psi_col = column("psi_rad");
+  const std::size_t length_col = column("length");
+  const std::size_t width_col = column("width");
+
+  std::map<int, std::vector<MotionState>> motion_states;
+  while (std::getline(file, line)) {
+    if (line.empty() || line == "\r") continue;
+    const std::vector<std::string> fields = SplitLine(line);
+    if (fields.size() != header.size()) {
+      throw std::runtime_error("Track file " + filename +
+                               " has a malformed line: " + line);
+    }
+    const int track_id = std::stoi(fields[track_id_col]);
+    auto track = tracks_.find(track_id);
+    if (track == tracks_.end()) {
+      Track new_track;
+      new_track.track_id = track_id;
+      new_track.agent_type = fields[agent_type_col];
+      new_track.length = std::stod(fields[length_col]);
+      new_track.width = std::stod(fields[width_col]);
+      tracks_[track_id] = new_track;
+    }
+    motion_states[track_id].push_back(
+        MotionState{std::stoll(fields[timestamp_col]),
+                    std::stof(fields[x_col]), std::stof(fields[y_col]),
+                    std::stof(fields[vx_col]), std::stof(fields[vy_col]),
+                    std::stof(fields[psi_col])});
+  }
+
+  for (auto& track_states : motion_states) {
+    std::vector<MotionState>& states = track_states.second;
+    std::stable_sort(states.begin(), states.end(),
+                     [](const MotionState& a, const MotionState& b) {
+                       return a.timestamp_ms < b.timestamp_ms;
+                     });
+    Track& track = tracks_.at(track_states.first);
+    const int64_t first_timestamp_ms = states.front().timestamp_ms;
+    Trajectory trajectory(static_cast<int>(states.size()),
+                          static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+    track.timestamps_ms.reserve(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      const MotionState& state = states[i];
+      track.timestamps_ms.push_back(state.timestamp_ms);
+      trajectory(i, StateDefinition::TIME_POSITION) =
+          (state.timestamp_ms - first_timestamp_ms) / 1000.0;
+      trajectory(i, StateDefinition::X_POSITION) = state.x;
+      trajectory(i, StateDefinition::Y_POSITION) = state.y;
+      trajectory(i, StateDefinition::THETA_POSITION) =
+          geometry::Norm0To2PI(state.psi_rad);
+      trajectory(i, StateDefinition::VEL_POSITION) =
+          std::hypot(state.vx, state.vy);
+    }
+    track.states = std::make_shared<const Trajectory>(std::move(trajectory));
+  }
+}
+
+std::vector<int> TrackStore::GetTrackIds() const {
+  std::vector<int> track_ids;
+  track_ids.reserve(tracks_.size());
+  for (const auto& track : tracks_) {
+    track_ids.push_back(track.first);
+  }
+  return track_ids;
+}
+
+const Track& TrackStore::GetTrack(int track_id) const {
+  auto track = tracks_.find(track_id);
+  if (track == tracks_.end()) {
+    throw std::runtime_error("Unknown track id " + std::to_string(track_id) +
+                             ".");
+  }
+  return track->second;
+}
+
+std::pair<int, int> TrackStore::GetRowRange(const Track& track,
+                                            int64_t start_ms,
+                                            int64_t end_ms) {
+  const auto& timestamps = track.timestamps_ms;
+  const int first_row = static_cast<int>(
+      std::lower_bound(timestamps.begin(), timestamps.end(), start_ms) -
+      timestamps.begin());
+  const int last_row = static_cast<int>(
+      std::upper_bound(timestamps.begin(), timestamps.end(), end_ms) -
+      timestamps.begin());
+  return {first_row, std::max(0, last_row - first_row)};
+}
+
+BehaviorModelPtr TrackStore::MakeBehavior(
+    int track_id, int64_t start_ms, int64_t end_ms,
+    const commons::ParamsPtr& params) const {
+  const Track& track = GetTrack(track_id);
+  const std::pair<int, int> rows = GetRowRange(track, start_ms, end_ms);
+  const double time_offset =
+      (start_ms - track.timestamps_ms.front()) / 1000.0;
+  return std::make_shared<BehaviorStaticTrajectory>(
+      params, track.states, rows.first, rows.second, time_offset);
+}
+
+State TrackStore::GetInitState(int track_id, int64_t start_ms) const {
+  const Track& track = GetTrack(track_id);
+  const int64_t init_ms = std::max(start_ms, track.timestamps_ms.front());
+  auto timestamp = std::lower_bound(track.timestamps_ms.begin(),
+                                    track.timestamps_ms.end(), init_ms);
+  if (timestamp == track.timestamps_ms.end() || *timestamp != init_ms) {
+    throw std::runtime_error("Could not retrieve initial state of agent " +
+                             std::to_string(track_id) + " at t=" +
+                             std::to_string(start_ms) + ".");
+  }
+  State state = track.states->row(timestamp - track.timestamps_ms.begin());
+  state(StateDefinition::TIME_POSITION) = 0.0;
+  return state;
+}
+
+Polygon TrackStore::GetShape(int track_id, double wheelbase) const {
+  const Track& track = GetTrack(track_id);
+  const double offset = wheelbase / 2.0;
+  const double front = track.length / 2.0 + offset;
+  const double rear = -track.length / 2.0 + offset;
+  const double half_width = track.width / 2.0;
+  return Polygon(Pose(0, 0, 0), std::vector<Point2d>{
+                                    Point2d(front, -half_width),
+                                    Point2d(front, half_width),
+                                    Point2d(rear, half_width),
+                                    Point2d(rear, -half_width),
+                                    Point2d(front, -half_width)});
+}
+
+GoalDefinitionPtr TrackStore::GetGoalDefinition(int track_id) const {
+  const Track& track = GetTrack(track_id);
+  const auto last_state = track.states->row(track.states->rows() - 1);
+  Polygon goal_polygon(
+      Pose(0, 0, 0), std::vector<Point2d>{Point2d(-1.5, 0), Point2d(-1.5, 8),
+                                          Point2d(1.5, 8), Point2d(1.5, 0)});
+  auto translated_polygon =
+      std::dynamic_pointer_cast<Polygon>(goal_polygon.Translate(
+          Point2d(last_state(StateDefinition::X_POSITION),
+                  last_state(StateDefinition::Y_POSITION))));
+  return std::make_shared<GoalDefinitionPolygon>(*translated_polygon);
+}
+
+AgentPtr TrackStore::MakeAgent(int track_id, int64_t start_ms, int64_t end_ms,
+                               const commons::ParamsPtr& params,
+                               const DynamicModelPtr& dynamic_model,
+                               const ExecutionModelPtr& execution_model,
+                               const MapInterfacePtr& map_interface,
+                               double wheelbase) const {
+  AgentPtr agent = std::make_shared<Agent>(
+      GetInitState(track_id, start_ms),
+      MakeBehavior(track_id, start_ms, end_ms, params), dynamic_model,
+      execution_model, GetShape(track_id, wheelbase), params,
+      GetGoalDefinition(track_id), map_interface);
+  agent->SetAgentId(track_id);
+  return agent;
+}
+
+}  // namespace interaction_dataset
+}  // namespace world
+}  // namespace bark
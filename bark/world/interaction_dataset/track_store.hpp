@@ -0,0 +1,93 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_WORLD_INTERACTION_DATASET_TRACK_STORE_HPP_
+#define BARK_WORLD_INTERACTION_DATASET_TRACK_STORE_HPP_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bark/geometry/polygon.hpp"
+#include "bark/models/behavior/static_trajectory/behavior_static_trajectory.hpp"
+#include "bark/world/goal_definition/goal_definition_polygon.hpp"
+#include "bark/world/objects/agent.hpp"
+
+namespace bark {
+namespace world {
+namespace interaction_dataset {
+
+using models::behavior::BehaviorModelPtr;
+using models::behavior::StaticTrajectoryPtr;
+using models::dynamic::DynamicModelPtr;
+using models::dynamic::State;
+using models::execution::ExecutionModelPtr;
+using objects::AgentPtr;
+using world::goal_definition::GoalDefinitionPtr;
+using world::map::MapInterfacePtr;
+
+//! a recorded track of the INTERACTION dataset
+struct Track {
+  int track_id;
+  std::string agent_type;
+  double length;
+  double width;
+  //! sorted timestamps of the motion states in ms
+  std::vector<int64_t> timestamps_ms;
+  //! motion states as bark states, the time being relative to the first
+  //! timestamp; shared by the behavior models replaying the track
+  StaticTrajectoryPtr states;
+};
+
+//! Reads the tracks of an INTERACTION dataset csv file once and replays
+//! them without copying: the behavior models of the created agents
+//! reference windows of the per-track state arrays. Mirrors the
+//! conversions of interaction_dataset_reader.py.
+class TrackStore {
+ public:
+  explicit TrackStore(const std::string& filename);
+
+  std::vector<int> GetTrackIds() const;
+  std::size_t GetNumTracks() const { return tracks_.size(); }
+  const Track& GetTrack(int track_id) const;
+
+  //! replays the motion states with start_ms <= timestamp <= end_ms, the
+  //! time start_ms being time zero
+  BehaviorModelPtr MakeBehavior(int track_id, int64_t start_ms, int64_t end_ms,
+                                const commons::ParamsPtr& params) const;
+  //! state at start_ms, or at the begin of the track if it starts later
+  State GetInitState(int track_id, int64_t start_ms) const;
+  geometry::Polygon GetShape(int track_id, double wheelbase) const;
+  //! goal around the last position of the track
+  GoalDefinitionPtr GetGoalDefinition(int track_id) const;
+
+  AgentPtr MakeAgent(int track_id, int64_t start_ms, int64_t end_ms,
+                     const commons::ParamsPtr& params,
+                     const DynamicModelPtr& dynamic_model,
+                     const ExecutionModelPtr& execution_model,
+                     const MapInterfacePtr& map_interface,
+                     double wheelbase) const;
+
+ private:
+  //! rows of the motion states with start_ms <= timestamp <= end_ms
+  static std::pair<int, int> GetRowRange(const Track& track, int64_t start_ms,
+                                         int64_t end_ms);
+
+  std::map<int, Track> tracks_;
+};
+
+typedef std::shared_ptr<TrackStore> TrackStorePtr;
+
+}  // namespace interaction_dataset
+}  // namespace world
+}  // namespace bark
+
+#endif  // BARK_WORLD_INTERACTION_DATASET_TRACK_STORE_HPP_
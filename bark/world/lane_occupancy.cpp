@@ -0,0 +1,108 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/world/lane_occupancy.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace bark {
+namespace world {
+
+namespace {
+
+bool OccupantLess(const LaneOccupant& lhs, const LaneOccupant& rhs) {
+  if (lhs.s != rhs.s) return lhs.s < rhs.s;
+  return lhs.agent_id < rhs.agent_id;
+}
+
+}  // namespace
+
+LaneOccupancy::LaneOccupancy(std::vector<LaneOccupant> occupants,
+                             std::size_t num_intersecting_agents,
+                             float lane_length)
+    : occupants_(std::move(occupants)),
+      num_intersecting_agents_(num_intersecting_agents),
+      lane_length_(lane_length) {
+  std::sort(occupants_.begin(), occupants_.end(), OccupantLess);
+}
+
+const LaneOccupant* LaneOccupancy::GetOccupant(const AgentId& agent_id) const {
+  for (const auto& occupant : occupants_) {
+    if (occupant.agent_id == agent_id) return &occupant;
+  }
+  return nullptr;
+}
+
+FrontRearAgents LaneOccupancy::GetFrontRear(
+    const AgentId& ego_agent_id, const FrenetPosition& ego_frenet) const {
+  FrontRearAgents fr_agents;
+  if (num_intersecting_agents_ == 0) {
+    fr_agents.front = std::make_pair(AgentPtr(nullptr), FrenetPosition(0, 0));
+    fr_agents.rear = fr_agents.front;
+    return fr_agents;
+  }
+  const double numeric_max = std::numeric_limits<double>::max();
+  fr_agents.front =
+      std::make_pair(AgentPtr(nullptr), FrenetPosition(numeric_max, numeric_max));
+  fr_agents.rear = fr_agents.front;
+
+  auto s_less = [](const LaneOccupant& occupant, double s) {
+    return occupant.s < s;
+  };
+  auto s_greater = [](double s, const LaneOccupant& occupant) {
+    return s < occupant.s;
+  };
+
+  // nearest agent in front; equal distances are resolved by the agent id
+  auto front = std::upper_bound(occupants_.begin(), occupants_.end(),
+                                ego_frenet.lon, s_greater);
+  while (front != occupants_.end() && front->agent_id == ego_agent_id) ++front;
+  if (front != occupants_.end()) {
+    fr_agents.front = std::make_pair(
+        front->agent, FrenetPosition(front->s - ego_frenet.lon,
+                                     front->lat - ego_frenet.lat));
+  }
+
+  // nearest agent behind; first agent of the group with the largest s
+  auto rear = std::lower_bound(occupants_.begin(), occupants_.end(),
+                               ego_frenet.lon, s_less);
+  auto nearest_rear = occupants_.end();
+  while (rear != occupants_.begin()) {
+    --rear;
+    if (rear->agent_id == ego_agent_id) continue;
+    if (nearest_rear != occupants_.end() && rear->s != nearest_rear->s) break;
+    nearest_rear = rear;
+  }
+  if (nearest_rear != occupants_.end()) {
+    fr_agents.rear = std::make_pair(
+        nearest_rear->agent, FrenetPosition(nearest_rear->s - ego_frenet.lon,
+                                            nearest_rear->lat - ego_frenet.lat));
+  }
+  return fr_agents;
+}
+
+std::vector<LaneOccupant> LaneOccupancy::GetNearest(
+    double s, std::size_t k, const AgentId& excluded_agent_id) const {
+  std::vector<LaneOccupant> nearest;
+  auto upper = std::lower_bound(
+      occupants_.begin(), occupants_.end(), s,
+      [](const LaneOccupant& occupant, double s) { return occupant.s < s; });
+  auto lower = upper;
+  while (nearest.size() < k &&
+         (lower != occupants_.begin() || upper != occupants_.end())) {
+    bool take_upper =
+        lower == occupants_.begin() ||
+        (upper != occupants_.end() && upper->s - s <= s - (lower - 1)->s);
+    const LaneOccupant& occupant = take_upper ? *upper++ : *--lower;
+    if (occupant.agent_id != excluded_agent_id) nearest.push_back(occupant);
+  }
+  return nearest;
+}
+
+}  // namespace world
+}  // namespace bark
@@ -0,0 +1,140 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_WORLD_LANE_OCCUPANCY_HPP_
+#define BARK_WORLD_LANE_OCCUPANCY_HPP_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bark/commons/transformation/frenet.hpp"
+#include "bark/world/map/lane_corridor.hpp"
+#include "bark/world/objects/agent.hpp"
+
+namespace bark {
+namespace world {
+
+using bark::commons::transformation::FrenetPosition;
+using world::map::LaneCorridor;
+using world::map::LaneCorridorPtr;
+using world::objects::AgentId;
+using world::objects::AgentPtr;
+
+typedef std::pair<AgentPtr, FrenetPosition> AgentFrenetPair;
+
+struct FrontRearAgents {
+  AgentFrenetPair front;
+  AgentFrenetPair rear;
+};
+
+//! front and rear agents of an agent on a lane corridor, its frenet
+//! position and the distance until the end of the lane corridor
+struct LaneScan {
+  FrontRearAgents front_rear;
+  FrenetPosition frenet;
+  float remaining_distance;
+};
+
+//! agent on a lane corridor with its frenet position along the center line
+struct LaneOccupant {
+  double s;
+  double lat;
+  AgentId agent_id;
+  AgentPtr agent;
+};
+
+//! Agents that occupy a lane corridor, sorted by their longitudinal
+//! position. Only valid agents whose shape intersects the merged lane
+//! corridor polygon and whose lateral offset is smaller than the given
+//! fraction of the lane width are contained.
+class LaneOccupancy {
+ public:
+  LaneOccupancy(std::vector<LaneOccupant> occupants,
+                std::size_t num_intersecting_agents, float lane_length);
+
+  //! nearest agents in front and behind of the ego position
+  FrontRearAgents GetFrontRear(const AgentId& ego_agent_id,
+                               const FrenetPosition& ego_frenet) const;
+
+  //! the k occupants closest to s, ordered by their distance to s
+  std::vector<LaneOccupant> GetNearest(double s, std::size_t k,
+                                       const AgentId& excluded_agent_id) const;
+
+  //! occupant with the given id or nullptr
+  const LaneOccupant* GetOccupant(const AgentId& agent_id) const;
+
+  const std::vector<LaneOccupant>& GetOccupants() const { return occupants_; }
+  //! length of the center line of the lane corridor
+  float GetLaneLength() const { return lane_length_; }
+  std::size_t GetNumIntersectingAgents() const {
+    return num_intersecting_agents_;
+  }
+
+ private:
+  std::vector<LaneOccupant> occupants_;
+  //! number of valid agents intersecting the lane corridor before lateral
+  //! filtering
+  std::size_t num_intersecting_agents_;
+  float lane_length_;
+};
+typedef std::shared_ptr<const LaneOccupancy> LaneOccupancyPtr;
+
+//! Lazily built lane occupancies of a world snapshot that are shared by
+//! all observed worlds of one planning step. Thread-safe.
+class LaneOccupancyIndex {
+ public:
+  template <typename BuildFunction>
+  LaneOccupancyPtr Get(const LaneCorridorPtr& lane_corridor,
+                       const BuildFunction& build) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = occupancies_.find(lane_corridor.get());
+    if (it != occupancies_.end()) return it->second.second;
+    LaneOccupancyPtr occupancy = build(lane_corridor);
+    // the corridor is kept alive so that its address cannot be reused
+    occupancies_[lane_corridor.get()] = std::make_pair(lane_corridor, occupancy);
+    return occupancy;
+  }
+  std::size_t GetSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return occupancies_.size();
+  }
+
+  //! frenet position of an agent that is not an occupant of the lane
+  //! corridor, e.g., of an ego agent scanning its neighboring lanes
+  template <typename ProjectFunction>
+  FrenetPosition GetFrenetPosition(const LaneCorridorPtr& lane_corridor,
+                                   const AgentId& agent_id,
+                                   const ProjectFunction& project) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = std::make_pair(lane_corridor.get(), agent_id);
+    auto it = frenet_positions_.find(key);
+    if (it != frenet_positions_.end()) return it->second;
+    FrenetPosition frenet = project(lane_corridor);
+    frenet_positions_[key] = frenet;
+    return frenet;
+  }
+
+ private:
+  std::unordered_map<const LaneCorridor*,
+                     std::pair<LaneCorridorPtr, LaneOccupancyPtr>>
+      occupancies_;
+  //! only valid for corridors that are kept alive in occupancies_
+  std::map<std::pair<const LaneCorridor*, AgentId>, FrenetPosition>
+      frenet_positions_;
+  mutable std::mutex mutex_;
+};
+typedef std::shared_ptr<LaneOccupancyIndex> LaneOccupancyIndexPtr;
+
+}  // namespace world
+}  // namespace bark
+
+#endif  // BARK_WORLD_LANE_OCCUPANCY_HPP_
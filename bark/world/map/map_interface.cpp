@@ -21,7 +21,13 @@ bool MapInterface::interface_from_opendrive(
   open_drive_map_ = open_drive_map;
 
   RoadgraphPtr roadgraph(new Roadgraph());
-  roadgraph->Generate(open_drive_map);
+  if (map_tiles_) {
+    // the topology stays resident, the polygons are loaded per tile
+    roadgraph->GenerateTopology(open_drive_map);
+    map_tiles_->Build(roadgraph);
+  } else {
+    roadgraph->Generate(open_drive_map);
+  }
   roadgraph_ = roadgraph;
 
   rtree_lane_.clear();
@@ -37,6 +43,8 @@ bool MapInterface::interface_from_opendrive(
   }
 
   bounding_box_ = open_drive_map_->BoundingBox();
+  // cached routes refer to the previous map
+  route_cache_.Clear();
   return true;
 }
 
@@ -83,7 +91,7 @@ XodrLanePtr MapInterface::FindXodrLane(const Point2d& point) const {
 bool MapInterface::IsInXodrLane(const Point2d& point, XodrLaneId id) const {
   std::pair<vertex_t, bool> v = roadgraph_->GetVertexByLaneId(id);
   if (v.second) {
-    auto polygon = roadgraph_->GetLaneGraph()[v.first].polygon;
+    auto polygon = GetXodrLanePolygon(id);
     if (!polygon) {
       // found vertex has no polygon
       return false;
@@ -102,6 +110,14 @@ bool MapInterface::IsInXodrLane(const Point2d& point, XodrLaneId id) const {
   }
 }
 
+PolygonPtr MapInterface::GetXodrLanePolygon(const XodrLaneId& id) const {
+  std::pair<vertex_t, bool> v = roadgraph_->GetVertexByLaneId(id);
+  if (!v.second) return nullptr;
+  PolygonPtr polygon = roadgraph_->GetLaneGraph()[v.first].polygon;
+  if (!polygon && map_tiles_) polygon = map_tiles_->GetLanePolygon(id);
+  return polygon;
+}
+
 std::vector<PathBoundaries> MapInterface::ComputeAllPathBoundaries(
     const std::vector<XodrLaneId>& lane_ids) const {
   std::vector<XodrLaneEdgeType> LANE_SUCCESSOR_EDGEs = {
@@ -231,7 +247,10 @@ void MapInterface::CalculateLaneCorridors(RoadCorridorPtr& road_corridor,
 LanePtr MapInterface::GenerateRoadCorridorLane(const XodrLanePtr& xodr_lane) {
   LanePtr lane = std::make_shared<Lane>(xodr_lane);
   // polygons
-  if (xodr_lane->GetLanePosition() != 0) {
+  if (xodr_lane->GetLanePosition() != 0 && map_tiles_) {
+    PolygonPtr polygon = map_tiles_->GetLanePolygon(xodr_lane->GetId());
+    if (polygon) lane->SetPolygon(*polygon);
+  } else if (xodr_lane->GetLanePosition() != 0) {
     std::pair<PolygonPtr, bool> polygon_success =
         roadgraph_->ComputeXodrLanePolygon(xodr_lane->GetId());
     // Cannot compute polygon for planview!!
@@ -258,11 +277,18 @@ RoadPtr MapInterface::GenerateRoadCorridorRoad(const XodrRoadId& road_id) {
 void MapInterface::GenerateRoadCorridor(
     const std::vector<XodrRoadId>& road_ids,
     const XodrDrivingDirection& driving_direction) {
+  std::lock_guard<std::mutex> lock(road_corridors_mutex_);
+  GenerateRoadCorridorLocked(road_ids, driving_direction);
+}
+
+void MapInterface::GenerateRoadCorridorLocked(
+    const std::vector<XodrRoadId>& road_ids,
+    const XodrDrivingDirection& driving_direction) {
   std::size_t road_corridor_hash =
       RoadCorridor::GetHash(driving_direction, road_ids);
 
   // only compute if it has not been computed yet
-  if (road_corridors_.count(road_corridor_hash) > 0) return;
+  if (road_corridors_.Contains(road_corridor_hash)) return;
 
   Roads roads;
   for (auto& road_id : road_ids)
@@ -348,9 +374,11 @@ void MapInterface::GenerateRoadCorridor(
   road_corridor->SetRoads(roads);
   CalculateLaneCorridors(road_corridor, road_ids[0]);
   road_corridor->ComputeRoadPolygon();
+  if (road_sdf_grid_resolution_ > 0.0)
+    road_corridor->ComputeSignedDistanceGrid(road_sdf_grid_resolution_);
   road_corridor->SetRoadIds(road_ids);
   road_corridor->SetDrivingDirection(driving_direction);
-  road_corridors_[road_corridor_hash] = road_corridor;
+  road_corridors_.Put(road_corridor_hash, road_corridor);
 }
 
 RoadCorridorPtr MapInterface::GenerateRoadCorridor(
@@ -370,6 +398,12 @@ RoadCorridorPtr MapInterface::GenerateRoadCorridor(
   const XodrDrivingDirection driving_direction =
       lanes.at(0)->GetDrivingDirection();
 
+  // the driving direction follows from the start lane, so the lane ids
+  // fully determine the road corridor
+  const RouteCacheKey route_key(start_lane_id, goal_lane_id);
+  RoadCorridorPtr road_corridor;
+  if (route_cache_.Get(route_key, &road_corridor)) return road_corridor;
+
   std::vector<XodrRoadId> road_ids;
   std::vector<XodrLaneId> lane_ids =
       roadgraph_->FindDrivableLanePath(start_lane_id, goal_lane_id);
@@ -380,8 +414,13 @@ RoadCorridorPtr MapInterface::GenerateRoadCorridor(
     // std::cout << "lane_id: " << lid << ", road_id: ";
     // std::cout << lv.road_id << std::endl;
   }
-  GenerateRoadCorridor(road_ids, driving_direction);
-  return GetRoadCorridor(road_ids, driving_direction);
+  {
+    std::lock_guard<std::mutex> lock(road_corridors_mutex_);
+    GenerateRoadCorridorLocked(road_ids, driving_direction);
+    road_corridor = FindRoadCorridor(road_ids, driving_direction);
+  }
+  if (road_corridor) route_cache_.Put(route_key, road_corridor);
+  return road_corridor;
 }
 
 RoadCorridorPtr MapInterface::GenerateRoadCorridor(
@@ -396,8 +435,9 @@ RoadCorridorPtr MapInterface::GenerateRoadCorridor(
     return nullptr;
   }
   XodrDrivingDirection driving_direction = directions.first.at(0);
-  GenerateRoadCorridor(road_ids, driving_direction);
-  return GetRoadCorridor(road_ids, driving_direction);
+  std::lock_guard<std::mutex> lock(road_corridors_mutex_);
+  GenerateRoadCorridorLocked(road_ids, driving_direction);
+  return FindRoadCorridor(road_ids, driving_direction);
 }
 
 bool MapInterface::XodrLaneIdAtPolygon(const bark::geometry::Polygon& polygon,
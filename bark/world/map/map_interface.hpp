@@ -9,13 +9,19 @@
 #ifndef BARK_WORLD_MAP_MAP_INTERFACE_HPP_
 #define BARK_WORLD_MAP_MAP_INTERFACE_HPP_
 
+#include <boost/functional/hash.hpp>
 #include <boost/geometry/index/rtree.hpp>
+#include <algorithm>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
+#include "bark/commons/util/lru_cache.hpp"
 #include "bark/geometry/geometry.hpp"
 #include "bark/world/map/map_interface.hpp"
+#include "bark/world/map/map_tiles.hpp"
 #include "bark/world/map/road_corridor.hpp"
 #include "bark/world/map/roadgraph.hpp"
 
@@ -38,8 +44,20 @@ using rtree_lane =
                                   boost::geometry::index::linear<16, 4>>;
 using PathBoundaries = std::vector<std::pair<XodrLanePtr, XodrLanePtr>>;
 
+//! routes are identified by their start and goal lane ids
+using RouteCacheKey = std::pair<XodrLaneId, XodrLaneId>;
+using RouteCache = bark::commons::LruCache<RouteCacheKey, RoadCorridorPtr,
+                                           boost::hash<RouteCacheKey>>;
+//! road corridors are identified by RoadCorridor::GetHash
+using RoadCorridorCache = bark::commons::LruCache<std::size_t, RoadCorridorPtr>;
+
 class MapInterface {
  public:
+  MapInterface()
+      : road_corridors_(std::numeric_limits<std::size_t>::max()),
+        route_cache_(256),
+        road_sdf_grid_resolution_(0.0) {}
+
   bool interface_from_opendrive(const OpenDriveMapPtr& open_drive_map);
 
   bool FindNearestXodrLanes(const Point2d& point, const unsigned& num_lanes,
@@ -50,6 +68,9 @@ class MapInterface {
 
   bool IsInXodrLane(const Point2d& point, XodrLaneId id) const;
 
+  //! polygon of the roadgraph vertex or, in tiled mode, of the loaded tile
+  PolygonPtr GetXodrLanePolygon(const XodrLaneId& id) const;
+
   std::vector<PathBoundaries> ComputeAllPathBoundaries(
       const std::vector<XodrLaneId>& lane_ids) const;
   std::pair<XodrLanePtr, bool> GetInnerNeighbor(const XodrLaneId lane_id) const;
@@ -68,6 +89,9 @@ class MapInterface {
 
   bool SetRoadgraph(RoadgraphPtr roadgraph) {
     roadgraph_ = roadgraph;
+    if (map_tiles_) map_tiles_->Build(roadgraph_);
+    // cached routes refer to the previous roadgraph
+    route_cache_.Clear();
     return true;
   }
 
@@ -100,11 +124,46 @@ class MapInterface {
   RoadCorridorPtr GetRoadCorridor(
       const std::vector<XodrRoadId>& road_ids,
       const XodrDrivingDirection& driving_direction) {
-    std::size_t rc_hash = RoadCorridor::GetHash(driving_direction, road_ids);
-    if (road_corridors_.count(rc_hash) == 0) return nullptr;
-    return road_corridors_.at(rc_hash);
+    std::lock_guard<std::mutex> lock(road_corridors_mutex_);
+    return FindRoadCorridor(road_ids, driving_direction);
+  }
+
+  //! Route cache for GenerateRoadCorridor(start_point, goal_region)
+  void SetRouteCacheCapacity(std::size_t capacity) {
+    route_cache_.SetCapacity(capacity);
+  }
+  std::size_t GetRouteCacheCapacity() const {
+    return route_cache_.GetCapacity();
+  }
+  std::size_t GetRouteCacheSize() const { return route_cache_.GetSize(); }
+  std::size_t GetRouteCacheHits() const { return route_cache_.GetHits(); }
+  std::size_t GetRouteCacheMisses() const { return route_cache_.GetMisses(); }
+  void ClearRouteCache() { route_cache_.Clear(); }
+
+  //! Signed distance grids of newly generated road corridors (0 disables)
+  void SetRoadSignedDistanceGridResolution(double resolution) {
+    road_sdf_grid_resolution_ = resolution;
+  }
+  double GetRoadSignedDistanceGridResolution() const {
+    return road_sdf_grid_resolution_;
   }
 
+  //! Tiled mode: lane polygons are not kept in the roadgraph but computed
+  //! per tile on demand; needs to be enabled before the map is set.
+  //! Road corridors hold their lane polygons, so the generated and the
+  //! cached road corridors are bounded as well.
+  void EnableTiling(double tile_size, std::size_t max_num_tiles,
+                    std::size_t max_num_road_corridors = 64) {
+    map_tiles_ = std::make_shared<MapTiles>(tile_size, max_num_tiles);
+    if (roadgraph_) map_tiles_->Build(roadgraph_);
+    road_corridors_.SetCapacity(max_num_road_corridors);
+    route_cache_.SetCapacity(
+        std::min(route_cache_.GetCapacity(), max_num_road_corridors));
+  }
+  std::size_t GetNumRoadCorridors() const { return road_corridors_.GetSize(); }
+  bool IsTiled() const { return map_tiles_ != nullptr; }
+  MapTilesPtr GetMapTiles() const { return map_tiles_; }
+
   LaneId FindCurrentLane(const Point2d& pt) {
     return FindXodrLane(pt)->GetId();
   }
@@ -114,11 +173,28 @@ class MapInterface {
   }
 
  private:
+  // both require road_corridors_mutex_ to be held
+  void GenerateRoadCorridorLocked(
+      const std::vector<XodrRoadId>& road_ids,
+      const XodrDrivingDirection& driving_direction);
+  RoadCorridorPtr FindRoadCorridor(
+      const std::vector<XodrRoadId>& road_ids,
+      const XodrDrivingDirection& driving_direction) {
+    std::size_t rc_hash = RoadCorridor::GetHash(driving_direction, road_ids);
+    RoadCorridorPtr road_corridor;
+    road_corridors_.Get(rc_hash, &road_corridor);
+    return road_corridor;
+  }
+
   OpenDriveMapPtr open_drive_map_;
   RoadgraphPtr roadgraph_;
   rtree_lane rtree_lane_;
   std::pair<Point2d, Point2d> bounding_box_;
-  std::map<std::size_t, RoadCorridorPtr> road_corridors_;
+  RoadCorridorCache road_corridors_;
+  std::mutex road_corridors_mutex_;
+  RouteCache route_cache_;
+  double road_sdf_grid_resolution_;
+  MapTilesPtr map_tiles_;
 
   static bool IsLaneType(rtree_lane_value const& m) {
     return (m.second->GetLaneType() == XodrLaneType::DRIVING);
@@ -0,0 +1,80 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/world/map/map_tiles.hpp"
+#include <cmath>
+
+namespace bark {
+namespace world {
+namespace map {
+
+namespace bg = boost::geometry;
+
+void MapTiles::Build(const RoadgraphPtr& roadgraph) {
+  roadgraph_ = roadgraph;
+  lanes_by_tile_.clear();
+  tile_by_lane_.clear();
+  tiles_.Clear();
+  for (auto const& v : roadgraph_->GetVertices()) {
+    const XodrLanePtr& lane = roadgraph_->GetLaneGraph()[v].lane;
+    // plan views do not have a polygon
+    if (lane->GetLanePosition() == 0) continue;
+    const bark::geometry::Line line = lane->GetLine();
+    if (line.obj_.empty()) continue;
+    // lanes are assigned to the tile containing their bounding box center
+    auto bbox = line.BoundingBox();
+    bark::geometry::Point2d center(
+        (bg::get<0>(bbox.first) + bg::get<0>(bbox.second)) / 2.0f,
+        (bg::get<1>(bbox.first) + bg::get<1>(bbox.second)) / 2.0f);
+    TileKey key = GetTileKey(center);
+    lanes_by_tile_[key].push_back(lane->GetId());
+    tile_by_lane_[lane->GetId()] = key;
+  }
+  // the roadgraph must not keep the tiles alive
+  std::weak_ptr<MapTiles> weak_tiles = weak_from_this();
+  roadgraph_->SetLanePolygonSource([weak_tiles](const XodrLaneId& lane_id) {
+    MapTilesPtr tiles = weak_tiles.lock();
+    return tiles ? tiles->GetLanePolygon(lane_id) : nullptr;
+  });
+}
+
+PolygonPtr MapTiles::GetLanePolygon(const XodrLaneId& lane_id) {
+  auto tile_key = tile_by_lane_.find(lane_id);
+  if (tile_key == tile_by_lane_.end()) return nullptr;
+  MapTilePtr tile;
+  if (!tiles_.Get(tile_key->second, &tile)) {
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    // another thread may have loaded the tile meanwhile
+    if (!tiles_.Get(tile_key->second, &tile)) {
+      tile = LoadTile(tile_key->second);
+      tiles_.Put(tile_key->second, tile);
+      ++num_tile_loads_;
+    }
+  }
+  auto polygon = tile->lane_polygons.find(lane_id);
+  if (polygon == tile->lane_polygons.end()) return nullptr;
+  return polygon->second;
+}
+
+TileKey MapTiles::GetTileKey(const bark::geometry::Point2d& pt) const {
+  return TileKey(static_cast<int>(std::floor(bg::get<0>(pt) / tile_size_)),
+                 static_cast<int>(std::floor(bg::get<1>(pt) / tile_size_)));
+}
+
+MapTilePtr MapTiles::LoadTile(const TileKey& key) const {
+  MapTilePtr tile = std::make_shared<MapTile>();
+  for (auto const& lane_id : lanes_by_tile_.at(key)) {
+    auto polygon = roadgraph_->ComputeXodrLanePolygon(lane_id);
+    if (polygon.second) tile->lane_polygons[lane_id] = polygon.first;
+  }
+  return tile;
+}
+
+}  // namespace map
+}  // namespace world
+}  // namespace bark
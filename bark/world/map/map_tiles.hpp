@@ -0,0 +1,75 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_WORLD_MAP_MAP_TILES_HPP_
+#define BARK_WORLD_MAP_MAP_TILES_HPP_
+
+#include <boost/functional/hash.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "bark/commons/util/lru_cache.hpp"
+#include "bark/world/map/roadgraph.hpp"
+
+namespace bark {
+namespace world {
+namespace map {
+
+using TileKey = std::pair<int, int>;
+
+//! lane polygons of all lanes assigned to one tile
+struct MapTile {
+  std::unordered_map<XodrLaneId, PolygonPtr> lane_polygons;
+};
+using MapTilePtr = std::shared_ptr<MapTile>;
+
+//! Groups the lanes of a roadgraph into square spatial tiles and computes
+//! the lane polygons tile-wise on demand. At most max_num_tiles tiles are
+//! kept in memory; the least recently used tile is evicted first.
+class MapTiles : public std::enable_shared_from_this<MapTiles> {
+ public:
+  MapTiles(double tile_size, std::size_t max_num_tiles)
+      : tile_size_(tile_size), tiles_(max_num_tiles), num_tile_loads_(0) {}
+
+  //! assigns all lanes to tiles and makes the roadgraph serve its lane
+  //! polygons from the tiles; the topology is kept by the roadgraph
+  void Build(const RoadgraphPtr& roadgraph);
+
+  //! loads the tile of the lane if required; concurrent callers missing
+  //! the same tile load it once
+  PolygonPtr GetLanePolygon(const XodrLaneId& lane_id);
+
+  TileKey GetTileKey(const bark::geometry::Point2d& pt) const;
+  double GetTileSize() const { return tile_size_; }
+  std::size_t GetMaxNumTiles() const { return tiles_.GetCapacity(); }
+  std::size_t GetNumTiles() const { return lanes_by_tile_.size(); }
+  std::size_t GetNumLoadedTiles() const { return tiles_.GetSize(); }
+  std::size_t GetNumTileLoads() const { return num_tile_loads_; }
+
+ private:
+  MapTilePtr LoadTile(const TileKey& key) const;
+
+  double tile_size_;
+  RoadgraphPtr roadgraph_;
+  std::unordered_map<TileKey, std::vector<XodrLaneId>, boost::hash<TileKey>>
+      lanes_by_tile_;
+  std::unordered_map<XodrLaneId, TileKey> tile_by_lane_;
+  bark::commons::LruCache<TileKey, MapTilePtr, boost::hash<TileKey>> tiles_;
+  std::atomic<std::size_t> num_tile_loads_;
+  std::mutex load_mutex_;
+};
+using MapTilesPtr = std::shared_ptr<MapTiles>;
+
+}  // namespace map
+}  // namespace world
+}  // namespace bark
+
+#endif  // BARK_WORLD_MAP_MAP_TILES_HPP_
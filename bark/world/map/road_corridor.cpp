@@ -8,6 +8,7 @@
 
 #include "bark/world/map/road_corridor.hpp"
 #include <memory>
+#include <set>
 #include <utility>
 #include "bark/commons/transformation/frenet.hpp"
 
@@ -15,6 +16,118 @@ namespace bark {
 namespace world {
 namespace map {
 
+namespace bg = boost::geometry;
+using MultiPolygon = bg::model::multi_polygon<bg::model::polygon<Point2d>>;
+
+namespace {
+
+MultiPolygon BufferMultiPolygon(const MultiPolygon& polygons,
+                                double distance) {
+  namespace bbuf = bg::strategy::buffer;
+  bbuf::distance_symmetric<float> distance_strategy(distance);
+  bbuf::side_straight side_strategy;
+  bbuf::join_miter join_strategy;
+  bbuf::end_flat end_strategy;
+  bbuf::point_circle point_strategy;
+  MultiPolygon buffered_polygons;
+  bg::buffer(polygons, buffered_polygons, distance_strategy, side_strategy,
+             join_strategy, end_strategy, point_strategy);
+  bg::correct(buffered_polygons);
+  return buffered_polygons;
+}
+
+}  // namespace
+
+bool RoadCorridor::ComputeRoadPolygon(double buffer_dist) {
+  // the merged polygon of a lane corridor is built from its continuous left
+  // and right boundaries and thus has no gaps between consecutive lanes
+  std::vector<MultiPolygon> parts;
+  std::set<LaneId> merged_lane_ids;
+  for (const auto& lane_corr : unique_lane_corridors_) {
+    MultiPolygon part;
+    part.push_back(lane_corr->GetMergedPolygon().obj_);
+    bg::correct(part);
+    if (!bg::is_empty(part)) {
+      parts.push_back(part);
+      continue;
+    }
+    // fall back to the lane polygons, every lane is merged only once
+    for (const auto& lane : lane_corr->GetLanes()) {
+      if (!merged_lane_ids.insert(lane.second->GetId()).second) continue;
+      MultiPolygon lane_part;
+      lane_part.push_back(lane.second->GetPolygon().obj_);
+      bg::correct(lane_part);
+      if (bg::is_empty(lane_part)) continue;
+      parts.push_back(lane_part);
+    }
+  }
+  road_polygon_ = Polygon();
+  road_sdf_grid_.reset();
+  if (parts.empty()) return false;
+
+  // cascaded union: consecutive parts are spatial neighbors, so merging
+  // pairs keeps the intermediate polygons small
+  while (parts.size() > 1) {
+    std::vector<MultiPolygon> merged_parts((parts.size() + 1) / 2);
+    for (std::size_t i = 0; i + 1 < parts.size(); i += 2) {
+      bg::union_(parts[i], parts[i + 1], merged_parts[i / 2]);
+    }
+    if (parts.size() % 2 == 1) merged_parts.back() = std::move(parts.back());
+    parts.swap(merged_parts);
+  }
+  MultiPolygon merged_polygon = std::move(parts.front());
+
+  // parts that do not share their boundaries exactly leave gaps;
+  // these are closed by buffering the merged polygon once
+  if (merged_polygon.size() > 1) {
+    merged_polygon = BufferMultiPolygon(
+        BufferMultiPolygon(merged_polygon, buffer_dist), -buffer_dist);
+  }
+  if (merged_polygon.empty()) return false;
+
+  const auto largest = std::max_element(
+      merged_polygon.begin(), merged_polygon.end(),
+      [](const bg::model::polygon<Point2d>& lhs,
+         const bg::model::polygon<Point2d>& rhs) {
+        return bg::area(lhs) < bg::area(rhs);
+      });
+  // the road polygon is a single polygon; its holes are kept
+  if (merged_polygon.size() > 1) {
+    LOG(WARNING) << "Road polygon consists of " << merged_polygon.size()
+                 << " disjoint parts, only the largest one is kept.";
+  }
+  road_polygon_.obj_ = *largest;
+  return true;
+}
+
+bool RoadCorridor::ComputeRoadPolygonBuffered(double buffer_dist) {
+  Polygon merged_polygon;
+  // merge all lane polygons
+  for (const auto& lane_corr : unique_lane_corridors_) {
+    const auto& lanes = lane_corr->GetLanes();
+    for (const auto& lane : lanes) {
+      Polygon poly_buffered;
+      BufferPolygon(lane.second->GetPolygon(), buffer_dist, &poly_buffered);
+      merged_polygon.ConcatenatePolygons(poly_buffered);
+    }
+  }
+  Polygon poly_buffered_merged;
+  BufferPolygon(merged_polygon, -buffer_dist, &poly_buffered_merged);
+  road_polygon_ = poly_buffered_merged;
+  road_sdf_grid_.reset();
+  return true;
+}
+
+bool RoadCorridor::ComputeSignedDistanceGrid(double resolution) {
+  road_sdf_grid_ =
+      std::make_shared<SignedDistanceGrid>(road_polygon_, resolution);
+  if (road_sdf_grid_->Empty()) {
+    road_sdf_grid_.reset();
+    return false;
+  }
+  return true;
+}
+
 std::pair<LaneCorridorPtr, LaneCorridorPtr>
 RoadCorridor::GetLeftRightLaneCorridor(const Point2d& pt) const {
   LaneCorridorPtr current_lane_corr = GetCurrentLaneCorridor(pt);
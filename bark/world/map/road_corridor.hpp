@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 #include "bark/geometry/geometry.hpp"
+#include "bark/geometry/signed_distance_grid.hpp"
 #include "bark/world/map/lane.hpp"
 #include "bark/world/map/lane_corridor.hpp"
 #include "bark/world/map/road.hpp"
@@ -28,6 +29,8 @@ using bark::geometry::BufferPolygon;
 using bark::geometry::Line;
 using bark::geometry::Point2d;
 using bark::geometry::Polygon;
+using bark::geometry::SignedDistanceGrid;
+using bark::geometry::SignedDistanceGridPtr;
 using bark::geometry::Within;
 using bark::world::opendrive::XodrDrivingDirection;
 using bark::world::opendrive::XodrRoadId;
@@ -39,7 +42,10 @@ struct RoadCorridor {
     return roads_.at(road_id);
   }
   Roads GetRoads() const { return roads_; }
-  Polygon GetPolygon() const { return road_polygon_; }
+  const Polygon& GetPolygon() const { return road_polygon_; }
+  const SignedDistanceGridPtr& GetSignedDistanceGrid() const {
+    return road_sdf_grid_;
+  }
   Lanes GetLanes(const RoadId& road_id) const {
     return this->GetRoad(road_id)->GetLanes();
   }
@@ -101,29 +107,29 @@ struct RoadCorridor {
       const std::map<LaneId, LaneCorridorPtr>& lane_corridors) {
     lane_corridors_ = lane_corridors;
   }
-  bool ComputeRoadPolygon(double buffer_dist = 0.3) {
-    Polygon merged_polygon;
-    // merge all lane polygons
-    for (const auto& lane_corr : unique_lane_corridors_) {
-      const auto& lanes = lane_corr->GetLanes();
-      for (const auto& lane : lanes) {
-        Polygon poly_buffered;
-        BufferPolygon(lane.second->GetPolygon(), buffer_dist, &poly_buffered);
-        merged_polygon.ConcatenatePolygons(poly_buffered);
-      }
-    }
-    Polygon poly_buffered_merged;
-    BufferPolygon(merged_polygon, -buffer_dist, &poly_buffered_merged);
-    road_polygon_ = poly_buffered_merged;
-    return true;
+  //! merges all lane corridor polygons using a cascaded union; the buffer
+  //! distance is only applied if the polygons do not touch exactly
+  bool ComputeRoadPolygon(double buffer_dist = 0.3);
+  //! legacy merging that buffers every lane polygon (used for comparisons)
+  bool ComputeRoadPolygonBuffered(double buffer_dist = 0.3);
+  //! precomputes a signed distance grid of the road polygon that answers
+  //! most IsWithinPolygon queries without an exact polygon check
+  bool ComputeSignedDistanceGrid(double resolution = 0.25);
+  //! true if the polygon (e.g., an agent footprint) lies within the road
+  bool IsWithinPolygon(const Polygon& polygon) const {
+    return bark::geometry::Within(polygon, road_polygon_, road_sdf_grid_);
+  }
+  void SetPolygon(const Polygon& poly) {
+    road_polygon_ = poly;
+    road_sdf_grid_.reset();
   }
-  void SetPolygon(const Polygon& poly) { road_polygon_ = poly; }
   void SetRoadIds(const std::vector<XodrRoadId>& road_ids) {
     road_ids_ = road_ids;
   }
 
   Roads roads_;
   Polygon road_polygon_;
+  SignedDistanceGridPtr road_sdf_grid_;
   std::vector<LaneCorridorPtr> unique_lane_corridors_;
   std::vector<XodrRoadId> road_ids_;
   XodrDrivingDirection driving_direction_;
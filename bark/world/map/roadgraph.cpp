@@ -17,7 +17,12 @@ namespace map {
 XodrLaneId Roadgraph::AddLane(const XodrRoadId& road_id,
                               const XodrLanePtr& laneptr) {
   XodrLaneVertex lane = XodrLaneVertex(road_id, laneptr->GetId(), laneptr);
-  boost::add_vertex(lane, g_);
+  vertex_t v = boost::add_vertex(lane, g_);
+  // the first vertex of a lane id is used, as in a linear search
+  vertex_by_lane_id_.emplace(laneptr->GetId(), v);
+  if (laneptr->GetLanePosition() == 0)
+    plan_view_by_road_id_.emplace(road_id, laneptr->GetId());
+  ClearRoutingTables();
   return laneptr->GetId();
 }
 
@@ -79,8 +84,13 @@ std::vector<XodrRoadId> Roadgraph::FindRoadPath(const XodrRoadId& startid,
   std::vector<XodrRoadId> road_ids;
 
   if (start_pv.second && goal_pv.second) {
+    std::pair<std::vector<XodrLaneId>, bool> table_path =
+        FindPathInRoutingTable(road_routing_table_, start_pv.first,
+                               goal_pv.first);
     std::vector<XodrLaneId> lane_ids =
-        FindPath<EdgeTypeRoadSuccessor>(start_pv.first, goal_pv.first);
+        table_path.second
+            ? table_path.first
+            : FindPath<EdgeTypeRoadSuccessor>(start_pv.first, goal_pv.first);
 
     for (auto const& id : lane_ids) {
       road_ids.push_back(GetRoadForLaneId(id));
@@ -91,30 +101,87 @@ std::vector<XodrRoadId> Roadgraph::FindRoadPath(const XodrRoadId& startid,
 
 std::vector<XodrLaneId> Roadgraph::FindDrivableLanePath(
     const XodrLaneId& startid, const XodrLaneId& goalid) {
+  std::pair<std::vector<XodrLaneId>, bool> table_path =
+      FindPathInRoutingTable(lane_routing_table_, startid, goalid);
+  if (table_path.second) return table_path.first;
   return FindPath<TypeDriving>(startid, goalid);
 }
 
+bool Roadgraph::PrecomputeRoutingTables(std::size_t max_num_vertices) {
+  ClearRoutingTables();
+  const std::size_t num_vertices = boost::num_vertices(g_);
+  if (num_vertices > max_num_vertices) {
+    LOG(WARNING) << "Roadgraph has " << num_vertices
+                 << " vertices, routing tables are only computed for up to "
+                 << max_num_vertices << " vertices.";
+    return false;
+  }
+  // lane-level routing starts at driving lanes, road-level routing at the
+  // plan views
+  lane_routing_table_ =
+      ComputeRoutingTable<TypeDriving>([](vertex_t) { return true; });
+  road_routing_table_ =
+      ComputeRoutingTable<EdgeTypeRoadSuccessor>([this](vertex_t v) {
+        return g_[v].lane->GetLanePosition() == 0;
+      });
+  return true;
+}
+
+std::pair<std::vector<XodrLaneId>, bool> Roadgraph::FindPathInRoutingTable(
+    const RoutingTable& table, const XodrLaneId& startid,
+    const XodrLaneId& goalid) const {
+  std::vector<XodrLaneId> path;
+  if (table.Empty()) return std::make_pair(path, false);
+
+  std::pair<vertex_t, bool> start_vertex = GetVertexByLaneId(startid);
+  std::pair<vertex_t, bool> goal_vertex = GetVertexByLaneId(goalid);
+  if (!start_vertex.second || !goal_vertex.second ||
+      !table.vertex_mask.test(goal_vertex.first)) {
+    // no path, same as FindPath
+    return std::make_pair(path, true);
+  }
+  auto row = table.rows.find(start_vertex.first);
+  if (row == table.rows.end()) {
+    // start vertex is part of the filtered graph but was not precomputed
+    if (table.vertex_mask.test(start_vertex.first))
+      return std::make_pair(path, false);
+    return std::make_pair(path, true);
+  }
+
+  // get shortest path from predecessor map
+  const std::uint32_t* p =
+      &table.predecessors[row->second * table.num_vertices];
+  std::size_t idx = 0;
+  vertex_t current = goal_vertex.first;
+  while (current != start_vertex.first && idx < table.num_vertices) {
+    path.push_back(g_[current].global_lane_id);
+    if (current == p[current]) {
+      return std::make_pair(std::vector<XodrLaneId>(), true);
+    }
+    current = p[current];
+    ++idx;
+  }
+  path.push_back(g_[start_vertex.first].global_lane_id);
+  std::reverse(path.begin(), path.end());
+  return std::make_pair(path, true);
+}
+
 std::vector<std::vector<XodrLaneId>> Roadgraph::FindAllPathsInSubgraph(
     const std::vector<XodrLaneEdgeType>& edge_type_subset,
     const std::vector<XodrLaneId>& lane_id_subset) {
-  struct Predicate {
-    bool operator()(XodrLaneGraph::edge_descriptor edge_des) const {
-      XodrLaneEdgeType lane_edge_type = (*g)[edge_des].GetEdgeType();
-      return (find(edge_type_subset.begin(), edge_type_subset.end(),
-                   lane_edge_type) != edge_type_subset.end());
-    }
-    bool operator()(XodrLaneGraph::vertex_descriptor vertex_des) const {
-      XodrLaneId lane_id = (*g)[vertex_des].global_lane_id;
-      return (find(lane_id_subset.begin(), lane_id_subset.end(), lane_id) !=
-              lane_id_subset.end());
-    }
-
-    const XodrLaneGraph* g;
-    std::vector<XodrLaneEdgeType> edge_type_subset;
-    std::vector<XodrLaneId> lane_id_subset;
-  } predicate{&g_, edge_type_subset, lane_id_subset};
-  boost::filtered_graph<XodrLaneGraph, Predicate, Predicate> filtered_graph(
-      g_, predicate, predicate);
+  boost::dynamic_bitset<> vertex_mask(boost::num_vertices(g_));
+  for (auto const& lane_id : lane_id_subset) {
+    std::pair<vertex_t, bool> v = GetVertexByLaneId(lane_id);
+    if (v.second) vertex_mask.set(v.first);
+  }
+  unsigned int edge_type_mask = 0;
+  for (auto const& edge_type : edge_type_subset) {
+    edge_type_mask |= 1u << edge_type;
+  }
+  BitsetSubgraphFilter predicate{&g_, &vertex_mask, edge_type_mask};
+  boost::filtered_graph<XodrLaneGraph, BitsetSubgraphFilter,
+                        BitsetSubgraphFilter>
+      filtered_graph(g_, predicate, predicate);
 
   std::vector<std::vector<XodrLaneId>> paths;
 
@@ -187,14 +254,9 @@ std::vector<XodrLaneId> Roadgraph::GetAllLaneids() const {
 
 std::pair<XodrLaneId, bool> Roadgraph::GetPlanViewForRoadId(
     const XodrRoadId& id) const {
-  std::vector<XodrLaneId> ids;
-  std::vector<vertex_t> vertices = GetVertices();
-  for (auto const& v : vertices) {
-    if (GetLaneGraph()[v].road_id == id) {
-      if (GetLaneGraph()[v].lane->GetLanePosition() == 0) {
-        return std::make_pair(GetLaneGraph()[v].global_lane_id, true);
-      }
-    }
+  auto it = plan_view_by_road_id_.find(id);
+  if (it != plan_view_by_road_id_.end()) {
+    return std::make_pair(it->second, true);
   }
   return std::make_pair(0, false);
 }
@@ -237,7 +299,9 @@ std::pair<XodrLaneId, bool> Roadgraph::GetPlanViewForLaneId(
 
 PolygonPtr Roadgraph::GetLanePolygonForLaneId(const XodrLaneId& lane_id) {
   auto v = GetVertexByLaneId(lane_id);
-  return GetLaneGraph().operator[](v.first).polygon;
+  PolygonPtr polygon = GetLaneGraph().operator[](v.first).polygon;
+  if (!polygon && lane_polygon_source_) polygon = lane_polygon_source_(lane_id);
+  return polygon;
 }
 
 XodrRoadId Roadgraph::GetRoadForLaneId(const XodrLaneId& lane_id) {
@@ -382,13 +446,10 @@ std::pair<vertex_t, bool> Roadgraph::GetVertexByLaneId(
     const XodrLaneId& lane_id) const {
   std::pair<vertex_t, bool> retval;
   retval.second = false;
-  boost::graph_traits<XodrLaneGraph>::vertex_iterator i, end;
-  for (boost::tie(i, end) = boost::vertices(g_); i != end; ++i) {
-    if (g_[*i].global_lane_id == lane_id) {
-      retval.first = *i;
-      retval.second = true;
-      break;
-    }
+  auto it = vertex_by_lane_id_.find(lane_id);
+  if (it != vertex_by_lane_id_.end()) {
+    retval.first = it->second;
+    retval.second = true;
   }
   return retval;
 }
@@ -603,7 +664,7 @@ void Roadgraph::GeneratePolygonsForVertices() {
   }
 }
 
-void Roadgraph::Generate(OpenDriveMapPtr map) {
+void Roadgraph::GenerateTopology(OpenDriveMapPtr map) {
   GenerateVertices(map);
 
   GenerateNeighbours(map);
@@ -611,6 +672,10 @@ void Roadgraph::Generate(OpenDriveMapPtr map) {
   GeneratePreAndSuccessors(map);
 
   GenerateFromJunctions(map);
+}
+
+void Roadgraph::Generate(OpenDriveMapPtr map) {
+  GenerateTopology(map);
 
   GeneratePolygonsForVertices();
 }
@@ -685,6 +750,7 @@ bool Roadgraph::AddEdgeOfType(const XodrLaneId& source_id,
   std::pair<vertex_t, bool> tarGetLane = GetVertexByLaneId(tarGetId);
   if (source_lane.second && tarGetLane.second) {
     boost::add_edge(source_lane.first, tarGetLane.first, edge, g_);
+    ClearRoutingTables();
     return true;
   } else {
     return false;
@@ -9,13 +9,17 @@
 #ifndef BARK_WORLD_ROADGRAPH_HPP_
 #define BARK_WORLD_ROADGRAPH_HPP_
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/filtered_graph.hpp>
 #include <boost/graph/graphviz.hpp>
 #include <boost/graph/topological_sort.hpp>
+#include <cstdint>
+#include <functional>
 #include <ostream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "bark/geometry/polygon.hpp"
@@ -120,6 +124,33 @@ struct EdgeTypeRoadSuccessor {  // both edge and vertex
   XodrLaneGraph* g;
 };
 
+//! subgraph filter using a bitset over the vertex indices and a bitmask
+//! over the edge types
+struct BitsetSubgraphFilter {
+  bool operator()(XodrLaneGraph::edge_descriptor ed) const {
+    return (edge_type_mask >> (*g)[ed].edge_type) & 1u;
+  }
+
+  bool operator()(XodrLaneGraph::vertex_descriptor vd) const {
+    return vertex_mask->test(vd);
+  }
+  const XodrLaneGraph* g;
+  const boost::dynamic_bitset<>* vertex_mask;
+  unsigned int edge_type_mask;
+};
+
+//! shortest path predecessors of all precomputed source vertices
+struct RoutingTable {
+  std::size_t num_vertices = 0;
+  //! vertices that are part of the filtered graph
+  boost::dynamic_bitset<> vertex_mask;
+  //! row index in predecessors for every source vertex
+  std::unordered_map<vertex_t, std::size_t> rows;
+  //! row-major predecessor map, one row of num_vertices per source
+  std::vector<std::uint32_t> predecessors;
+  bool Empty() const { return rows.empty(); }
+};
+
 template <typename Predicate>
 using FilteredXodrLaneGraph_t =
     boost::filtered_graph<XodrLaneGraph, Predicate, Predicate>;
@@ -163,6 +194,18 @@ class Roadgraph {
       const std::vector<XodrLaneEdgeType>& edge_type_subset,
       const std::vector<XodrLaneId>& lane_id_subset);
 
+  //! Precomputes lane- and road-level routing tables for maps with at most
+  //! max_num_vertices lanes. Afterwards, FindDrivableLanePath and
+  //! FindRoadPath are answered by table lookups instead of Dijkstra runs.
+  bool PrecomputeRoutingTables(std::size_t max_num_vertices = 4000);
+  bool HasRoutingTables() const {
+    return !lane_routing_table_.Empty() || !road_routing_table_.Empty();
+  }
+  void ClearRoutingTables() {
+    lane_routing_table_ = RoutingTable();
+    road_routing_table_ = RoutingTable();
+  }
+
   XodrLanePtr GetLanePtr(const XodrLaneId& id) const;
 
   std::vector<XodrLaneId> GetAllLaneids() const;
@@ -179,6 +222,12 @@ class Roadgraph {
   // TODO: Move to XodrLaneGraph, but XodrLaneGraph is not wrapped to python
   PolygonPtr GetLanePolygonForLaneId(const XodrLaneId& lane_id);
 
+  //! serves the polygons of lanes whose vertex has none (tiled mode)
+  using LanePolygonSource = std::function<PolygonPtr(const XodrLaneId&)>;
+  void SetLanePolygonSource(const LanePolygonSource& source) {
+    lane_polygon_source_ = source;
+  }
+
   XodrRoadId GetRoadForLaneId(const XodrLaneId& lane_id);
 
   //! XodrLaneId of the neighboring lane and a flag if it exists or not
@@ -199,7 +248,7 @@ class Roadgraph {
 
   void PrintGraph(std::ofstream& dotfile);
 
-  XodrLaneGraph GetLaneGraph() const { return g_; }
+  const XodrLaneGraph& GetLaneGraph() const { return g_; }
 
   XodrLaneVertex GetVertex(vertex_t v_des) const { return g_[v_des]; }
 
@@ -227,6 +276,9 @@ class Roadgraph {
 
   void GeneratePolygonsForVertices();
 
+  //! vertices and edges without the lane polygons
+  void GenerateTopology(OpenDriveMapPtr map);
+
   void Generate(OpenDriveMapPtr map);
 
   std::pair<XodrLanePtr, XodrLanePtr> ComputeXodrLaneBoundaries(
@@ -254,6 +306,19 @@ class Roadgraph {
 
  private:
   XodrLaneGraph g_;
+  std::unordered_map<XodrLaneId, vertex_t> vertex_by_lane_id_;
+  std::unordered_map<XodrRoadId, XodrLaneId> plan_view_by_road_id_;
+  RoutingTable lane_routing_table_;
+  RoutingTable road_routing_table_;
+  LanePolygonSource lane_polygon_source_;
+
+  template <class Predicate>
+  RoutingTable ComputeRoutingTable(
+      const std::function<bool(vertex_t)>& is_source);
+
+  std::pair<std::vector<XodrLaneId>, bool> FindPathInRoutingTable(
+      const RoutingTable& table, const XodrLaneId& startid,
+      const XodrLaneId& goalid) const;
 
   bool AddEdgeOfType(const XodrLaneId& source_id, const XodrLaneId& tarGetId,
                      const XodrLaneEdgeType& edgetype);
@@ -88,6 +88,45 @@ std::vector<XodrLaneId> Roadgraph::FindPath(const XodrLaneId& startid,
   return path;
 }
 
+template <class Predicate>
+RoutingTable Roadgraph::ComputeRoutingTable(
+    const std::function<bool(vertex_t)>& is_source) {
+  Predicate predicate{&g_};
+  FilteredXodrLaneGraph_t<Predicate> fg(g_, predicate, predicate);
+
+  RoutingTable table;
+  table.num_vertices = boost::num_vertices(fg);
+  table.vertex_mask.resize(table.num_vertices);
+
+  std::vector<vertex_t> p(table.num_vertices);
+  std::vector<int> d(table.num_vertices);
+  boost::property_map<FilteredXodrLaneGraph, float XodrLaneEdge::*>::type
+      weightmap = boost::get(&XodrLaneEdge::weight, fg);
+
+  typename boost::graph_traits<
+      FilteredXodrLaneGraph_t<Predicate>>::vertex_iterator i,
+      end;
+  for (boost::tie(i, end) = boost::vertices(fg); i != end; ++i) {
+    table.vertex_mask.set(*i);
+  }
+  for (boost::tie(i, end) = boost::vertices(fg); i != end; ++i) {
+    if (!is_source(*i)) continue;
+    // same initialization and search as in FindPath
+    std::fill(p.begin(), p.end(), vertex_t(0));
+    boost::dijkstra_shortest_paths(
+        fg, *i,
+        predecessor_map(boost::make_iterator_property_map(
+                            p.begin(), get(boost::vertex_index, fg)))
+            .distance_map(boost::make_iterator_property_map(
+                d.begin(), get(boost::vertex_index, fg)))
+            .weight_map(weightmap));
+    const std::size_t row = table.rows.size();
+    table.rows[*i] = row;
+    table.predecessors.insert(table.predecessors.end(), p.begin(), p.end());
+  }
+  return table;
+}
+
 }  // namespace map
 }  // namespace world
 }  // namespace bark
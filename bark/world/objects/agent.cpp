@@ -9,6 +9,8 @@
 #include "bark/world/objects/agent.hpp"
 #include <cmath>
 #include <limits>
+#include "bark/commons/util/pool_allocator.hpp"
+#include "bark/world/objects/agent_kernel.hpp"
 #include "bark/world/objects/object.hpp"
 #include "bark/world/observed_world.hpp"
 
@@ -29,7 +31,9 @@ Agent::Agent(const State& initial_state,
       execution_model_(execution_model),
       history_(),
       max_history_length_(10),
-      goal_definition_(goal_definition) {
+      goal_definition_(goal_definition),
+      kernel_(),
+      kernel_bound_(false) {
   if (params) {
     max_history_length_ = params->GetInt(
         "MaxHistoryLength",
@@ -64,7 +68,9 @@ Agent::Agent(const Agent& other_agent)
       road_corridor_(other_agent.road_corridor_),
       history_(other_agent.history_),
       max_history_length_(other_agent.max_history_length_),
-      goal_definition_(other_agent.goal_definition_) {}
+      goal_definition_(other_agent.goal_definition_),
+      kernel_(),
+      kernel_bound_(false) {}
 
 void Agent::PlanBehavior(const float& min_planning_dt,
                          const ObservedWorld& observed_world) {
@@ -76,17 +82,93 @@ void Agent::PlanExecution(const float& world_time) {
                             dynamic_model_);
 }
 
+void Agent::Plan(const float& min_planning_dt, const float& world_time,
+                 const ObservedWorld& observed_world) {
+  const AgentKernelPtr& kernel = GetAgentKernel();
+  if (kernel) {
+    kernel->Plan(min_planning_dt, world_time, observed_world);
+    return;
+  }
+  PlanBehavior(min_planning_dt, observed_world);
+  if (GetBehaviorStatus() == BehaviorStatus::VALID) {
+    PlanExecution(world_time);
+  }
+}
+
+const AgentKernelPtr& Agent::GetAgentKernel() {
+  if (!kernel_bound_) {
+    kernel_ = AgentKernelRegistry::Bind(*this);
+    kernel_bound_ = true;
+  }
+  return kernel_;
+}
+
 void Agent::UpdateStateAction() {
   models::behavior::StateActionPair state_action_pair(
       execution_model_->GetExecutedState(), behavior_model_->GetLastAction());
   history_.push_back(state_action_pair);
+  AgentCheckpoint* checkpoint =
+      checkpoints_.empty() ? nullptr : &checkpoints_.back();
+  if (checkpoint) ++checkpoint->num_added_pairs;
 
   //! remove states if queue becomes too large
   if (history_.size() > max_history_length_) {
+    if (checkpoint) checkpoint->removed_pairs.push_back(history_.front());
     history_.erase(history_.begin());
   }
 }
 
+void Agent::SetStateInputHistory(const StateActionHistory& history) {
+  if (!checkpoints_.empty() && !checkpoints_.back().history_replaced) {
+    AgentCheckpoint& checkpoint = checkpoints_.back();
+    checkpoint.history = checkpoint.removed_pairs;
+    checkpoint.history.insert(checkpoint.history.end(), history_.begin(),
+                              history_.end());
+    checkpoint.history.resize(checkpoint.history.size() -
+                              checkpoint.num_added_pairs);
+    checkpoint.history_replaced = true;
+  }
+  history_ = history;
+}
+
+void Agent::Checkpoint() {
+  AgentCheckpoint checkpoint;
+  checkpoint.behavior_model = behavior_model_;
+  checkpoint.dynamic_model = dynamic_model_;
+  checkpoint.execution_model = execution_model_;
+  checkpoint.road_corridor = road_corridor_;
+  checkpoint.goal_definition = goal_definition_;
+  checkpoint.num_added_pairs = 0;
+  checkpoint.history_replaced = false;
+  checkpoints_.push_back(std::move(checkpoint));
+  if (behavior_model_) behavior_model_ = behavior_model_->Clone();
+  if (execution_model_) execution_model_ = execution_model_->Clone();
+  ResetAgentKernel();
+}
+
+bool Agent::Rollback() {
+  if (checkpoints_.empty()) {
+    return false;
+  }
+  AgentCheckpoint& checkpoint = checkpoints_.back();
+  behavior_model_ = std::move(checkpoint.behavior_model);
+  dynamic_model_ = std::move(checkpoint.dynamic_model);
+  execution_model_ = std::move(checkpoint.execution_model);
+  road_corridor_ = std::move(checkpoint.road_corridor);
+  goal_definition_ = std::move(checkpoint.goal_definition);
+  if (checkpoint.history_replaced) {
+    history_.swap(checkpoint.history);
+  } else {
+    // history at the checkpoint followed by all added pairs
+    history_.insert(history_.begin(), checkpoint.removed_pairs.begin(),
+                    checkpoint.removed_pairs.end());
+    history_.resize(history_.size() - checkpoint.num_added_pairs);
+  }
+  checkpoints_.pop_back();
+  ResetAgentKernel();
+  return true;
+}
+
 bool Agent::GenerateRoadCorridor(const MapInterfacePtr& map_interface) {
   if (!goal_definition_) {
     return false;
@@ -126,8 +208,10 @@ bool Agent::AtGoal() const {
 }
 
 std::shared_ptr<Object> Agent::Clone() const {
-  std::shared_ptr<Agent> new_agent = std::make_shared<Agent>(*this);
+  std::shared_ptr<Agent> new_agent = commons::MakePooled<Agent>(*this);
   new_agent->SetAgentId(this->GetAgentId());
+  // the checkpoints reference the models of this agent
+  new_agent->checkpoints_.clear();
   if (behavior_model_) {
     new_agent->behavior_model_ = behavior_model_->Clone();
   }
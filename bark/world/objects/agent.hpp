@@ -51,9 +51,13 @@ using bark::geometry::Point2d;
 using bark::geometry::Polygon;
 using bark::geometry::Pose;
 
+class AgentKernel;
+typedef std::shared_ptr<AgentKernel> AgentKernelPtr;
+
 class Agent : public Object {
  public:
   friend class World;
+  friend class AgentKernel;
 
   Agent(const State& initial_state, const BehaviorModelPtr& behavior_model_ptr,
         const DynamicModelPtr& dynamic_model_ptr,
@@ -83,11 +87,39 @@ class Agent : public Object {
    */
   void PlanExecution(const float& world_time);
 
+  /**
+   * @brief  Plans the behavior and, if it is valid, the execution with the
+   *         agent kernel bound to the models, see AgentKernelRegistry;
+   *         falls back to PlanBehavior and PlanExecution without a kernel
+   */
+  void Plan(const float& dt, const float& world_time,
+            const ObservedWorld& observed_world);
+
+  //! binds the kernel on the first call after the models changed;
+  //! nullptr if no registered kernel matches the models
+  const AgentKernelPtr& GetAgentKernel();
+
   /**
    * @brief  Updates the agent states based on the execution model
    */
   void UpdateStateAction();
 
+  /**
+   * @brief  Saves the models and the history of the agent; the agent
+   *         continues with clones of its behavior and execution model, so
+   *         the saved ones stay unchanged
+   */
+  void Checkpoint();
+
+  /**
+   * @brief  Restores the agent at its last checkpoint; checkpoints are
+   *         restored in the reverse order they were made in
+   * @return false if the agent has no checkpoint
+   */
+  bool Rollback();
+
+  std::size_t GetNumCheckpoints() const { return checkpoints_.size(); }
+
   /**
    * @brief  Checks whether the agent has reached its goal
    */
@@ -104,15 +136,17 @@ class Agent : public Object {
 
   GoalDefinitionPtr GetGoalDefinition() const { return goal_definition_; }
 
-  Trajectory GetExecutionTrajectory() const {
+  //! invalidated by the next execution planning of the agent
+  const Trajectory& GetExecutionTrajectory() const {
     return execution_model_->GetLastTrajectory();
   }
 
-  Trajectory GetBehaviorTrajectory() const {
+  //! invalidated by the next behavior planning of the agent
+  const Trajectory& GetBehaviorTrajectory() const {
     return behavior_model_->GetLastTrajectory();
   }
 
-  State GetCurrentState() const { return history_.back().first; }
+  const State& GetCurrentState() const { return history_.back().first; }
 
   Point2d GetCurrentPosition() const {
     const State& state = GetCurrentState();
@@ -137,23 +171,24 @@ class Agent : public Object {
   //! Setter
   void SetBehaviorModel(const BehaviorModelPtr& behavior_model_ptr) {
     behavior_model_ = behavior_model_ptr;
+    ResetAgentKernel();
   }
 
   void SetExecutionModel(const ExecutionModelPtr& execution_model_ptr) {
     execution_model_ = execution_model_ptr;
+    ResetAgentKernel();
   }
 
   void SetDynamicModel(const DynamicModelPtr& dynamic_model_ptr) {
     dynamic_model_ = dynamic_model_ptr;
+    ResetAgentKernel();
   }
 
   void SetGoalDefinition(const GoalDefinitionPtr& goal_definition) {
     goal_definition_ = goal_definition;
   }
 
-  void SetStateInputHistory(const StateActionHistory& history) {
-    history_ = history;
-  }
+  void SetStateInputHistory(const StateActionHistory& history);
 
   void SetRoadCorridor(const RoadCorridorPtr road_corridor) {
     road_corridor_ = road_corridor;
@@ -162,6 +197,25 @@ class Agent : public Object {
   virtual std::shared_ptr<Object> Clone() const;
 
  private:
+  //! the history is restored from the state-action pairs added and removed
+  //! since the checkpoint, unless it has been replaced as a whole
+  struct AgentCheckpoint {
+    BehaviorModelPtr behavior_model;
+    DynamicModelPtr dynamic_model;
+    ExecutionModelPtr execution_model;
+    RoadCorridorPtr road_corridor;
+    GoalDefinitionPtr goal_definition;
+    std::size_t num_added_pairs;
+    StateActionHistory removed_pairs;
+    bool history_replaced;
+    StateActionHistory history;
+  };
+
+  void ResetAgentKernel() {
+    kernel_.reset();
+    kernel_bound_ = false;
+  }
+
   BehaviorModelPtr behavior_model_;
   DynamicModelPtr dynamic_model_;
   ExecutionModelPtr execution_model_;
@@ -169,6 +223,9 @@ class Agent : public Object {
   StateActionHistory history_;
   uint32_t max_history_length_;
   GoalDefinitionPtr goal_definition_;
+  std::vector<AgentCheckpoint> checkpoints_;
+  AgentKernelPtr kernel_;
+  bool kernel_bound_;
 };
 
 typedef std::shared_ptr<Agent> AgentPtr;
@@ -0,0 +1,51 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/world/objects/agent_kernel.hpp"
+
+#include <mutex>
+#include <vector>
+
+namespace bark {
+namespace world {
+namespace objects {
+
+namespace {
+
+// agents of worlds stepped in parallel may bind at the same time
+std::mutex kernels_mutex;
+
+std::vector<AgentKernelPtr>& Kernels() {
+  static std::vector<AgentKernelPtr> kernels;
+  return kernels;
+}
+
+}  // namespace
+
+void AgentKernelRegistry::Register(const AgentKernelPtr& kernel) {
+  std::lock_guard<std::mutex> lock(kernels_mutex);
+  Kernels().push_back(kernel);
+}
+
+void AgentKernelRegistry::Clear() {
+  std::lock_guard<std::mutex> lock(kernels_mutex);
+  Kernels().clear();
+}
+
+AgentKernelPtr AgentKernelRegistry::Bind(const Agent& agent) {
+  std::lock_guard<std::mutex> lock(kernels_mutex);
+  for (const AgentKernelPtr& kernel : Kernels()) {
+    AgentKernelPtr bound_kernel = kernel->Bind(agent);
+    if (bound_kernel) return bound_kernel;
+  }
+  return AgentKernelPtr();
+}
+
+}  // namespace objects
+}  // namespace world
+}  // namespace bark
@@ -0,0 +1,134 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_WORLD_OBJECTS_AGENT_KERNEL_HPP_
+#define BARK_WORLD_OBJECTS_AGENT_KERNEL_HPP_
+
+#include <memory>
+#include <typeinfo>
+
+#include "bark/commons/util/pool_allocator.hpp"
+#include "bark/world/objects/agent.hpp"
+
+namespace bark {
+namespace world {
+namespace objects {
+
+using models::behavior::BehaviorModel;
+using models::dynamic::DynamicModel;
+using models::execution::ExecutionModel;
+
+//! Plans the behavior and the execution of an agent in one call for a fixed
+//! combination of model types. Registered kernels are prototypes that bind
+//! to the models of an agent; the bound kernel is kept by the agent until
+//! its models change. Agents without a kernel use the polymorphic models.
+class AgentKernel {
+ public:
+  virtual ~AgentKernel() {}
+
+  //! kernel bound to the models of agent, nullptr if they do not match
+  virtual AgentKernelPtr Bind(const Agent& agent) const = 0;
+
+  //! plans the behavior and, if it is valid, the execution at world_time;
+  //! only called on bound kernels
+  virtual void Plan(float delta_time, float world_time,
+                    const ObservedWorld& observed_world) = 0;
+
+ protected:
+  static BehaviorModel* GetBehaviorModel(const Agent& agent) {
+    return agent.behavior_model_.get();
+  }
+  static ExecutionModel* GetExecutionModel(const Agent& agent) {
+    return agent.execution_model_.get();
+  }
+  static const DynamicModelPtr& GetDynamicModel(const Agent& agent) {
+    return agent.dynamic_model_;
+  }
+};
+
+//! How a fused kernel plans a behavior of exact type Behavior. The default
+//! makes a qualified call to Plan; specializations may plan into the last
+//! trajectory without virtual calls, see idm_agent_kernels.hpp.
+template <typename Behavior>
+struct FusedBehaviorPlanner {
+  static void Plan(Behavior* behavior_model, float delta_time,
+                   const ObservedWorld& observed_world) {
+    behavior_model->Behavior::Plan(delta_time, observed_world);
+  }
+};
+
+//! Calls the models through their concrete types, so there is no virtual
+//! dispatch in between the behavior and the execution. Only the exact
+//! types match, as derived models may override the calls. The agent
+//! history update has no virtual calls and stays with the agent.
+template <typename Behavior, typename Execution, typename Dynamic>
+class FusedAgentKernel : public AgentKernel {
+ public:
+  FusedAgentKernel()
+      : behavior_model_(nullptr), execution_model_(nullptr), dynamic_model_() {}
+
+  FusedAgentKernel(Behavior* behavior_model, Execution* execution_model,
+                   const DynamicModelPtr& dynamic_model)
+      : behavior_model_(behavior_model),
+        execution_model_(execution_model),
+        dynamic_model_(dynamic_model) {}
+
+  //! models may derive virtually from their base, e.g. BaseIDM, so they are
+  //! downcast dynamically; this happens once per binding, not per step
+  AgentKernelPtr Bind(const Agent& agent) const {
+    BehaviorModel* behavior_model = GetBehaviorModel(agent);
+    ExecutionModel* execution_model = GetExecutionModel(agent);
+    const DynamicModelPtr& dynamic_model = GetDynamicModel(agent);
+    if (!behavior_model || !execution_model || !dynamic_model ||
+        typeid(*behavior_model) != typeid(Behavior) ||
+        typeid(*execution_model) != typeid(Execution) ||
+        typeid(*dynamic_model) != typeid(Dynamic)) {
+      return AgentKernelPtr();
+    }
+    return commons::MakePooled<FusedAgentKernel>(
+        dynamic_cast<Behavior*>(behavior_model),
+        dynamic_cast<Execution*>(execution_model), dynamic_model);
+  }
+
+  void Plan(float delta_time, float world_time,
+            const ObservedWorld& observed_world) {
+    FusedBehaviorPlanner<Behavior>::Plan(behavior_model_, delta_time,
+                                         observed_world);
+    if (behavior_model_->GetBehaviorStatus() !=
+        models::behavior::BehaviorStatus::VALID) {
+      return;
+    }
+    execution_model_->Execution::Execute(
+        world_time, behavior_model_->GetLastTrajectory(), dynamic_model_);
+  }
+
+ private:
+  // owned by the agent, which drops the kernel when they are replaced
+  Behavior* behavior_model_;
+  Execution* execution_model_;
+  DynamicModelPtr dynamic_model_;
+};
+
+//! Kernels that agents bind to on their first plan after their models
+//! changed; the first matching kernel is used. Agents keep kernels they
+//! have bound before a change of the registry.
+class AgentKernelRegistry {
+ public:
+  static void Register(const AgentKernelPtr& kernel);
+
+  static void Clear();
+
+  //! nullptr if no kernel matches
+  static AgentKernelPtr Bind(const Agent& agent);
+};
+
+}  // namespace objects
+}  // namespace world
+}  // namespace bark
+
+#endif  // BARK_WORLD_OBJECTS_AGENT_KERNEL_HPP_
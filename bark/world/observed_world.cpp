@@ -7,7 +7,9 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include <limits>
+#include <mutex>
 
+#include "bark/commons/util/thread_pool.hpp"
 #include "bark/models/behavior/motion_primitives/motion_primitives.hpp"
 #include "bark/world/observed_world.hpp"
 
@@ -20,6 +22,47 @@ using bark::models::behavior::BehaviorMotionPrimitivesPtr;
 using bark::models::dynamic::State;
 using bark::world::AgentMap;
 
+namespace {
+
+std::vector<std::function<void(ObservedWorld*)>> ActionSetups(
+    const std::vector<Action>& ego_actions) {
+  std::vector<std::function<void(ObservedWorld*)>> setups;
+  for (const Action& ego_action : ego_actions) {
+    setups.push_back([&ego_action](ObservedWorld* next_world) {
+      if (!next_world->GetEgoAgent()) {
+        LOG(WARNING)
+            << "Ego Agent not existent in observed world during prediction";
+        return;
+      }
+      next_world->GetEgoBehaviorModel()->ActionToBehavior(ego_action);
+    });
+  }
+  return setups;
+}
+
+// the behavior models are cloned, as the branches are predicted
+// concurrently
+std::vector<std::function<void(ObservedWorld*)>> HypothesisSetups(
+    const std::vector<BehaviorHypothesisMap>& hypotheses) {
+  std::vector<std::function<void(ObservedWorld*)>> setups;
+  for (const BehaviorHypothesisMap& hypothesis : hypotheses) {
+    setups.push_back([&hypothesis](ObservedWorld* next_world) {
+      for (const auto& agent_behavior : hypothesis) {
+        auto agent_ptr = next_world->GetAgent(agent_behavior.first);
+        if (!agent_ptr) {
+          LOG(WARNING) << "Agent Id" << agent_behavior.first
+                       << " not existent in observed world during prediction";
+          continue;
+        }
+        agent_ptr->SetBehaviorModel(agent_behavior.second->Clone());
+      }
+    });
+  }
+  return setups;
+}
+
+}  // namespace
+
 FrontRearAgents ObservedWorld::GetAgentFrontRear() const {
   const auto& lane_corridor = GetLaneCorridor();
   if (!lane_corridor) {
@@ -41,6 +84,19 @@ FrontRearAgents ObservedWorld::GetAgentFrontRear(
   return fr_agent;
 }
 
+LaneScan ObservedWorld::GetLaneScan(
+    const LaneCorridorPtr& lane_corridor) const {
+  BARK_EXPECT_TRUE(lane_corridor != nullptr);
+  AgentId id = GetEgoAgentId();
+  LaneOccupancyPtr lane_occupancy = GetLaneOccupancy(lane_corridor);
+  LaneScan lane_scan;
+  lane_scan.frenet = GetAgentFrenetPosition(id, lane_corridor, lane_occupancy);
+  lane_scan.front_rear = lane_occupancy->GetFrontRear(id, lane_scan.frenet);
+  lane_scan.remaining_distance =
+      lane_occupancy->GetLaneLength() - static_cast<float>(lane_scan.frenet.lon);
+  return lane_scan;
+}
+
 AgentFrenetPair ObservedWorld::GetAgentInFront(
     const LaneCorridorPtr& lane_corridor) const {
   FrontRearAgents fr_agent = GetAgentFrontRear(lane_corridor);
@@ -158,6 +214,66 @@ ObservedWorldPtr ObservedWorld::Predict(
   return next_world;
 }
 
+std::vector<ObservedWorldPtr> ObservedWorld::PredictBatch(
+    float time_span, const std::vector<Action>& ego_actions) const {
+  return PredictBranches(time_span, ActionSetups(ego_actions));
+}
+
+std::vector<ObservedWorldPtr> ObservedWorld::PredictBatch(
+    float time_span,
+    const std::vector<BehaviorHypothesisMap>& hypotheses) const {
+  return PredictBranches(time_span, HypothesisSetups(hypotheses));
+}
+
+std::vector<EvaluationMap> ObservedWorld::PredictBatchAndEvaluate(
+    float time_span, const std::vector<Action>& ego_actions) const {
+  return EvaluateBranches(time_span, ActionSetups(ego_actions));
+}
+
+std::vector<EvaluationMap> ObservedWorld::PredictBatchAndEvaluate(
+    float time_span,
+    const std::vector<BehaviorHypothesisMap>& hypotheses) const {
+  return EvaluateBranches(time_span, HypothesisSetups(hypotheses));
+}
+
+ObservedWorldPtr ObservedWorld::PredictBranch(float time_span,
+                                              const BranchSetup& setup) const {
+  std::shared_ptr<ObservedWorld> next_world =
+      std::make_shared<ObservedWorld>(World::CloneAgents(), ego_agent_id_);
+  if (GetAgentBatchPlanner()) {
+    next_world->SetAgentBatchPlanner(GetAgentBatchPlanner()->Clone());
+  }
+  setup(next_world.get());
+  next_world->Step(time_span);
+  return next_world;
+}
+
+// the branches only read this world and have their own batch planner, so
+// they are predicted concurrently; the map is shared and thread-safe
+std::vector<ObservedWorldPtr> ObservedWorld::PredictBranches(
+    float time_span, const std::vector<BranchSetup>& setups) const {
+  std::vector<ObservedWorldPtr> next_worlds(setups.size());
+  commons::ThreadPool::Default().ParallelFor(
+      setups.size(), [&](std::size_t i) {
+        next_worlds[i] = PredictBranch(time_span, setups[i]);
+      });
+  return next_worlds;
+}
+
+std::vector<EvaluationMap> ObservedWorld::EvaluateBranches(
+    float time_span, const std::vector<BranchSetup>& setups) const {
+  std::vector<EvaluationMap> evaluations(setups.size());
+  // the evaluators are shared by all branches and may count calls
+  std::mutex evaluation_mutex;
+  commons::ThreadPool::Default().ParallelFor(
+      setups.size(), [&](std::size_t i) {
+        ObservedWorldPtr next_world = PredictBranch(time_span, setups[i]);
+        std::lock_guard<std::mutex> lock(evaluation_mutex);
+        evaluations[i] = next_world->Evaluate();
+      });
+  return evaluations;
+}
+
 ObservedWorldPtr ObservedWorld::ObserveForOtherAgent(
     const AgentId& other_agent_id) const {
   std::shared_ptr<ObservedWorld> others_world =
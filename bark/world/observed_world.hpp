@@ -9,8 +9,10 @@
 #ifndef BARK_WORLD_OBSERVED_WORLD_HPP_
 #define BARK_WORLD_OBSERVED_WORLD_HPP_
 
+#include <functional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include "bark/geometry/geometry.hpp"
 #include "bark/models/dynamic/dynamic_model.hpp"
 #include "bark/world/prediction/prediction_settings.hpp"
@@ -35,6 +37,8 @@ using world::objects::Agent;
 using world::objects::AgentId;
 using world::objects::AgentPtr;
 
+typedef std::unordered_map<AgentId, BehaviorModelPtr> BehaviorHypothesisMap;
+
 class ObservedWorld : public World {
  public:
   ObservedWorld(const WorldPtr& world, const AgentId& ego_agent_id)
@@ -46,6 +50,10 @@ class ObservedWorld : public World {
 
   FrontRearAgents GetAgentFrontRear(const LaneCorridorPtr& lane_corridor) const;
 
+  //! front and rear agents, frenet position and remaining distance of the
+  //! ego agent on the lane corridor using the shared lane occupancy
+  LaneScan GetLaneScan(const LaneCorridorPtr& lane_corridor) const;
+
   AgentFrenetPair GetAgentInFront(const LaneCorridorPtr& lane_corridor) const;
 
   AgentFrenetPair GetAgentInFront() const;
@@ -66,6 +74,11 @@ class ObservedWorld : public World {
 
   AgentId GetEgoAgentId() const { return ego_agent_id_; }
 
+  //! allows to plan several agents in the same observed world
+  void SetEgoAgentId(const AgentId& ego_agent_id) {
+    ego_agent_id_ = ego_agent_id;
+  }
+
   AgentMap GetOtherAgents() const {
     auto tmp_map = World::GetAgents();
     tmp_map.erase(ego_agent_id_);
@@ -89,7 +102,7 @@ class ObservedWorld : public World {
 
   const MapInterfacePtr GetMap() const { return World::GetMap(); }
 
-  virtual State CurrentEgoState() const {
+  virtual const State& CurrentEgoState() const {
     return World::GetAgent(ego_agent_id_)->GetCurrentState();
   }
 
@@ -134,6 +147,27 @@ class ObservedWorld : public World {
     return next_obs_world;
   }
 
+  // Predicts one world per ego action in parallel; the predicted worlds
+  // share the map and the objects of this world
+  std::vector<ObservedWorldPtr> PredictBatch(
+      float time_span, const std::vector<Action>& ego_actions) const;
+
+  // Predicts one world per hypothesis in parallel; each predicted world uses
+  // clones of the behavior models of its hypothesis
+  std::vector<ObservedWorldPtr> PredictBatch(
+      float time_span,
+      const std::vector<BehaviorHypothesisMap>& hypotheses) const;
+
+  // Evaluation results of the worlds PredictBatch would return; each world
+  // is discarded by the thread that predicted it. The evaluators are shared
+  // by the predicted worlds and called one at a time
+  std::vector<EvaluationMap> PredictBatchAndEvaluate(
+      float time_span, const std::vector<Action>& ego_actions) const;
+
+  std::vector<EvaluationMap> PredictBatchAndEvaluate(
+      float time_span,
+      const std::vector<BehaviorHypothesisMap>& hypotheses) const;
+
   virtual WorldPtr Clone() const {
     WorldPtr world_clone(World::Clone());
     std::shared_ptr<ObservedWorld> observed_world =
@@ -146,6 +180,17 @@ class ObservedWorld : public World {
   ObservedWorldPtr ObserveForOtherAgent(const AgentId& other_agent_id) const;
 
  private:
+  typedef std::function<void(ObservedWorld*)> BranchSetup;
+
+  ObservedWorldPtr PredictBranch(float time_span,
+                                 const BranchSetup& setup) const;
+
+  std::vector<ObservedWorldPtr> PredictBranches(
+      float time_span, const std::vector<BranchSetup>& setups) const;
+
+  std::vector<EvaluationMap> EvaluateBranches(
+      float time_span, const std::vector<BranchSetup>& setups) const;
+
   AgentId ego_agent_id_;
 };
 
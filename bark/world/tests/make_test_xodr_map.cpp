@@ -219,4 +219,58 @@ OpenDriveMapPtr bark::world::tests::MakeXodrMapEndingLaneInParallel() {
   open_drive_map->AddRoad(r2);
 
   return open_drive_map;
-}
\ No newline at end of file
+}
+OpenDriveMapPtr bark::world::tests::MakeXodrMapCurvedRoadsMultipleLanes(
+    int num_roads, int num_lanes) {
+  using namespace bark::geometry;
+  using namespace bark::world::opendrive;
+
+  OpenDriveMapPtr open_drive_map = std::make_shared<OpenDriveMap>();
+
+  const float road_length = 50.0f;
+  Point2d start_point(0.0f, 0.0f);
+  float heading = 0.0f;
+  XodrRoadPtr previous_road;
+  for (int road_idx = 0; road_idx < num_roads; ++road_idx) {
+    // alternating left and right bends
+    const float curvature = (road_idx % 2 == 0 ? 1.0f : -1.0f) / 100.0f;
+    PlanViewPtr p(new PlanView());
+    p->AddArc(start_point, heading, road_length, curvature, 1.0f);
+
+    XodrLaneSectionPtr ls(new XodrLaneSection(0.0));
+    XodrLanePtr lane0(new XodrLane(0));
+    lane0->SetLine(p->GetReferenceLine());
+    ls->AddLane(lane0);
+
+    XodrLaneOffset off = {3.5f, 0.0f, 0.0f, 0.0f};
+    XodrLaneWidth lane_width = {0, road_length, off};
+    Line previous_line = p->GetReferenceLine();
+    for (int lane_idx = 1; lane_idx <= num_lanes; ++lane_idx) {
+      XodrLanePtr lane =
+          CreateLaneFromLaneWidth(-lane_idx, previous_line, lane_width, 0.5);
+      lane->SetLaneType(XodrLaneType::DRIVING);
+      lane->SetDrivingDirection(XodrDrivingDirection::FORWARD);
+      XodrLaneLink ll;
+      ll.from_position = -lane_idx;
+      ll.to_position = road_idx < num_roads - 1 ? -lane_idx : 0;
+      lane->SetLink(ll);
+      ls->AddLane(lane);
+      previous_line = lane->GetLine();
+    }
+
+    XodrRoadPtr r(new XodrRoad("curved_road", 100 + road_idx));
+    r->SetPlanView(p);
+    r->AddLaneSection(ls);
+    if (previous_road) {
+      XodrRoadLink rl = previous_road->GetLink();
+      rl.SetSuccessor(XodrRoadLinkInfo(r->GetId(), "road"));
+      previous_road->SetLink(rl);
+    }
+    open_drive_map->AddRoad(r);
+
+    start_point = p->GetReferenceLine().obj_.back();
+    heading += curvature * road_length;
+    previous_road = r;
+  }
+  return open_drive_map;
+}
@@ -23,6 +23,10 @@ OpenDriveMapPtr MakeXodrMapTwoRoadsOneLane();
 
 OpenDriveMapPtr MakeXodrMapEndingLaneInParallel();
 
+//! chain of alternately bending roads with num_lanes forward lanes each
+OpenDriveMapPtr MakeXodrMapCurvedRoadsMultipleLanes(int num_roads,
+                                                    int num_lanes);
+
 }  // namespace tests
 }  // namespace world
 }  // namespace bark
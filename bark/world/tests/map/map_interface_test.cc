@@ -50,4 +50,118 @@ TEST(point_in_lane, map_interface) {
   bool success = map_interface.FindNearestXodrLanes(point, 1, nearest_lanes);
 
   BARK_EXPECT_TRUE(success);
-}
\ No newline at end of file
+}
+
+TEST(route_cache, map_interface) {
+  using bark::geometry::Point2d;
+  using bark::geometry::Polygon;
+  using bark::geometry::Pose;
+  using bark::world::map::MapInterface;
+  using bark::world::map::RoadCorridorPtr;
+  using bark::world::opendrive::OpenDriveMapPtr;
+  using bark::world::tests::MakeXodrMapOneRoadTwoLanes;
+
+  OpenDriveMapPtr open_drive_map = MakeXodrMapOneRoadTwoLanes();
+
+  bark::world::map::MapInterface map_interface;
+  map_interface.interface_from_opendrive(open_drive_map);
+
+  Polygon goal_region(
+      Pose(0, 0, 0),
+      std::vector<Point2d>{Point2d(150, -3), Point2d(150, -1),
+                           Point2d(152, -1), Point2d(152, -3),
+                           Point2d(150, -3)});
+  RoadCorridorPtr rc0 =
+      map_interface.GenerateRoadCorridor(Point2d(10, -2), goal_region);
+  EXPECT_TRUE(rc0);
+  EXPECT_EQ(map_interface.GetRouteCacheMisses(), 1);
+  EXPECT_EQ(map_interface.GetRouteCacheHits(), 0);
+
+  // same start and goal lane: served from the cache
+  RoadCorridorPtr rc1 =
+      map_interface.GenerateRoadCorridor(Point2d(20, -2.5), goal_region);
+  EXPECT_EQ(rc0, rc1);
+  EXPECT_EQ(map_interface.GetRouteCacheMisses(), 1);
+  EXPECT_EQ(map_interface.GetRouteCacheHits(), 1);
+  EXPECT_EQ(map_interface.GetRouteCacheSize(), 1);
+
+  // routes of a previous roadgraph are not served anymore
+  map_interface.SetRoadgraph(map_interface.GetRoadgraph());
+  EXPECT_EQ(map_interface.GetRouteCacheSize(), 0);
+  map_interface.GenerateRoadCorridor(Point2d(10, -2), goal_region);
+  EXPECT_EQ(map_interface.GetRouteCacheSize(), 1);
+
+  map_interface.SetRouteCacheCapacity(0);
+  EXPECT_EQ(map_interface.GetRouteCacheSize(), 0);
+}
+
+TEST(tiled_map, map_interface) {
+  using bark::geometry::Point2d;
+  using bark::world::map::MapInterface;
+  using bark::world::map::RoadCorridorPtr;
+  using bark::world::opendrive::OpenDriveMapPtr;
+  using bark::world::opendrive::XodrDrivingDirection;
+  using bark::world::opendrive::XodrRoadId;
+  using bark::world::tests::MakeXodrMapCurvedRoadsMultipleLanes;
+
+  OpenDriveMapPtr open_drive_map = MakeXodrMapCurvedRoadsMultipleLanes(10, 3);
+
+  MapInterface map_interface;
+  map_interface.interface_from_opendrive(open_drive_map);
+  MapInterface tiled_map_interface;
+  tiled_map_interface.EnableTiling(50.0, 2);
+  tiled_map_interface.interface_from_opendrive(open_drive_map);
+  ASSERT_TRUE(tiled_map_interface.IsTiled());
+  EXPECT_GT(tiled_map_interface.GetMapTiles()->GetNumTiles(), 2);
+  EXPECT_EQ(tiled_map_interface.GetMapTiles()->GetNumLoadedTiles(), 0);
+
+  // lane queries give the same results while only two tiles are loaded
+  auto bbox = map_interface.BoundingBox();
+  const double min_x = boost::geometry::get<0>(bbox.first);
+  const double min_y = boost::geometry::get<1>(bbox.first);
+  const double max_x = boost::geometry::get<0>(bbox.second);
+  const double max_y = boost::geometry::get<1>(bbox.second);
+  for (double x = min_x; x < max_x; x += 7.0) {
+    for (double y = min_y; y < max_y; y += 1.5) {
+      Point2d pt(x, y);
+      EXPECT_EQ(map_interface.FindXodrLane(pt),
+                tiled_map_interface.FindXodrLane(pt));
+      EXPECT_LE(tiled_map_interface.GetMapTiles()->GetNumLoadedTiles(), 2);
+    }
+  }
+  EXPECT_GT(tiled_map_interface.GetMapTiles()->GetNumTileLoads(),
+            tiled_map_interface.GetMapTiles()->GetNumTiles());
+
+  // road corridors load the tiles they touch
+  std::vector<XodrRoadId> road_ids{100, 101, 102, 103, 104,
+                                   105, 106, 107, 108, 109};
+  XodrDrivingDirection driving_dir = XodrDrivingDirection::FORWARD;
+  map_interface.GenerateRoadCorridor(road_ids, driving_dir);
+  tiled_map_interface.GenerateRoadCorridor(road_ids, driving_dir);
+  RoadCorridorPtr rc = map_interface.GetRoadCorridor(road_ids, driving_dir);
+  RoadCorridorPtr tiled_rc =
+      tiled_map_interface.GetRoadCorridor(road_ids, driving_dir);
+  ASSERT_TRUE(rc && tiled_rc);
+  EXPECT_NEAR(rc->GetPolygon().CalculateArea(),
+              tiled_rc->GetPolygon().CalculateArea(), 1e-3);
+  for (auto const& road : tiled_rc->GetRoads()) {
+    for (auto const& lane : road.second->GetLanes()) {
+      if (lane.second->GetLanePosition() == 0) continue;
+      EXPECT_TRUE(bark::geometry::Equals(
+          lane.second->GetPolygon(),
+          rc->GetRoad(road.first)->GetLane(lane.first)->GetPolygon()));
+      // the roadgraph serves the polygons from the tiles
+      auto polygon = tiled_map_interface.GetRoadgraph()->GetLanePolygonForLaneId(
+          lane.first);
+      ASSERT_TRUE(polygon);
+      EXPECT_TRUE(bark::geometry::Equals(*polygon, lane.second->GetPolygon()));
+    }
+  }
+
+  // the generated road corridors are bounded in tiled mode
+  tiled_map_interface.EnableTiling(50.0, 2, 1);
+  tiled_map_interface.GenerateRoadCorridor(
+      std::vector<XodrRoadId>{100, 101}, driving_dir);
+  EXPECT_EQ(tiled_map_interface.GetNumRoadCorridors(), 1);
+  EXPECT_FALSE(tiled_map_interface.GetRoadCorridor(road_ids, driving_dir));
+}
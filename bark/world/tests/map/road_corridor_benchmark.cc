@@ -0,0 +1,145 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <chrono>
+#include <iostream>
+#include "bark/world/map/map_interface.hpp"
+#include "bark/world/map/road_corridor.hpp"
+#include "bark/world/tests/make_test_xodr_map.hpp"
+#include "gtest/gtest.h"
+
+namespace bg = boost::geometry;
+
+TEST(road_corridor_benchmark, compute_road_polygon) {
+  using bark::geometry::Polygon;
+  using bark::world::map::MapInterface;
+  using bark::world::map::MapInterfacePtr;
+  using bark::world::map::RoadCorridorPtr;
+  using bark::world::opendrive::XodrDrivingDirection;
+  using bark::world::opendrive::XodrRoadId;
+  using bark::world::tests::MakeXodrMapCurvedRoadsMultipleLanes;
+
+  const int num_roads = 10;
+  const int num_lanes = 4;
+  const int num_runs = 10;
+
+  MapInterfacePtr map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(
+      MakeXodrMapCurvedRoadsMultipleLanes(num_roads, num_lanes));
+  std::vector<XodrRoadId> road_ids;
+  for (int i = 0; i < num_roads; ++i) road_ids.push_back(100 + i);
+  XodrDrivingDirection driving_dir = XodrDrivingDirection::FORWARD;
+  map_interface->GenerateRoadCorridor(road_ids, driving_dir);
+  RoadCorridorPtr road_corridor =
+      map_interface->GetRoadCorridor(road_ids, driving_dir);
+  ASSERT_TRUE(road_corridor);
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_runs; ++i) road_corridor->ComputeRoadPolygon();
+  auto t1 = std::chrono::steady_clock::now();
+  Polygon road_polygon = road_corridor->GetPolygon();
+  for (int i = 0; i < num_runs; ++i) {
+    road_corridor->ComputeRoadPolygonBuffered();
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  Polygon buffered_road_polygon = road_corridor->GetPolygon();
+
+  const double cascaded_ms =
+      std::chrono::duration<double, std::milli>(t1 - t0).count() / num_runs;
+  const double buffered_ms =
+      std::chrono::duration<double, std::milli>(t2 - t1).count() / num_runs;
+  std::cout << "ComputeRoadPolygon: " << cascaded_ms << " ms, "
+            << "ComputeRoadPolygonBuffered: " << buffered_ms << " ms, "
+            << "speedup: " << buffered_ms / cascaded_ms << std::endl;
+
+  // the legacy polygon has notches where the lane polygons of consecutive
+  // roads meet; apart from those it is covered by the new polygon
+  std::vector<bg::model::polygon<bark::geometry::Point2d>> difference;
+  bg::difference(buffered_road_polygon.obj_, road_polygon.obj_, difference);
+  double difference_area = 0.0;
+  for (const auto& poly : difference) difference_area += bg::area(poly);
+  // alternating bends cancel out, so the exact area is known
+  const double expected_area = num_roads * num_lanes * 3.5 * 50.0;
+  std::cout << "area: " << road_polygon.CalculateArea()
+            << ", legacy area: " << buffered_road_polygon.CalculateArea()
+            << ", expected area: " << expected_area
+            << ", legacy area not covered: " << difference_area << std::endl;
+  EXPECT_LT(difference_area / expected_area, 0.01);
+  EXPECT_NEAR(road_polygon.CalculateArea(), expected_area,
+              0.005 * expected_area);
+}
+
+TEST(road_corridor_benchmark, drivable_area_check) {
+  using bark::geometry::Polygon;
+  using bark::geometry::Pose;
+  using bark::geometry::standard_shapes::CarLimousine;
+  using bark::world::map::MapInterface;
+  using bark::world::map::MapInterfacePtr;
+  using bark::world::map::RoadCorridorPtr;
+  using bark::world::opendrive::XodrDrivingDirection;
+  using bark::world::opendrive::XodrRoadId;
+  using bark::world::tests::MakeXodrMapCurvedRoadsMultipleLanes;
+
+  const int num_roads = 10;
+  const int num_lanes = 4;
+
+  MapInterfacePtr map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(
+      MakeXodrMapCurvedRoadsMultipleLanes(num_roads, num_lanes));
+  std::vector<XodrRoadId> road_ids;
+  for (int i = 0; i < num_roads; ++i) road_ids.push_back(100 + i);
+  XodrDrivingDirection driving_dir = XodrDrivingDirection::FORWARD;
+  map_interface->GenerateRoadCorridor(road_ids, driving_dir);
+  RoadCorridorPtr road_corridor =
+      map_interface->GetRoadCorridor(road_ids, driving_dir);
+  ASSERT_TRUE(road_corridor);
+
+  auto t0 = std::chrono::steady_clock::now();
+  ASSERT_TRUE(road_corridor->ComputeSignedDistanceGrid(0.25));
+  auto t1 = std::chrono::steady_clock::now();
+
+  // agent footprints along the lane center lines
+  std::vector<Polygon> footprints;
+  Polygon car = CarLimousine();
+  for (const auto& lane_corr : road_corridor->GetUniqueLaneCorridors()) {
+    const auto& center_line = lane_corr->GetCenterLine();
+    for (float s = 0.0; s < center_line.Length(); s += 1.0) {
+      auto pt = GetPointAtS(center_line, s);
+      float theta = GetTangentAngleAtS(center_line, s);
+      footprints.push_back(*std::dynamic_pointer_cast<Polygon>(car.Transform(
+          Pose(bg::get<0>(pt), bg::get<1>(pt), theta))));
+    }
+  }
+
+  const Polygon& road_polygon = road_corridor->GetPolygon();
+  std::vector<bool> exact, grid;
+  auto t2 = std::chrono::steady_clock::now();
+  for (const auto& footprint : footprints) {
+    exact.push_back(bg::within(footprint.obj_, road_polygon.obj_));
+  }
+  auto t3 = std::chrono::steady_clock::now();
+  for (const auto& footprint : footprints) {
+    grid.push_back(road_corridor->IsWithinPolygon(footprint));
+  }
+  auto t4 = std::chrono::steady_clock::now();
+
+  const double grid_ms =
+      std::chrono::duration<double, std::milli>(t1 - t0).count();
+  const double exact_us =
+      std::chrono::duration<double, std::micro>(t3 - t2).count() /
+      footprints.size();
+  const double with_grid_us =
+      std::chrono::duration<double, std::micro>(t4 - t3).count() /
+      footprints.size();
+  std::cout << "grid: " << grid_ms << " ms, "
+            << road_polygon.obj_.outer().size() << " vertices, "
+            << footprints.size() << " footprints, exact within: " << exact_us
+            << " us, with grid: " << with_grid_us
+            << " us, speedup: " << exact_us / with_grid_us << std::endl;
+  EXPECT_EQ(exact, grid);
+}
@@ -85,3 +85,80 @@ TEST(road_corridor_tests, xodr_map_ending_lane_in_parallel) {
 
   EXPECT_EQ(road_corridor->GetRoads().size(), 1);
 }
+
+TEST(road_corridor_tests, road_polygon_curved_roads) {
+  using bark::geometry::Polygon;
+  using bark::world::map::MapInterface;
+  using bark::world::map::MapInterfacePtr;
+  using bark::world::map::RoadCorridorPtr;
+  using bark::world::opendrive::OpenDriveMapPtr;
+  using bark::world::opendrive::XodrDrivingDirection;
+  using bark::world::opendrive::XodrRoadId;
+
+  using bark::world::tests::MakeXodrMapCurvedRoadsMultipleLanes;
+
+  OpenDriveMapPtr open_drive_map = MakeXodrMapCurvedRoadsMultipleLanes(4, 3);
+
+  MapInterfacePtr map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(open_drive_map);
+
+  std::vector<XodrRoadId> road_ids{100, 101, 102, 103};
+  XodrDrivingDirection driving_dir = XodrDrivingDirection::FORWARD;
+  map_interface->GenerateRoadCorridor(road_ids, driving_dir);
+  RoadCorridorPtr road_corridor =
+      map_interface->GetRoadCorridor(road_ids, driving_dir);
+  ASSERT_TRUE(road_corridor);
+  EXPECT_EQ(road_corridor->GetRoads().size(), 4);
+  EXPECT_EQ(road_corridor->GetUniqueLaneCorridors().size(), 3);
+
+  // four alternating 50m bends with three 3.5m wide lanes
+  Polygon road_polygon = road_corridor->GetPolygon();
+  EXPECT_TRUE(road_polygon.Valid());
+  EXPECT_NEAR(road_polygon.CalculateArea(), 4 * 3 * 3.5 * 50, 10.0);
+}
+
+TEST(road_corridor_tests, signed_distance_grid_within) {
+  using bark::geometry::Polygon;
+  using bark::geometry::Pose;
+  using bark::geometry::standard_shapes::CarRectangle;
+  using bark::world::map::MapInterface;
+  using bark::world::map::MapInterfacePtr;
+  using bark::world::map::RoadCorridorPtr;
+  using bark::world::opendrive::XodrDrivingDirection;
+  using bark::world::opendrive::XodrRoadId;
+  using bark::world::tests::MakeXodrMapCurvedRoadsMultipleLanes;
+
+  MapInterfacePtr map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(
+      MakeXodrMapCurvedRoadsMultipleLanes(4, 3));
+  map_interface->SetRoadSignedDistanceGridResolution(0.25);
+
+  std::vector<XodrRoadId> road_ids{100, 101, 102, 103};
+  XodrDrivingDirection driving_dir = XodrDrivingDirection::FORWARD;
+  map_interface->GenerateRoadCorridor(road_ids, driving_dir);
+  RoadCorridorPtr road_corridor =
+      map_interface->GetRoadCorridor(road_ids, driving_dir);
+  ASSERT_TRUE(road_corridor);
+  ASSERT_TRUE(road_corridor->GetSignedDistanceGrid());
+
+  // the grid only speeds up the check, the results are exact
+  const Polygon& road_polygon = road_corridor->GetPolygon();
+  auto bbox = road_polygon.BoundingBox();
+  Polygon car = CarRectangle();
+  const double min_x = boost::geometry::get<0>(bbox.first);
+  const double min_y = boost::geometry::get<1>(bbox.first);
+  const double max_x = boost::geometry::get<0>(bbox.second);
+  const double max_y = boost::geometry::get<1>(bbox.second);
+  for (double x = min_x; x < max_x; x += 2.3) {
+    for (double y = min_y; y < max_y; y += 0.7) {
+      auto shape = std::dynamic_pointer_cast<Polygon>(
+          car.Transform(Pose(x, y, 0.1)));
+      EXPECT_EQ(road_corridor->IsWithinPolygon(*shape),
+                Within(*shape, road_polygon));
+    }
+  }
+
+  // recomputing the polygon invalidates the grid
+  road_corridor->ComputeRoadPolygon();
+  EXPECT_FALSE(road_corridor->GetSignedDistanceGrid());
+}
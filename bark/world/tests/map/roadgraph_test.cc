@@ -807,4 +807,55 @@ TEST(roadgraph, MakeXodrMapTwoRoadsOneLane_test) {
 
   auto all_ids = rg.GetAllLaneids();
   ASSERT_TRUE(all_ids.size() == 2);
-}
\ No newline at end of file
+}
+TEST(roadgraph, routing_tables_test) {
+  using namespace bark::world::opendrive;
+  using namespace bark::world::map;
+
+  std::vector<OpenDriveMapPtr> maps = {
+      bark::world::tests::MakeXodrMapOneRoadTwoLanes(),
+      bark::world::tests::MakeXodrMapTwoRoadsOneLane(),
+      bark::world::tests::MakeXodrMapEndingLaneInParallel(),
+      bark::world::tests::MakeXodrMapCurvedRoadsMultipleLanes(5, 3)};
+
+  for (auto const& open_drive_map : maps) {
+    Roadgraph rg_dijkstra;
+    rg_dijkstra.Generate(open_drive_map);
+    Roadgraph rg_tables;
+    rg_tables.Generate(open_drive_map);
+    ASSERT_FALSE(rg_tables.HasRoutingTables());
+    ASSERT_TRUE(rg_tables.PrecomputeRoutingTables());
+    ASSERT_TRUE(rg_tables.HasRoutingTables());
+
+    std::vector<vertex_t> vertices = rg_tables.GetVertices();
+    for (auto const& start : vertices) {
+      for (auto const& goal : vertices) {
+        XodrLaneId start_id = rg_tables.GetVertex(start).global_lane_id;
+        XodrLaneId goal_id = rg_tables.GetVertex(goal).global_lane_id;
+        EXPECT_EQ(rg_tables.FindDrivableLanePath(start_id, goal_id),
+                  rg_dijkstra.FindDrivableLanePath(start_id, goal_id));
+
+        XodrRoadId start_road = rg_tables.GetVertex(start).road_id;
+        XodrRoadId goal_road = rg_tables.GetVertex(goal).road_id;
+        EXPECT_EQ(rg_tables.FindRoadPath(start_road, goal_road),
+                  rg_dijkstra.FindRoadPath(start_road, goal_road));
+      }
+    }
+  }
+
+  // the curved road map has a route across all roads
+  Roadgraph rg;
+  rg.Generate(maps.back());
+  rg.PrecomputeRoutingTables();
+  std::vector<XodrRoadId> road_path = rg.FindRoadPath(100, 104);
+  EXPECT_EQ(road_path, std::vector<XodrRoadId>({100, 101, 102, 103, 104}));
+
+  // modifying the graph invalidates the tables
+  XodrLanePtr lane(new XodrLane());
+  rg.AddLane(200, lane);
+  EXPECT_FALSE(rg.HasRoutingTables());
+
+  // maps that are too large are not precomputed
+  EXPECT_FALSE(rg.PrecomputeRoutingTables(1));
+  EXPECT_FALSE(rg.HasRoutingTables());
+}
@@ -124,3 +124,28 @@ TEST(agent, PolygonFromState) {
   EXPECT_FALSE(
       Equals(shape, poly_out2));  // we expect false as init_state2 is non-zero
 }
+
+TEST(agent, clone_has_no_checkpoints) {
+  auto params = std::make_shared<SetterParams>();
+  ExecutionModelPtr exec_model(new ExecutionModelInterpolate(params));
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  BehaviorModelPtr beh_model(new BehaviorConstantAcceleration(params));
+  Polygon shape(
+      Pose(1.25, 1, 0),
+      std::vector<Point2d>{Point2d(0, 0), Point2d(0, 2), Point2d(4, 2),
+                           Point2d(4, 0), Point2d(0, 0)});
+  State init_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  init_state << 0.0, 0.0, 0.0, 0.0, 5.0;
+  AgentPtr agent(
+      new Agent(init_state, beh_model, dyn_model, exec_model, shape, params));
+
+  agent->Checkpoint();
+  AgentPtr cloned_agent = std::dynamic_pointer_cast<Agent>(agent->Clone());
+  EXPECT_EQ(agent->GetNumCheckpoints(), 1u);
+  EXPECT_EQ(cloned_agent->GetNumCheckpoints(), 0u);
+  EXPECT_FALSE(cloned_agent->Rollback());
+
+  EXPECT_TRUE(agent->Rollback());
+  EXPECT_EQ(agent->GetBehaviorModel(), beh_model);
+  EXPECT_NE(cloned_agent->GetBehaviorModel(), beh_model);
+}
@@ -39,6 +39,7 @@ using bark::geometry::Polygon;
 using bark::geometry::Pose;
 using bark::geometry::standard_shapes::CarRectangle;
 using bark::geometry::standard_shapes::GenerateGoalRectangle;
+using bark::world::AgentMap;
 using bark::world::FrontRearAgents;
 using bark::world::ObservedWorld;
 using bark::world::ObservedWorldPtr;
@@ -46,6 +47,7 @@ using bark::world::World;
 using bark::world::WorldPtr;
 using bark::world::goal_definition::GoalDefinitionPolygon;
 using bark::world::objects::Agent;
+using bark::world::objects::AgentId;
 using bark::world::objects::AgentPtr;
 using bark::world::opendrive::OpenDriveMapPtr;
 using bark::world::tests::MakeXodrMapOneRoadTwoLanes;
@@ -208,6 +210,105 @@ TEST(observed_world, agent_in_front_other_lane) {
   EXPECT_EQ(fr_vehicle4b.rear.first->GetAgentId(), agent1->GetAgentId());
 }
 
+TEST(observed_world, lane_occupancy_index) {
+  using bark::world::LaneOccupancyPtr;
+  using bark::world::LaneScan;
+  auto params = std::make_shared<SetterParams>();
+
+  OpenDriveMapPtr open_drive_map = MakeXodrMapOneRoadTwoLanes();
+  MapInterfacePtr map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(open_drive_map);
+
+  Polygon polygon = GenerateGoalRectangle(6, 3);
+  std::shared_ptr<Polygon> goal_polygon(
+      std::dynamic_pointer_cast<Polygon>(polygon.Translate(Point2d(50, -2))));
+  auto goal_ptr = std::make_shared<GoalDefinitionPolygon>(*goal_polygon);
+
+  ExecutionModelPtr exec_model(new ExecutionModelInterpolate(params));
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  BehaviorModelPtr beh_model(new BehaviorConstantAcceleration(params));
+  Polygon car_polygon = CarRectangle();
+
+  // agents in both lanes, two of them side by side
+  WorldPtr world(new World(params));
+  std::vector<AgentPtr> agents;
+  std::vector<std::pair<double, double>> positions{
+      {3.0, -1.75}, {10.0, -1.75}, {17.0, -1.75}, {25.0, -1.75},
+      {5.0, -5.25}, {17.0, -5.25}, {32.0, -1.75}};
+  for (const auto& position : positions) {
+    State init_state(static_cast<int>(MIN_STATE_SIZE));
+    init_state << 0.0, position.first, position.second, 0.0, 5.0;
+    AgentPtr agent(new Agent(init_state, beh_model, dyn_model, exec_model,
+                             car_polygon, params, goal_ptr, map_interface,
+                             Model3D()));  // NOLINT
+    world->AddAgent(agent);
+    agents.push_back(agent);
+  }
+  world->UpdateAgentRTree();
+
+  WorldPtr world_without_index(world->Clone());
+  WorldPtr world_with_index(world->Clone());
+  world_with_index->EnableLaneOccupancyIndex();
+
+  for (const auto& agent : world->GetAgents()) {
+    ObservedWorld obs_without_index(world_without_index, agent.first);
+    ObservedWorld obs_with_index(world_with_index, agent.first);
+    const auto& road_corridor = agent.second->GetRoadCorridor();
+    const auto& lane_corridors = road_corridor->GetLeftRightLaneCorridor(
+        agent.second->GetCurrentPosition());
+    for (const auto& lane_corridor :
+         {obs_with_index.GetLaneCorridor(), lane_corridors.first,
+          lane_corridors.second}) {
+      if (!lane_corridor) continue;
+      FrontRearAgents expected =
+          obs_without_index.GetAgentFrontRearForId(agent.first, lane_corridor);
+      FrontRearAgents result =
+          obs_with_index.GetAgentFrontRearForId(agent.first, lane_corridor);
+      EXPECT_EQ(static_cast<bool>(expected.front.first),
+                static_cast<bool>(result.front.first));
+      EXPECT_EQ(static_cast<bool>(expected.rear.first),
+                static_cast<bool>(result.rear.first));
+      if (expected.front.first && result.front.first) {
+        EXPECT_EQ(expected.front.first->GetAgentId(),
+                  result.front.first->GetAgentId());
+      }
+      if (expected.rear.first && result.rear.first) {
+        EXPECT_EQ(expected.rear.first->GetAgentId(),
+                  result.rear.first->GetAgentId());
+      }
+      EXPECT_NEAR(expected.front.second.lon, result.front.second.lon, 1e-5);
+      EXPECT_NEAR(expected.rear.second.lon, result.rear.second.lon, 1e-5);
+
+      // the lane scan of the lane change behaviors
+      LaneScan lane_scan = obs_with_index.GetLaneScan(lane_corridor);
+      EXPECT_EQ(lane_scan.front_rear.front.first, result.front.first);
+      EXPECT_EQ(lane_scan.front_rear.rear.first, result.rear.first);
+      EXPECT_EQ(lane_scan.remaining_distance,
+                lane_corridor->LengthUntilEnd(
+                    agent.second->GetCurrentPosition()));
+    }
+  }
+  // one occupancy per queried lane corridor
+  EXPECT_EQ(world_with_index->GetLaneOccupancyIndex()->GetSize(), 2u);
+
+  // k-nearest agents in the lane of the first agent
+  const AgentPtr& ego = agents.front();
+  ObservedWorld obs_world(world_with_index, ego->GetAgentId());
+  LaneOccupancyPtr occupancy =
+      obs_world.GetLaneOccupancy(obs_world.GetLaneCorridor());
+  EXPECT_EQ(occupancy->GetOccupants().size(), 5u);
+  FrenetPosition frenet_ego(ego->GetCurrentPosition(),
+                            obs_world.GetLaneCorridor()->GetCenterLine());
+  auto nearest = occupancy->GetNearest(frenet_ego.lon, 2, ego->GetAgentId());
+  ASSERT_EQ(nearest.size(), 2u);
+  EXPECT_NEAR(nearest[0].s - frenet_ego.lon, 7.0, 0.1);
+  EXPECT_NEAR(nearest[1].s - frenet_ego.lon, 14.0, 0.1);
+
+  // any change of the agents invalidates the index
+  world_with_index->UpdateAgentRTree();
+  EXPECT_FALSE(world_with_index->GetLaneOccupancyIndex());
+}
+
 TEST(observed_world, clone) {
   using bark::world::evaluation::EvaluatorCollisionAgents;
   using bark::world::evaluation::EvaluatorPtr;
@@ -344,3 +445,230 @@ TEST(observed_world, predict) {
   // + prediction time span
   EXPECT_NEAR(ego_pred_velocity, ego_velocity + 2 * 1.0f, 0.05);
 }
+
+void ExpectSameAgents(const World& world, const World& other_world) {
+  ASSERT_EQ(world.GetAgents().size(), other_world.GetAgents().size());
+  EXPECT_NEAR(world.GetWorldTime(), other_world.GetWorldTime(), 1e-6);
+  for (const auto& agent : world.GetAgents()) {
+    const AgentPtr other_agent = other_world.GetAgent(agent.first);
+    ASSERT_TRUE(other_agent);
+    const auto history = agent.second->GetStateInputHistory();
+    const auto other_history = other_agent->GetStateInputHistory();
+    ASSERT_EQ(history.size(), other_history.size());
+    for (std::size_t i = 0; i < history.size(); ++i) {
+      EXPECT_TRUE(history[i].first.isApprox(other_history[i].first));
+    }
+  }
+}
+
+TEST(observed_world, checkpoint_rollback) {
+  using bark::models::behavior::BehaviorMotionPrimitives;
+  using bark::models::behavior::BehaviorMPContinuousActions;
+  using bark::models::behavior::DiscreteAction;
+  using bark::models::dynamic::Input;
+  using bark::world::prediction::PredictionSettings;
+  using bark::world::tests::make_test_observed_world;
+
+  auto params = std::make_shared<SetterParams>();
+  params->SetReal("integration_time_delta", 0.01);
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  auto observed_world = make_test_observed_world(2, 7.0, 5.0, 1.0);
+  for (const auto& agent : observed_world.GetAgents()) {
+    agent.second->SetDynamicModel(dyn_model);
+  }
+  auto ego_prediction_model =
+      std::make_shared<BehaviorMPContinuousActions>(params);
+  Input u1(2);
+  u1 << 2, 0;
+  Input u2(2);
+  u2 << 0, 1;
+  auto idx1 = ego_prediction_model->AddMotionPrimitive(u1);
+  auto idx2 = ego_prediction_model->AddMotionPrimitive(u2);
+  BehaviorModelPtr others_prediction_model(
+      new BehaviorConstantAcceleration(params));
+  observed_world.SetupPrediction(
+      PredictionSettings(ego_prediction_model, others_prediction_model));
+  const WorldPtr initial_world = observed_world.Clone();
+  const BehaviorModelPtr ego_behavior_model =
+      observed_world.GetEgoBehaviorModel();
+
+  EXPECT_FALSE(observed_world.Rollback());
+  for (auto idx : {idx1, idx2}) {
+    const ObservedWorldPtr predicted_world =
+        observed_world.Predict(1.0f, DiscreteAction(idx));
+
+    observed_world.Checkpoint();
+    EXPECT_EQ(observed_world.GetNumCheckpoints(), 1u);
+    // the ego agent continues with a clone of its behavior model
+    EXPECT_NE(observed_world.GetEgoBehaviorModel(), ego_behavior_model);
+    std::dynamic_pointer_cast<BehaviorMotionPrimitives>(
+        observed_world.GetEgoBehaviorModel())
+        ->ActionToBehavior(DiscreteAction(idx));
+    observed_world.Step(1.0f);
+    ExpectSameAgents(observed_world, *predicted_world);
+
+    EXPECT_TRUE(observed_world.Rollback());
+    EXPECT_EQ(observed_world.GetNumCheckpoints(), 0u);
+    EXPECT_EQ(observed_world.GetEgoBehaviorModel(), ego_behavior_model);
+    ExpectSameAgents(observed_world, *initial_world);
+  }
+
+  // clones do not take over the checkpoints
+  observed_world.Checkpoint();
+  EXPECT_EQ(observed_world.Clone()->GetNumCheckpoints(), 0u);
+  EXPECT_TRUE(observed_world.Rollback());
+}
+
+TEST(observed_world, nested_checkpoints) {
+  using bark::world::tests::make_test_world;
+
+  // agents of the test world with a short history
+  auto params = std::make_shared<SetterParams>();
+  params->SetInt("MaxHistoryLength", 3);
+  WorldPtr test_world = make_test_world(2, 7.0, 5.0, 1.0);
+  WorldPtr world = test_world->Clone();
+  world->ClearAgents();
+  for (const auto& agent : test_world->GetAgents()) {
+    auto short_history_agent = std::make_shared<Agent>(
+        agent.second->GetCurrentState(), agent.second->GetBehaviorModel(),
+        agent.second->GetDynamicModel(), agent.second->GetExecutionModel(),
+        agent.second->GetShape(), params, agent.second->GetGoalDefinition());
+    short_history_agent->SetRoadCorridor(agent.second->GetRoadCorridor());
+    world->AddAgent(short_history_agent);
+  }
+  world->UpdateAgentRTree();
+  ObservedWorld observed_world(world, world->GetAgents().begin()->first);
+  observed_world.Step(0.2f);
+  const WorldPtr world_at_checkpoint1 = observed_world.Clone();
+
+  // the history is trimmed to its maximum length while stepping
+  observed_world.Checkpoint();
+  observed_world.Step(0.2f);
+  observed_world.Step(0.2f);
+  const WorldPtr world_at_checkpoint2 = observed_world.Clone();
+  observed_world.Checkpoint();
+  observed_world.Step(0.2f);
+  observed_world.Step(0.2f);
+  observed_world.Step(0.2f);
+  const ObservedWorldPtr predicted_world = observed_world.Predict(0.2f);
+
+  EXPECT_TRUE(observed_world.Rollback());
+  ExpectSameAgents(observed_world, *world_at_checkpoint2);
+  EXPECT_TRUE(observed_world.Rollback());
+  ExpectSameAgents(observed_world, *world_at_checkpoint1);
+  EXPECT_FALSE(observed_world.Rollback());
+
+  // a replaced history is restored as well
+  observed_world.Checkpoint();
+  observed_world.Step(0.2f);
+  observed_world.GetEgoAgent()->SetStateInputHistory(
+      predicted_world->GetEgoAgent()->GetStateInputHistory());
+  EXPECT_TRUE(observed_world.Rollback());
+  ExpectSameAgents(observed_world, *world_at_checkpoint1);
+}
+
+TEST(observed_world, checkpoint_agent_map) {
+  using bark::world::tests::make_test_world;
+
+  WorldPtr world = make_test_world(2, 7.0, 5.0, 1.0);
+  const AgentMap agents_at_checkpoint = world->GetAgents();
+  const AgentId removed_agent_id = agents_at_checkpoint.rbegin()->first;
+  const Point2d removed_agent_position =
+      agents_at_checkpoint.rbegin()->second->GetCurrentPosition();
+
+  world->Checkpoint();
+  world->RemoveAgentById(removed_agent_id);
+  world->Step(0.2f);
+  EXPECT_EQ(world->GetAgents().size(), agents_at_checkpoint.size() - 1);
+  EXPECT_EQ(world->GetNearestAgents(removed_agent_position, 3).count(
+                removed_agent_id),
+            0u);
+
+  EXPECT_TRUE(world->Rollback());
+  ASSERT_EQ(world->GetAgents().size(), agents_at_checkpoint.size());
+  for (const auto& agent : agents_at_checkpoint) {
+    EXPECT_EQ(world->GetAgent(agent.first), agent.second);
+  }
+  EXPECT_EQ(world->GetNearestAgents(removed_agent_position, 3).count(
+                removed_agent_id),
+            1u);
+}
+
+TEST(observed_world, predict_batch) {
+  using bark::models::behavior::BehaviorMPContinuousActions;
+  using bark::models::behavior::DiscreteAction;
+  using bark::models::dynamic::Input;
+  using bark::world::BehaviorHypothesisMap;
+  using bark::world::EvaluationMap;
+  using bark::world::evaluation::EvaluatorCollisionAgents;
+  using bark::world::prediction::PredictionSettings;
+  using bark::world::tests::make_test_observed_world;
+
+  auto params = std::make_shared<SetterParams>();
+  params->SetReal("integration_time_delta", 0.01);
+  auto observed_world = make_test_observed_world(3, 7.0, 5.0, 1.0);
+  auto ego_prediction_model =
+      std::make_shared<BehaviorMPContinuousActions>(params);
+  std::vector<Action> ego_actions;
+  for (float acceleration : {-2.0, 0.0, 1.0, 2.0, 3.0}) {
+    Input u(2);
+    u << acceleration, 0;
+    ego_actions.push_back(
+        DiscreteAction(ego_prediction_model->AddMotionPrimitive(u)));
+  }
+  BehaviorModelPtr others_prediction_model(
+      new BehaviorConstantAcceleration(params));
+  observed_world.SetupPrediction(
+      PredictionSettings(ego_prediction_model, others_prediction_model));
+  observed_world.AddEvaluator("collision",
+                              std::make_shared<EvaluatorCollisionAgents>());
+
+  // the same worlds as predicted one by one
+  const auto predicted_worlds = observed_world.PredictBatch(1.0f, ego_actions);
+  const auto evaluations =
+      observed_world.PredictBatchAndEvaluate(1.0f, ego_actions);
+  ASSERT_EQ(predicted_worlds.size(), ego_actions.size());
+  ASSERT_EQ(evaluations.size(), ego_actions.size());
+  for (std::size_t i = 0; i < ego_actions.size(); ++i) {
+    const ObservedWorldPtr predicted_world = observed_world.Predict(
+        1.0f, boost::get<DiscreteAction>(ego_actions[i]));
+    ExpectSameAgents(*predicted_worlds[i], *predicted_world);
+    EXPECT_EQ(predicted_worlds[i]->GetMap(), observed_world.GetMap());
+    EXPECT_EQ(boost::get<bool>(evaluations[i].at("collision")),
+              boost::get<bool>(predicted_world->Evaluate().at("collision")));
+  }
+
+  // behavior hypotheses for the other agents
+  std::vector<BehaviorHypothesisMap> hypotheses;
+  for (float acceleration : {-1.0, 1.0}) {
+    auto hypothesis_params = std::make_shared<SetterParams>();
+    hypothesis_params->SetReal("BehaviorConstantAcceleration::ConstAcceleration",
+                               acceleration);
+    BehaviorHypothesisMap hypothesis;
+    for (const auto& agent : observed_world.GetOtherAgents()) {
+      hypothesis[agent.first] =
+          std::make_shared<BehaviorConstantAcceleration>(hypothesis_params);
+    }
+    hypotheses.push_back(hypothesis);
+  }
+  const auto hypothesis_worlds = observed_world.PredictBatch(1.0f, hypotheses);
+  ASSERT_EQ(hypothesis_worlds.size(), hypotheses.size());
+  for (std::size_t i = 0; i < hypotheses.size(); ++i) {
+    const ObservedWorldPtr predicted_world = observed_world.Predict(
+        1.0f, observed_world.GetEgoBehaviorModel()->Clone(), hypotheses[i]);
+    ExpectSameAgents(*hypothesis_worlds[i], *predicted_world);
+    // the branches use clones of the hypotheses
+    for (const auto& agent : hypotheses[i]) {
+      EXPECT_NE(hypothesis_worlds[i]->GetAgent(agent.first)->GetBehaviorModel(),
+                agent.second);
+    }
+  }
+  EXPECT_FALSE(hypothesis_worlds[0]
+                   ->GetOtherAgents()
+                   .begin()
+                   ->second->GetCurrentState()
+                   .isApprox(hypothesis_worlds[1]
+                                 ->GetOtherAgents()
+                                 .begin()
+                                 ->second->GetCurrentState()));
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <cmath>
+#include <stdexcept>
+#include "gtest/gtest.h"
+
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/geometry/angle.hpp"
+#include "bark/models/dynamic/single_track.hpp"
+#include "bark/models/execution/interpolation/interpolate.hpp"
+#include "bark/world/interaction_dataset/track_store.hpp"
+#include "bark/world/tests/make_test_world.hpp"
+
+using bark::commons::SetterParams;
+using bark::geometry::Norm0To2PI;
+using bark::geometry::Point2d;
+using bark::geometry::Polygon;
+using bark::models::behavior::BehaviorStaticTrajectory;
+using bark::models::dynamic::SingleTrackModel;
+using bark::models::dynamic::State;
+using bark::models::dynamic::StateDefinition;
+using bark::models::dynamic::Trajectory;
+using bark::models::execution::ExecutionModelInterpolate;
+using bark::world::goal_definition::GoalDefinitionPolygon;
+using bark::world::interaction_dataset::Track;
+using bark::world::interaction_dataset::TrackStore;
+using bark::world::objects::AgentPtr;
+
+const char kTrackFile[] =
+    "bark/runtime/tests/data/interaction_dataset_dummy_track.csv";
+
+TEST(track_store, read_tracks) {
+  TrackStore track_store(kTrackFile);
+  ASSERT_EQ(track_store.GetNumTracks(), 2u);
+  EXPECT_EQ(track_store.GetTrackIds(), (std::vector<int>{1, 2}));
+
+  const Track& track = track_store.GetTrack(2);
+  EXPECT_EQ(track.agent_type, "car");
+  EXPECT_NEAR(track.length, 3.98, 1e-6);
+  EXPECT_NEAR(track.width, 1.73, 1e-6);
+  ASSERT_EQ(track.timestamps_ms.size(), 7u);
+  EXPECT_EQ(track.timestamps_ms.front(), 500);
+  EXPECT_EQ(track.timestamps_ms.back(), 1100);
+
+  // 2,26,600,car,969.122,1006.1,-9.837,-0.235,-3.118,3.98,1.73
+  const auto state = track.states->row(1);
+  EXPECT_NEAR(state(StateDefinition::TIME_POSITION), 0.1, 1e-6);
+  EXPECT_NEAR(state(StateDefinition::X_POSITION), 969.122, 1e-3);
+  EXPECT_NEAR(state(StateDefinition::Y_POSITION), 1006.1, 1e-3);
+  EXPECT_NEAR(state(StateDefinition::THETA_POSITION), Norm0To2PI(-3.118),
+              1e-5);
+  EXPECT_NEAR(state(StateDefinition::VEL_POSITION),
+              std::hypot(-9.837, -0.235), 1e-5);
+
+  EXPECT_THROW(track_store.GetTrack(3), std::runtime_error);
+  EXPECT_THROW(TrackStore("does_not_exist.csv"), std::runtime_error);
+}
+
+TEST(track_store, replay_window) {
+  TrackStore track_store(kTrackFile);
+  const Track& track = track_store.GetTrack(1);
+  auto behavior = std::dynamic_pointer_cast<BehaviorStaticTrajectory>(
+      track_store.MakeBehavior(1, 600, 1000, nullptr));
+  ASSERT_TRUE(behavior);
+  // the window references the states of the track
+  EXPECT_EQ(behavior->GetStaticTrajectoryPtr(), track.states);
+
+  const Trajectory window = behavior->GetReplayedTrajectory();
+  ASSERT_EQ(window.rows(), 5);
+  for (int i = 0; i < window.rows(); ++i) {
+    EXPECT_NEAR(window(i, StateDefinition::TIME_POSITION), 0.1 * i, 1e-5);
+    EXPECT_EQ(window(i, StateDefinition::X_POSITION),
+              (*track.states)(i + 1, StateDefinition::X_POSITION));
+  }
+
+  auto observed_world =
+      bark::world::tests::make_test_observed_world(0, 0, 0, 0);
+  observed_world.SetWorldTime(0.15);
+  Trajectory traj = behavior->Plan(0.2, observed_world);
+  ASSERT_EQ(traj.rows(), 4);
+  EXPECT_NEAR(traj(0, StateDefinition::TIME_POSITION), 0.15, 1e-5);
+  EXPECT_NEAR(traj(0, StateDefinition::X_POSITION),
+              0.5 * (995.079 + 994.261), 1e-3);
+  EXPECT_NEAR(traj(3, StateDefinition::TIME_POSITION), 0.35, 1e-5);
+}
+
+TEST(track_store, make_agent) {
+  auto params = std::make_shared<SetterParams>();
+  TrackStore track_store(kTrackFile);
+
+  // the init state is taken at the start of the track if it starts later
+  State init_state = track_store.GetInitState(2, 0);
+  EXPECT_EQ(init_state(StateDefinition::TIME_POSITION), 0.0);
+  EXPECT_NEAR(init_state(StateDefinition::X_POSITION), 970.105, 1e-3);
+  EXPECT_THROW(track_store.GetInitState(2, 650), std::runtime_error);
+
+  AgentPtr agent = track_store.MakeAgent(
+      2, 700, 1100, params, std::make_shared<SingleTrackModel>(params),
+      std::make_shared<ExecutionModelInterpolate>(params), nullptr, 2.7);
+  EXPECT_EQ(agent->GetAgentId(), 2u);
+  EXPECT_NEAR(agent->GetCurrentState()(StateDefinition::X_POSITION), 968.139,
+              1e-3);
+  const Polygon& shape = agent->GetShape();
+  EXPECT_NEAR(shape.front_dist_, 3.98 / 2.0 + 1.35, 1e-5);
+  EXPECT_NEAR(shape.rear_dist_, 3.98 / 2.0 - 1.35, 1e-5);
+  // the goal lies around the last position of the track
+  auto goal_definition = std::dynamic_pointer_cast<GoalDefinitionPolygon>(
+      agent->GetGoalDefinition());
+  ASSERT_TRUE(goal_definition);
+  EXPECT_TRUE(boost::geometry::within(Point2d(964.196, 1009.935),
+                                      goal_definition->GetShape().obj_));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
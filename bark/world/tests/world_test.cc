@@ -62,6 +62,25 @@ TEST(world, world_init) {
   world->AddAgent(agent);
 }
 
+TEST(world, pooled_clones) {
+  using bark::commons::ThreadLocalPool;
+  WorldPtr world = make_test_world(4, 5.0, 5.0, 0.0);
+  const std::size_t num_agents = world->GetAgents().size();
+
+  // the first clone fills the pools when it is discarded, the following
+  // clones draw agents and models from them
+  world->Clone();
+  ThreadLocalPool::ResetStatistics();
+  for (int i = 0; i < 3; ++i) {
+    WorldPtr clone(world->Clone());
+    EXPECT_EQ(clone->GetAgents().size(), num_agents);
+  }
+  const auto statistics = ThreadLocalPool::GetStatistics();
+  // the agent and its behavior, execution and dynamic model
+  EXPECT_EQ(statistics.num_allocations, 3 * 4 * num_agents);
+  EXPECT_EQ(statistics.num_reused, statistics.num_allocations);
+}
+
 TEST(world, world_step) {
   auto params = std::make_shared<SetterParams>();
   ExecutionModelPtr exec_model(new ExecutionModelInterpolate(params));
@@ -8,6 +8,7 @@
 
 #include <csignal>
 #include <string>
+#include <unordered_set>
 
 #include "bark/commons/util/segfault_handler.hpp"
 #include "bark/world/observed_world.hpp"
@@ -44,7 +45,9 @@ World::World(const std::shared_ptr<World>& world)
       world_time_(world->GetWorldTime()),
       remove_agents_(world->GetRemoveAgents()),
       frac_lateral_offset_(world->GetFracLateralOffset()),
-      rtree_agents_(world->rtree_agents_) {
+      rtree_agents_(world->rtree_agents_),
+      lane_occupancy_index_(world->GetLaneOccupancyIndex()),
+      batch_planner_(world->GetAgentBatchPlanner()) {
   //! segfault handler
   std::signal(SIGSEGV, bark::commons::SegfaultHandler);
 }
@@ -59,17 +62,29 @@ void World::Step(const float& delta_time) {
 void World::PlanAgents(const float& delta_time) {
   UpdateAgentRTree();
   WorldPtr current_world(this->Clone());
+  // all observed worlds share the lane occupancies of the current world
+  current_world->EnableLaneOccupancyIndex();
   const float inc_world_time = world_time_ + delta_time;
+  std::unordered_set<AgentId> batch_planned_agents;
+  if (batch_planner_) {
+    for (const AgentId& agent_id :
+         batch_planner_->PlanBehaviors(delta_time, agents_, current_world)) {
+      batch_planned_agents.insert(agent_id);
+    }
+  }
   for (auto agent : agents_) {
-    ObservedWorld observed_world(current_world, agent.first);
-    agent.second->PlanBehavior(delta_time, observed_world);
-    if (agent.second->GetBehaviorStatus() == BehaviorStatus::VALID)
+    if (batch_planned_agents.count(agent.first) == 0) {
+      ObservedWorld observed_world(current_world, agent.first);
+      agent.second->Plan(delta_time, inc_world_time, observed_world);
+    } else if (agent.second->GetBehaviorStatus() == BehaviorStatus::VALID) {
       agent.second->PlanExecution(inc_world_time);
+    }
   }
 }
 
 void World::Execute(const float& world_time) {
   using models::dynamic::StateDefinition::TIME_POSITION;
+  lane_occupancy_index_.reset();
   for (auto agent : agents_) {
     if (agent.second->GetBehaviorStatus() == BehaviorStatus::VALID &&
         agent.second->GetExecutionStatus() == ExecutionStatus::VALID) {
@@ -83,6 +98,47 @@ void World::Execute(const float& world_time) {
   RemoveInvalidAgents();
 }
 
+void World::Checkpoint() {
+  WorldCheckpoint checkpoint;
+  checkpoint.world_time = world_time_;
+  checkpoint.lane_occupancy_index = lane_occupancy_index_;
+  checkpoint.agents_saved = false;
+  checkpoint.rtree_agents_saved = false;
+  checkpoint.checkpointed_agents.reserve(agents_.size());
+  for (auto& agent : agents_) {
+    agent.second->Checkpoint();
+    checkpoint.checkpointed_agents.push_back(agent.second);
+  }
+  checkpoints_.push_back(std::move(checkpoint));
+}
+
+bool World::Rollback() {
+  if (checkpoints_.empty()) {
+    return false;
+  }
+  WorldCheckpoint& checkpoint = checkpoints_.back();
+  for (auto& agent : checkpoint.checkpointed_agents) {
+    agent->Rollback();
+  }
+  if (checkpoint.agents_saved) {
+    agents_.swap(checkpoint.agents);
+  }
+  if (checkpoint.rtree_agents_saved) {
+    rtree_agents_.swap(checkpoint.rtree_agents);
+  }
+  lane_occupancy_index_ = checkpoint.lane_occupancy_index;
+  world_time_ = checkpoint.world_time;
+  checkpoints_.pop_back();
+  return true;
+}
+
+void World::SaveAgentsForRollback() {
+  if (!checkpoints_.empty() && !checkpoints_.back().agents_saved) {
+    checkpoints_.back().agents = agents_;
+    checkpoints_.back().agents_saved = true;
+  }
+}
+
 WorldPtr World::GetWorldAtTime(const float& world_time) const {
   WorldPtr current_world_state(this->Clone());
   for (auto agent : current_world_state->GetAgents()) {
@@ -107,7 +163,9 @@ AgentMap World::GetValidAgents() const {
 }
 
 void World::AddAgent(const objects::AgentPtr& agent) {
+  SaveAgentsForRollback();
   agents_[agent->agent_id_] = agent;
+  lane_occupancy_index_.reset();
 }
 
 void World::AddObject(const objects::ObjectPtr& object) {
@@ -144,6 +202,12 @@ std::vector<ObservedWorld> World::Observe(
 }
 
 void World::UpdateAgentRTree() {
+  lane_occupancy_index_.reset();
+  if (!checkpoints_.empty() && !checkpoints_.back().rtree_agents_saved) {
+    // the r-tree is rebuilt, so the checkpoint can take over the old one
+    rtree_agents_.swap(checkpoints_.back().rtree_agents);
+    checkpoints_.back().rtree_agents_saved = true;
+  }
   rtree_agents_.clear();
   for (auto& agent : agents_) {
     auto obj =
@@ -164,6 +228,9 @@ void World::RemoveInvalidAgents() {
 
     rtree_agents_.query(!boost::geometry::index::within(query_box),
                         std::back_inserter(query_results));
+    if (!query_results.empty()) {
+      SaveAgentsForRollback();
+    }
     for (auto& result_pair : query_results) {
       agents_.erase(result_pair.second);
     }
@@ -171,6 +238,7 @@ void World::RemoveInvalidAgents() {
 
   for (auto& agent : agents_) {
     if (agent.second->GetBehaviorStatus() == BehaviorStatus::EXPIRED) {
+      SaveAgentsForRollback();
       agents_.erase(agent.first);
     }
   }
@@ -216,70 +284,70 @@ AgentMap World::GetAgentsIntersectingPolygon(
 
 FrontRearAgents World::GetAgentFrontRearForId(
     const AgentId& agent_id, const LaneCorridorPtr& lane_corridor) const {
+  LaneOccupancyPtr lane_occupancy = GetLaneOccupancy(lane_corridor);
+  if (lane_occupancy->GetNumIntersectingAgents() == 0) {
+    return lane_occupancy->GetFrontRear(agent_id, FrenetPosition(0, 0));
+  }
+  FrenetPosition frenet_ego =
+      GetAgentFrenetPosition(agent_id, lane_corridor, lane_occupancy);
+  return lane_occupancy->GetFrontRear(agent_id, frenet_ego);
+}
+
+FrenetPosition World::GetAgentFrenetPosition(
+    const AgentId& agent_id, const LaneCorridorPtr& lane_corridor,
+    const LaneOccupancyPtr& lane_occupancy) const {
+  // occupants have already been projected onto the lane corridor
+  const LaneOccupant* occupant = lane_occupancy->GetOccupant(agent_id);
+  if (occupant) return FrenetPosition(occupant->s, occupant->lat);
+  auto project = [this, &agent_id](const LaneCorridorPtr& lane_corridor) {
+    return FrenetPosition(World::GetAgent(agent_id)->GetCurrentPosition(),
+                          lane_corridor->GetCenterLine());
+  };
+  if (!lane_occupancy_index_) return project(lane_corridor);
+  return lane_occupancy_index_->GetFrenetPosition(lane_corridor, agent_id,
+                                                  project);
+}
+
+LaneOccupancyPtr World::GetLaneOccupancy(
+    const LaneCorridorPtr& lane_corridor) const {
+  if (!lane_occupancy_index_) return ComputeLaneOccupancy(lane_corridor);
+  return lane_occupancy_index_->Get(
+      lane_corridor, [this](const LaneCorridorPtr& lane_corridor) {
+        return ComputeLaneOccupancy(lane_corridor);
+      });
+}
+
+LaneOccupancyPtr World::ComputeLaneOccupancy(
+    const LaneCorridorPtr& lane_corridor) const {
   using bark::geometry::Line;
   using bark::geometry::Polygon;
 
-  FrontRearAgents fr_agents;
-  Point2d ego_position = World::GetAgent(agent_id)->GetCurrentPosition();
-
   const Polygon& corridor_polygon = lane_corridor->GetMergedPolygon();
   const Line& center_line = lane_corridor->GetCenterLine();
   AgentMap intersecting_agents = GetAgentsIntersectingPolygon(corridor_polygon);
-  if (intersecting_agents.size() == 0) {
-    fr_agents.front = std::make_pair(AgentPtr(nullptr), FrenetPosition(0, 0));
-    fr_agents.rear = fr_agents.front;
-    return fr_agents;
-  }
 
-  FrenetPosition frenet_ego(ego_position, center_line);
-  const double numeric_max = std::numeric_limits<double>::max();
-
-  double nearest_lon_front = numeric_max, nearest_lat_front = numeric_max,
-         nearest_lon_rear = numeric_max, nearest_lat_rear = numeric_max;
-
-  AgentPtr nearest_agent_front(nullptr);
-  AgentPtr nearest_agent_rear(nullptr);
-
-  for (auto it = intersecting_agents.begin(); it != intersecting_agents.end();
-       ++it) {
-    if (it->second->GetAgentId() == agent_id ||
-        it->second->GetBehaviorStatus() != BehaviorStatus::VALID) {
-      continue;
-    }
-
-    FrenetPosition frenet_other(it->second->GetCurrentPosition(), center_line);
-    float width = lane_corridor->GetLaneWidth(it->second->GetCurrentPosition());
+  std::vector<LaneOccupant> occupants;
+  occupants.reserve(intersecting_agents.size());
+  for (const auto& agent : intersecting_agents) {
+    Point2d position = agent.second->GetCurrentPosition();
+    FrenetPosition frenet_other(position, center_line);
+    float width = lane_corridor->GetLaneWidth(position);
     if (std::abs(frenet_other.lat) > frac_lateral_offset_ * width) {
       // agent seems to be not really in same lane
       continue;
     }
-    double long_dist = frenet_other.lon - frenet_ego.lon;
-    double lat_dist = frenet_other.lat - frenet_ego.lat;
-
-    if (long_dist > 0.0f && long_dist < nearest_lon_front) {
-      nearest_lon_front = long_dist;
-      nearest_lat_front = lat_dist;
-      nearest_agent_front = it->second;
-    } else if (long_dist < 0.0f &&
-               std::abs(long_dist) < std::abs(nearest_lon_rear)) {
-      nearest_lon_rear = long_dist;
-      nearest_lat_rear = lat_dist;
-      nearest_agent_rear = it->second;
-    }
+    occupants.push_back(LaneOccupant{frenet_other.lon, frenet_other.lat,
+                                     agent.first, agent.second});
   }
-
-  FrenetPosition frenet_front =
-      FrenetPosition(nearest_lon_front, nearest_lat_front);
-  fr_agents.front = std::make_pair(nearest_agent_front, frenet_front);
-  FrenetPosition frenet_rear =
-      FrenetPosition(nearest_lon_rear, nearest_lat_rear);
-  fr_agents.rear = std::make_pair(nearest_agent_rear, frenet_rear);
-
-  return fr_agents;
+  return std::make_shared<const LaneOccupancy>(
+      std::move(occupants), intersecting_agents.size(),
+      lane_corridor->GetLength());
 }
 
 void World::RemoveAgentById(AgentId agent_id) {
+  SaveAgentsForRollback();
   size_t erased_elems = agents_.erase(agent_id);
+  lane_occupancy_index_.reset();
   LOG_IF(ERROR, erased_elems == 0)
       << "Could not remove non-existent agent with Id " << agent_id << " !";
 }
@@ -18,6 +18,7 @@
 #include <boost/geometry/index/rtree.hpp>
 #include "bark/commons/transformation/frenet.hpp"
 #include "bark/world/evaluation/base_evaluator.hpp"
+#include "bark/world/lane_occupancy.hpp"
 #include "bark/world/map/roadgraph.hpp"
 #include "bark/world/objects/agent.hpp"
 #include "bark/world/objects/object.hpp"
@@ -51,12 +52,25 @@ using AgentRTree =
     boost::geometry::index::rtree<rtree_agent_value,
                                   boost::geometry::index::linear<16, 4> >;
 
-typedef std::pair<AgentPtr, FrenetPosition> AgentFrenetPair;
+class World;
 
-struct FrontRearAgents {
-  AgentFrenetPair front;
-  AgentFrenetPair rear;
+//! Plans several agents of a world step jointly, e.g. all agents using
+//! the same behavior model. All agents that are not planned by it are
+//! planned individually.
+class AgentBatchPlanner {
+ public:
+  virtual ~AgentBatchPlanner() {}
+
+  //! plans the behavior of the supported agents in the observed
+  //! current_world and returns their ids
+  virtual std::vector<AgentId> PlanBehaviors(
+      float delta_time, const AgentMap& agents,
+      const std::shared_ptr<World>& current_world) = 0;
+
+  //! worlds that are stepped concurrently use their own planner
+  virtual std::shared_ptr<AgentBatchPlanner> Clone() const = 0;
 };
+typedef std::shared_ptr<AgentBatchPlanner> AgentBatchPlannerPtr;
 
 class World : public commons::BaseType {
  public:
@@ -81,6 +95,22 @@ class World : public commons::BaseType {
    */
   void Execute(const float& world_time);
 
+  /**
+   * @brief  Saves the world time and the agents; the agents save their
+   *         models and history, so the following steps can be undone
+   *         without cloning the world
+   */
+  void Checkpoint();
+
+  /**
+   * @brief  Restores the world at its last checkpoint; checkpoints are
+   *         restored in the reverse order they were made in
+   * @return false if the world has no checkpoint
+   */
+  bool Rollback();
+
+  std::size_t GetNumCheckpoints() const { return checkpoints_.size(); }
+
   /**
    * @brief Get world for a specific time
    * @param  execution_time: world_time
@@ -143,9 +173,41 @@ class World : public commons::BaseType {
   FrontRearAgents GetAgentFrontRearForId(
       const AgentId& agent_id, const LaneCorridorPtr& lane_corridor) const;
 
+  /**
+   * @brief  Frenet position of the agent on the lane corridor; taken from
+   *         the lane occupancy or projected once per step if the lane
+   *         occupancy index is enabled
+   */
+  FrenetPosition GetAgentFrenetPosition(
+      const AgentId& agent_id, const LaneCorridorPtr& lane_corridor,
+      const LaneOccupancyPtr& lane_occupancy) const;
+
+  /**
+   * @brief  Agents on the lane corridor sorted by their longitudinal
+   *         position; cached if the lane occupancy index is enabled
+   */
+  LaneOccupancyPtr GetLaneOccupancy(const LaneCorridorPtr& lane_corridor) const;
+
+  /**
+   * @brief  Enables the lane occupancy index for the current agent states;
+   *         any change of the agents disables it again
+   */
+  void EnableLaneOccupancyIndex() {
+    lane_occupancy_index_ = std::make_shared<LaneOccupancyIndex>();
+  }
+  LaneOccupancyIndexPtr GetLaneOccupancyIndex() const {
+    return lane_occupancy_index_;
+  }
+
   //! Setter
   void SetMap(const world::map::MapInterfacePtr& map) { map_ = map; }
 
+  //! the batch planner is used by PlanAgents; nullptr disables it
+  void SetAgentBatchPlanner(const AgentBatchPlannerPtr& batch_planner) {
+    batch_planner_ = batch_planner;
+  }
+  AgentBatchPlannerPtr GetAgentBatchPlanner() const { return batch_planner_; }
+
   std::pair<bark::geometry::Point2d, bark::geometry::Point2d> BoundingBox()
       const {
     return map_->BoundingBox();
@@ -161,7 +223,11 @@ class World : public commons::BaseType {
 
   //! Functions
   void ClearEvaluators() { evaluators_.clear(); }
-  void ClearAgents() { agents_.clear(); }
+  void ClearAgents() {
+    SaveAgentsForRollback();
+    agents_.clear();
+    lane_occupancy_index_.reset();
+  }
   void ClearObjects() { objects_.clear(); }
   void ClearAll() {
     ClearAgents();
@@ -171,7 +237,25 @@ class World : public commons::BaseType {
 
   virtual std::shared_ptr<World> Clone() const;
 
+  /**
+   * @brief  Clones the agents only; the map, the objects and the evaluators
+   *         are not changed by stepping and are shared with this world
+   */
+  std::shared_ptr<World> CloneAgents() const;
+
  private:
+  //! agents added after the checkpoint are removed by the rollback; the
+  //! agent map and the r-tree are only saved when they are first changed
+  struct WorldCheckpoint {
+    double world_time;
+    AgentMap agents;
+    AgentRTree rtree_agents;
+    LaneOccupancyIndexPtr lane_occupancy_index;
+    std::vector<AgentPtr> checkpointed_agents;
+    bool agents_saved;
+    bool rtree_agents_saved;
+  };
+
   MapInterfacePtr map_;
   AgentMap agents_;
   ObjectMap objects_;
@@ -180,23 +264,36 @@ class World : public commons::BaseType {
   AgentRTree rtree_agents_;
   bool remove_agents_;
   double frac_lateral_offset_;
+  LaneOccupancyIndexPtr lane_occupancy_index_;
+  AgentBatchPlannerPtr batch_planner_;
+  std::vector<WorldCheckpoint> checkpoints_;
+
+  LaneOccupancyPtr ComputeLaneOccupancy(
+      const LaneCorridorPtr& lane_corridor) const;
+
+  //! saves the agent map in the last checkpoint before it is changed
+  void SaveAgentsForRollback();
 };
 
 typedef std::shared_ptr<world::World> WorldPtr;
 
 inline WorldPtr World::Clone() const {
+  WorldPtr new_world = CloneAgents();
+  new_world->ClearObjects();
+  for (auto object = objects_.begin(); object != objects_.end(); ++object) {
+    new_world->AddObject(object->second->Clone());
+  }
+  return new_world;
+}
+
+inline WorldPtr World::CloneAgents() const {
   WorldPtr new_world = std::make_shared<World>(*this);
-  new_world->ClearAll();
+  new_world->checkpoints_.clear();
+  new_world->ClearAgents();
   for (auto agent = agents_.begin(); agent != agents_.end(); ++agent) {
     new_world->AddAgent(
         std::dynamic_pointer_cast<Agent>(agent->second->Clone()));
   }
-  for (auto object = objects_.begin(); object != objects_.end(); ++object) {
-    new_world->AddObject(object->second->Clone());
-  }
-  for (const auto& evaluator : evaluators_) {
-    new_world->AddEvaluator(evaluator.first, evaluator.second);
-  }
   return new_world;
 }
 
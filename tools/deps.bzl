@@ -51,6 +51,16 @@ def bark_dependencies():
     urls = ["https://github.com/eigenteam/eigen-git-mirror/archive/98e54de5e25aefc6b984c168fb3009868a93e217.zip"],
     )
 
+    # the ceres bazel rules expect eigen and glog under the names above
+    _maybe(
+    http_archive,
+    name = "com_google_ceres_solver",
+    build_file = "@bark_project//tools/ceres:ceres.BUILD",
+    sha256 = "4744005fc3b902fed886ea418df70690caa8e2ff6b5a90f3dd88a3d291ef8e8e",
+    strip_prefix = "ceres-solver-1.14.0",
+    urls = ["http://ceres-solver.org/ceres-solver-1.14.0.tar.gz"],
+    )
+
     _maybe(
       git_repository,
       name = "com_github_gflags_gflags",